@@ -25,6 +25,14 @@ int main(void)
         LOG_ERR("Server init failed");
         return 1;
     }
+#ifdef CONFIG_KENNING_SERVER_PIPELINE
+    // requests are handled by the inference server threads
+    if (STATUS_OK != start_server_pipeline())
+    {
+        LOG_ERR("Server pipeline start failed");
+        return 1;
+    }
+#else  // CONFIG_KENNING_SERVER_PIPELINE
     // main runtime loop
     while (1)
     {
@@ -37,5 +45,6 @@ int main(void)
             }
         }
     }
+#endif // CONFIG_KENNING_SERVER_PIPELINE
     return 0;
 }
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cache of the last uploaded model and runtime, stored in the kenning_cache_partition flash partition and identified
+ * by the content hash provided by the client. The hash is verified against the digest of the artifact computed on the
+ * device before it is stored.
+ */
+
+#ifndef KENNING_INFERENCE_LIB_CORE_ARTIFACT_CACHE_H_
+#define KENNING_INFERENCE_LIB_CORE_ARTIFACT_CACHE_H_
+
+#include "kenning_inference_lib/core/kenning_protocol.h"
+#include "kenning_inference_lib/core/loaders.h"
+#include "kenning_inference_lib/core/utils.h"
+
+/**
+ * Artifact cache custom error codes
+ */
+#define ARTIFACT_CACHE_STATUSES(STATUS)       \
+    STATUS(ARTIFACT_CACHE_STATUS_MISS)        \
+    STATUS(ARTIFACT_CACHE_STATUS_FLASH_ERROR) \
+    STATUS(ARTIFACT_CACHE_STATUS_TOO_BIG)     \
+    STATUS(ARTIFACT_CACHE_STATUS_HASH_MISMATCH)
+
+GENERATE_MODULE_STATUSES(ARTIFACT_CACHE);
+
+// Size in bytes of the content hash identifying cached artifacts (SHA-256 computed by the client)
+#define ARTIFACT_CACHE_HASH_SIZE CACHE_QUERY_HASH_SIZE
+
+#define ARTIFACT_CACHE_SLOTS(SLOT)    \
+    SLOT(ARTIFACT_CACHE_SLOT_MODEL)   \
+    SLOT(ARTIFACT_CACHE_SLOT_RUNTIME) \
+    SLOT(NUM_ARTIFACT_CACHE_SLOTS)
+
+typedef enum
+{
+    ARTIFACT_CACHE_SLOTS(GENERATE_ENUM)
+} ARTIFACT_CACHE_SLOT;
+
+/**
+ * Looks for an artifact with given hash in the cache slot
+ *
+ * @param slot cache slot
+ * @param hash content hash of the artifact (ARTIFACT_CACHE_HASH_SIZE bytes)
+ * @param size size of the cached artifact
+ *
+ * @returns STATUS_OK if the artifact is cached, ARTIFACT_CACHE_STATUS_MISS if it is not
+ */
+status_t artifact_cache_find(ARTIFACT_CACHE_SLOT slot, const uint8_t *hash, size_t *size);
+
+/**
+ * Saves artifact cached in the slot to the loader. The loader is not reset.
+ *
+ * @param slot cache slot
+ * @param ldr loader for the artifact
+ *
+ * @returns error status of the cache or the loader
+ */
+status_t artifact_cache_read(ARTIFACT_CACHE_SLOT slot, struct msg_loader *ldr);
+
+/**
+ * Replaces artifact cached in the slot. The artifact is stored only if its SHA-256 digest matches the hash. The hash is
+ * written after the data, so the slot is valid only if the whole artifact was written.
+ *
+ * @param slot cache slot
+ * @param hash content hash of the artifact (ARTIFACT_CACHE_HASH_SIZE bytes)
+ * @param data artifact data
+ * @param size size of the artifact
+ *
+ * @returns error status of the cache, ARTIFACT_CACHE_STATUS_HASH_MISMATCH if the data does not match the hash
+ */
+status_t artifact_cache_store(ARTIFACT_CACHE_SLOT slot, const uint8_t *hash, const uint8_t *data, size_t size);
+
+/**
+ * Removes artifact cached in the slot
+ *
+ * @param slot cache slot
+ *
+ * @returns error status of the cache
+ */
+status_t artifact_cache_invalidate(ARTIFACT_CACHE_SLOT slot);
+
+#endif // KENNING_INFERENCE_LIB_CORE_ARTIFACT_CACHE_H_
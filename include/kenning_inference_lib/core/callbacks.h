@@ -61,13 +61,21 @@ typedef status_t (*callback_ptr_t)(protocol_event_t *, protocol_payload_t *);
 #define runtime_callback unsupported_callback
 #endif // !defined(CONFIG_LLEXT) && !defined(CONFIG_ZTEST)
 
+#if !defined(CONFIG_KENNING_BATCH_INFERENCE) && !defined(CONFIG_ZTEST)
+#define infer_batch_callback unsupported_callback
+#endif // !defined(CONFIG_KENNING_BATCH_INFERENCE) && !defined(CONFIG_ZTEST)
+
+#if !defined(CONFIG_KENNING_ARTIFACT_CACHE) && !defined(CONFIG_ZTEST)
+#define cache_query_callback unsupported_callback
+#endif // !defined(CONFIG_KENNING_ARTIFACT_CACHE) && !defined(CONFIG_ZTEST)
+
 /**
  * List of callbacks for each message type
  */
 #define CALLBACKS_TABLE(ENTRY)                                  \
     /*    MessageType      Callback_function    Task  */        \
     ENTRY(MESSAGE_TYPE_PING, ping_callback)                     \
-    ENTRY(MESSAGE_TYPE_STATUS, unsupported_callback)            \
+    ENTRY(MESSAGE_TYPE_STATUS, status_callback)                 \
     ENTRY(MESSAGE_TYPE_DATA, data_callback)                     \
     ENTRY(MESSAGE_TYPE_MODEL, model_callback)                   \
     ENTRY(MESSAGE_TYPE_PROCESS, process_callback)               \
@@ -79,10 +87,24 @@ typedef status_t (*callback_ptr_t)(protocol_event_t *, protocol_payload_t *);
     ENTRY(MESSAGE_TYPE_OPTIMIZE_MODEL, unsupported_callback)    \
     ENTRY(MESSAGE_TYPE_RUNTIME, runtime_callback)               \
     ENTRY(MESSAGE_TYPE_UNOPTIMIZED_MODEL, unsupported_callback) \
-    ENTRY(MESSAGE_TYPE_LOGS, unsupported_callback)
+    ENTRY(MESSAGE_TYPE_LOGS, unsupported_callback)              \
+    ENTRY(MESSAGE_TYPE_INFER, infer_callback)                   \
+    ENTRY(MESSAGE_TYPE_INFER_BATCH, infer_batch_callback)       \
+    ENTRY(MESSAGE_TYPE_STREAM, stream_callback)                 \
+    ENTRY(MESSAGE_TYPE_CANCEL, cancel_callback)                 \
+    ENTRY(MESSAGE_TYPE_CACHE_QUERY, cache_query_callback)       \
+    ENTRY(MESSAGE_TYPE_UPLOAD_OFFSET, upload_offset_callback)
 
 #define ENTRY(msg_type, callback_func) status_t callback_func(protocol_event_t *, protocol_payload_t *);
 CALLBACKS_TABLE(ENTRY)
 #undef ENTRY
 
+/**
+ * Checks if a stream session is open. In the session, model inputs sent in DATA transmissions are processed right away
+ * and their outputs are sent in OUTPUT transmissions without a request.
+ *
+ * @returns true if the stream session is open
+ */
+bool stream_session_active();
+
 #endif // KENNING_INFERENCE_LIB_CORE_CALLBACKS_H_
@@ -13,7 +13,7 @@
 
 #define PREPARE_MSG_LDR_MAP                                     \
     {                                                           \
-        LOADER_TYPE_NONE,    /*MESSAGE_TYPE_PING*/              \
+        LOADER_TYPE_CONTROL, /*MESSAGE_TYPE_PING*/              \
         LOADER_TYPE_NONE,    /*MESSAGE_TYPE_STATUS*/            \
         LOADER_TYPE_DATA,    /*MESSAGE_TYPE_DATA*/              \
         LOADER_TYPE_MODEL,   /*MESSAGE_TYPE_MODEL*/             \
@@ -27,12 +27,21 @@
         LOADER_TYPE_RUNTIME, /*MESSAGE_TYPE_RUNTIME*/           \
         LOADER_TYPE_NONE,    /*MESSAGE_TYPE_UNOPTIMIZED_MODEL*/ \
         LOADER_TYPE_NONE,    /*MESSAGE_TYPE_LOGS*/              \
+        LOADER_TYPE_DATA,    /*MESSAGE_TYPE_INFER*/             \
+        LOADER_TYPE_BATCH,   /*MESSAGE_TYPE_INFER_BATCH*/       \
+        LOADER_TYPE_NONE,    /*MESSAGE_TYPE_STREAM*/            \
+        LOADER_TYPE_NONE,    /*MESSAGE_TYPE_CANCEL*/            \
+        LOADER_TYPE_CONTROL, /*MESSAGE_TYPE_CACHE_QUERY*/       \
+        LOADER_TYPE_NONE,    /*MESSAGE_TYPE_UPLOAD_OFFSET*/     \
     }
 
 extern LOADER_TYPE g_msg_ldr_map[];
 
 #define MSGT_TO_LDRT(msg) g_msg_ldr_map[(msg)]
 
+// Size in bytes of the buffer for payloads of control messages (i.e. PING)
+#define CONTROL_PAYLOAD_SIZE 16
+
 /**
  * Runtime custom error codes
  */
@@ -76,4 +85,22 @@ status_t wait_for_protocol_event(protocol_event_t *event);
  */
 status_t handle_protocol_event(protocol_event_t *event);
 
+#ifdef CONFIG_KENNING_SERVER_PIPELINE
+/**
+ * Starts receive, compute and transmit threads of the inference server, which handle incoming events instead of
+ * wait_for_protocol_event and handle_protocol_event called in a loop
+ *
+ * @returns status of the server
+ */
+status_t start_server_pipeline();
+#endif // CONFIG_KENNING_SERVER_PIPELINE
+
+/**
+ * Schedules change of the link baudrate. The change is applied after the response to the currently handled request
+ * is sent. If the next event cannot be received with the new baudrate, the default baudrate is restored.
+ *
+ * @param baudrate new baudrate, 0 restores the default baudrate
+ */
+void request_baudrate_change(uint32_t baudrate);
+
 #endif // KENNING_INFERENCE_LIB_CORE_INFERENCE_SERVER_H_
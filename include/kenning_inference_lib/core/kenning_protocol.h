@@ -44,6 +44,12 @@
     TYPE(MESSAGE_TYPE_RUNTIME)           \
     TYPE(MESSAGE_TYPE_UNOPTIMIZED_MODEL) \
     TYPE(MESSAGE_TYPE_LOGS)              \
+    TYPE(MESSAGE_TYPE_INFER)             \
+    TYPE(MESSAGE_TYPE_INFER_BATCH)       \
+    TYPE(MESSAGE_TYPE_STREAM)            \
+    TYPE(MESSAGE_TYPE_CANCEL)            \
+    TYPE(MESSAGE_TYPE_CACHE_QUERY)       \
+    TYPE(MESSAGE_TYPE_UPLOAD_OFFSET)     \
     TYPE(NUM_MESSAGE_TYPES)
 
 #define FLOW_CONTROL_VALUES(TYPE)         \
@@ -72,7 +78,10 @@ typedef enum
     STATUS(KENNING_PROTOCOL_STATUS_EVENT_DENIED)         \
     STATUS(KENNING_PROTOCOL_STATUS_MSG_TOO_BIG)          \
     STATUS(KENNING_PROTOCOL_STATUS_FLOW_CONTROL_ERROR)   \
-    STATUS(KENNING_PROTOCOL_STATUS_BUSY)
+    STATUS(KENNING_PROTOCOL_STATUS_BUSY)                 \
+    STATUS(KENNING_PROTOCOL_STATUS_FRAMING_ERROR)        \
+    STATUS(KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR)       \
+    STATUS(KENNING_PROTOCOL_STATUS_UNEXPECTED_PAYLOAD)
 
 GENERATE_MODULE_STATUSES(KENNING_PROTOCOL);
 
@@ -112,6 +121,26 @@ typedef union
         uint16_t serialized : 1;
         uint16_t reserved : 3; // Reserved for future use.
     } flags_iospec;
+    /**
+     * Struct with flags specific to message types INFER, INFER_BATCH and STREAM
+     */
+    struct __attribute__((packed))
+    {
+        uint16_t _ : 12; // Space for general purpose flags
+        uint16_t stats : 1;
+        uint16_t reserved : 3; // Reserved for future use.
+    } flags_infer;
+    /**
+     * Struct with flags specific to message types MODEL and RUNTIME
+     */
+    struct __attribute__((packed))
+    {
+        uint16_t _ : 12; // Space for general purpose flags
+        uint16_t compressed : 1;
+        uint16_t resume : 1;
+        uint16_t patch : 1;    // MODEL payload is a patch applied to the loaded model (patch_record_header records)
+        uint16_t reserved : 1; // Reserved for future use.
+    } flags_upload;
     uint16_t raw_bytes;
 } flags_t;
 
@@ -127,8 +156,102 @@ typedef struct __attribute__((packed))
     payload_size_t payload_size;
 } message_hdr_t;
 
+// Size in bytes of the runtime name field in the device status
+#define DEVICE_STATUS_RUNTIME_NAME_SIZE 16
+
+/**
+ * A packed struct representing capabilities of the device, sent in the response to STATUS request. It allows the
+ * client to adjust sizes of transmitted messages and to check if a model or runtime fits before sending it.
+ */
+typedef struct __attribute__((packed))
+{
+    // ASCII string - name of the ML runtime the server was built with
+    uint8_t runtime_name[DEVICE_STATUS_RUNTIME_NAME_SIZE];
+    // Current state of the model (MODEL_STATE)
+    uint8_t model_state;
+    // Number of entries in loader_max_size
+    uint8_t num_loader_types;
+    // Maximum size of the payload accepted by the loader of each LOADER_TYPE, 0 if there is no such loader
+    uint32_t loader_max_size[NUM_LOADER_TYPES];
+    // Size of the buffer for response payloads (CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE)
+    uint32_t response_payload_size;
+    // Maximum size of payload of a single sent message (CONFIG_KENNING_PROTOCOL_MAX_OUTGOING_MESSAGE_SIZE)
+    uint32_t max_outgoing_message_size;
+    // Size of the buffer for received payload chunks (CONFIG_KENNING_MESSAGE_RECV_BUFFER_SIZE)
+    uint32_t recv_buffer_size;
+    // Bit mask of message types handled by the server, bit n is set if message type n is supported
+    uint64_t supported_message_types;
+} device_status_t;
+
+// Size in bytes of the content hash in the CACHE_QUERY request
+#define CACHE_QUERY_HASH_SIZE 32
+
+/**
+ * A packed struct representing payload of the CACHE_QUERY request, sent by the client before uploading a model or
+ * a runtime to check if it is cached on the device.
+ */
+typedef struct __attribute__((packed))
+{
+    // Type of the message used to upload the artifact (MESSAGE_TYPE_MODEL or MESSAGE_TYPE_RUNTIME)
+    uint8_t message_type;
+    // SHA-256 hash of the artifact, as sent in the upload (decompressed)
+    uint8_t hash[CACHE_QUERY_HASH_SIZE];
+} cache_query_t;
+
+/**
+ * A packed struct representing payload of the response to CACHE_QUERY request
+ */
+typedef struct __attribute__((packed))
+{
+    // 1 if the artifact was restored from the cache and loaded, 0 if it has to be uploaded
+    uint8_t hit;
+} cache_query_resp_t;
+
+/**
+ * A packed struct representing payload of the response to UPLOAD_OFFSET request. It describes MODEL or RUNTIME
+ * transmission interrupted by a receive error, which can be resumed by sending the rest of its payload, starting from
+ * the offset, with the resume flag set.
+ */
+typedef struct __attribute__((packed))
+{
+    // 1 if there is an interrupted transmission, 0 if the upload has to be started from the beginning
+    uint8_t interrupted;
+    // Type of the interrupted transmission
+    uint8_t message_type;
+    // 1 if the payload of the interrupted transmission is compressed
+    uint8_t compressed;
+    // 1 if the interrupted transmission is a model patch
+    uint8_t patch;
+    // Size of the payload received before the interruption
+    uint32_t offset;
+} upload_offset_resp_t;
+
+/**
+ * An enum that describes how data of the transmitted payload is provided
+ */
+#define PROTOCOL_PAYLOAD_TYPES(TYPE)  \
+    TYPE(PROTOCOL_PAYLOAD_TYPE_BYTES) \
+    TYPE(PROTOCOL_PAYLOAD_TYPE_SEGMENTS)
+
+typedef enum
+{
+    PROTOCOL_PAYLOAD_TYPES(GENERATE_ENUM)
+} PROTOCOL_PAYLOAD_TYPE;
+
+/**
+ * A struct describing a contiguous part of the payload
+ */
+typedef struct
+{
+    const uint8_t *data;
+    payload_size_t size;
+} protocol_segment_t;
+
 /**
  * A struct describing a stream of bytes (either a pointer and size, or a loader)
+ *
+ * When the payload is transmitted, its data can also be given as a list of segments, depending on the type of the
+ * payload.
  */
 typedef struct
 {
@@ -136,8 +259,14 @@ typedef struct
     {
         uint8_t *raw_bytes;
         struct msg_loader *loader;
+        struct
+        {
+            const protocol_segment_t *segments;
+            size_t segment_count;
+        };
     };
     payload_size_t size;
+    PROTOCOL_PAYLOAD_TYPE type;
 } protocol_payload_t;
 
 /**
@@ -146,7 +275,7 @@ typedef struct
 typedef struct
 {
     message_hdr_t hdr;
-    uint8_t *payload;
+    const uint8_t *payload;
 } outgoing_message_t;
 
 /**
@@ -173,10 +302,24 @@ status_t protocol_transmit(const protocol_event_t *msg);
  * Waits for a transmission or a request.
  *
  * @param event received transmission/request
- * @param Pointer to a function, matching a message type to a loader. Should return NULL if there is no loader.
+ * @param Pointer to a function, matching a message type and payload size of the first message to a loader. Should
+ * return NULL if there is no loader or the payload is not accepted.
  *
  * @returns status of the protocol
  */
-status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_callback)(message_type_t));
+status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_callback)(message_type_t, payload_size_t));
+
+/**
+ * Retrieves MODEL or RUNTIME transmission interrupted by a receive error. Its loader keeps the received data, so the
+ * transmission can be resumed by sending the rest of the payload with the resume flag set.
+ *
+ * @param message_type type of the interrupted transmission
+ * @param compressed whether the payload of the interrupted transmission is compressed
+ * @param patch whether the interrupted transmission is a model patch
+ * @param offset size of the payload received before the interruption
+ *
+ * @returns true if there is an interrupted transmission
+ */
+bool protocol_get_interrupted_upload(message_type_t *message_type, bool *compressed, bool *patch, size_t *offset);
 
 #endif // KENNING_INFERENCE_LIB_CORE_KENNING_PROTOCOL_H_
@@ -22,6 +22,9 @@ struct msg_loader
     int (*save)(struct msg_loader *, const uint8_t *, size_t);
     int (*save_one)(struct msg_loader *, void *);
     int (*reset)(struct msg_loader *);
+    int (*rewind)(struct msg_loader *, size_t);
+    int (*lease_window)(struct msg_loader *, uint8_t **, size_t *);
+    int (*commit_window)(struct msg_loader *, size_t);
     size_t written;
     size_t max_size;
     void *addr;
@@ -34,10 +37,19 @@ int buf_save_one(struct msg_loader *ldr, void *c);
 
 int buf_reset(struct msg_loader *ldr);
 
+int buf_rewind(struct msg_loader *ldr, size_t written);
+
+int buf_lease_window(struct msg_loader *ldr, uint8_t **dst, size_t *size);
+
+int buf_commit_window(struct msg_loader *ldr, size_t n);
+
 #define MSG_LOADER_BUF(_addr, _max_size) \
     {.save = buf_save,                   \
      .save_one = buf_save_one,           \
      .reset = buf_reset,                 \
+     .rewind = buf_rewind,               \
+     .lease_window = buf_lease_window,   \
+     .commit_window = buf_commit_window, \
      .written = 0,                       \
      .max_size = (_max_size),            \
      .addr = (_addr)}
@@ -46,16 +58,58 @@ int buf_reset(struct msg_loader *ldr);
     {.save = buf_save,                                 \
      .save_one = buf_save_one,                         \
      .reset = (_reset),                                \
+     .rewind = buf_rewind,                             \
+     .lease_window = buf_lease_window,                 \
+     .commit_window = buf_commit_window,               \
      .written = 0,                                     \
      .max_size = (_max_size),                          \
      .addr = (_addr)}
 
+/**
+ * Header of the record in the payload saved to the patching loader, it is followed by size bytes of data
+ */
+struct __attribute__((packed)) patch_record_header
+{
+    uint32_t offset;
+    uint32_t size;
+};
+
+/**
+ * Returns loader applying patch saved to it in place to the data already stored in the given buffer loader. Patch is
+ * a sequence of records, each consisting of patch_record_header and data replacing data at the offset. Records have
+ * to fit in the data stored in the loader, which is not reset. The returned loader is shared, so only one patch can be
+ * applied at a time.
+ *
+ * @param ldr buffer loader with data to patch
+ *
+ * @returns patching loader, its written field is the size of the patch
+ */
+struct msg_loader *patching_loader(struct msg_loader *ldr);
+
+#ifdef CONFIG_KENNING_COMPRESSED_UPLOAD
+
+/**
+ * Returns loader decompressing payload saved to it and passing decompressed data to the given loader, so that
+ * compressed payload is never stored in full. Payload is compressed with heatshrink (LZSS) using window of
+ * 2^CONFIG_KENNING_DECOMPRESSION_WINDOW_BITS bytes and lookahead of 2^CONFIG_KENNING_DECOMPRESSION_LOOKAHEAD_BITS
+ * bytes. The returned loader is shared, so only one payload can be decompressed at a time.
+ *
+ * @param ldr loader for decompressed data
+ *
+ * @returns decompressing loader, its written field is the size of compressed data
+ */
+struct msg_loader *decompressing_loader(struct msg_loader *ldr);
+
+#endif // CONFIG_KENNING_COMPRESSED_UPLOAD
+
 #define LOADER_TYPES(TYPE)    \
     TYPE(LOADER_TYPE_NONE)    \
     TYPE(LOADER_TYPE_DATA)    \
     TYPE(LOADER_TYPE_MODEL)   \
     TYPE(LOADER_TYPE_IOSPEC)  \
     TYPE(LOADER_TYPE_RUNTIME) \
+    TYPE(LOADER_TYPE_CONTROL) \
+    TYPE(LOADER_TYPE_BATCH)   \
     TYPE(NUM_LOADER_TYPES)
 
 typedef enum
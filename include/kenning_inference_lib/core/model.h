@@ -108,6 +108,13 @@ status_t model_run_bench();
  */
 status_t model_run();
 
+/**
+ * Requests cancellation of the inference in progress, model_run or model_run_bench returns
+ * RUNTIME_WRAPPER_STATUS_CANCELLED if the runtime reaches a preemption point before the inference ends. Has no effect
+ * if no inference is in progress.
+ */
+void model_request_cancel();
+
 /**
  * Calculates model output size based on data from model struct
  *
@@ -128,6 +135,17 @@ status_t model_get_output_size(size_t *model_output_size);
  */
 status_t model_get_output(const size_t buffer_size, uint8_t *model_output, size_t *model_output_size);
 
+/**
+ * Retrieves views of model output stored in the runtime memory, without copying it
+ *
+ * @param max_views maximum number of views
+ * @param views array for the views of consecutive parts of the model output
+ * @param num_views number of returned views
+ *
+ * @returns status of the model, RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED if the runtime cannot expose its output
+ */
+status_t model_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views);
+
 /**
  * Retrieves model statistics
  *
@@ -19,17 +19,88 @@
     STATUS(PROTOCOL_STATUS_RECV_ERROR)        \
     STATUS(PROTOCOL_STATUS_RECV_ERROR_NOSYS)  \
     STATUS(PROTOCOL_STATUS_RECV_ERROR_BUSY)   \
-    STATUS(PROTOCOL_STATUS_NO_DATA)
+    STATUS(PROTOCOL_STATUS_NO_DATA)           \
+    STATUS(PROTOCOL_STATUS_NOT_SUPPORTED)
 
 GENERATE_MODULE_STATUSES(PROTOCOL);
 
 /**
- * Initialize protocol
+ * Transports that can be compiled into the image, ordered by priority. protocol_init binds to the first transport
+ * that is initialized successfully, whether or not the client uses it
+ */
+#define PROTOCOL_TRANSPORTS(TRANSPORT)                                                  \
+    TRANSPORT(CONFIG_KENNING_TRANSPORT_IPC, g_ipc_transport)                            \
+    TRANSPORT(CONFIG_KENNING_TRANSPORT_TCP, g_tcp_transport)                            \
+    TRANSPORT(CONFIG_KENNING_TRANSPORT_USB_CDC_ACM, g_usb_cdc_acm_transport)            \
+    TRANSPORT(CONFIG_KENNING_COMMUNICATION_PROTOCOL_UART_ASYNC, g_uart_async_transport) \
+    TRANSPORT(CONFIG_KENNING_COMMUNICATION_PROTOCOL_UART, g_uart_transport)
+
+/**
+ * Transport implementing the link with Kenning. Optional operations can be set to NULL
+ */
+struct protocol_transport
+{
+    /**
+     * Name of the transport, used in protocol_select_transport
+     */
+    const char *name;
+    /**
+     * Initializes the transport, called again when the transport is already initialized
+     */
+    status_t (*init)();
+    /**
+     * Writes buffer of bytes
+     */
+    status_t (*write)(const uint8_t *data, size_t data_length);
+    /**
+     * Reads bytes into given buffer, NULL buffer means the data is read and ignored
+     */
+    status_t (*read)(uint8_t *data, size_t data_length);
+    /**
+     * Waits until all written data is sent (optional)
+     */
+    status_t (*flush)();
+    /**
+     * Provides up to max_length received bytes stored in the transport memory without copying them (optional)
+     */
+    status_t (*lease)(const uint8_t **data, size_t max_length, size_t *data_length);
+    /**
+     * Returns leased bytes to the transport, marking them as read (optional)
+     */
+    status_t (*release)(size_t data_length);
+    /**
+     * Changes baudrate of the link (optional)
+     */
+    status_t (*set_baudrate)(uint32_t baudrate);
+    /**
+     * Retrieves baudrate of the link (optional)
+     */
+    status_t (*get_baudrate)(uint32_t *baudrate);
+};
+
+/**
+ * Initialize protocol. Transports from PROTOCOL_TRANSPORTS are initialized in order until one of them succeeds
  *
  * @returns status of initialization
  */
 status_t protocol_init();
 
+/**
+ * Initializes transport with given name and binds the protocol to it
+ *
+ * @param name name of the transport
+ *
+ * @returns status of the operation
+ */
+status_t protocol_select_transport(const char *name);
+
+/**
+ * Retrieves name of the transport the protocol is bound to
+ *
+ * @returns name of the transport or NULL if protocol is not initialized
+ */
+const char *protocol_get_transport_name();
+
 /**
  * Write buffer of bytes
  *
@@ -50,4 +121,50 @@ status_t protocol_write_data(const uint8_t *data, size_t data_length);
  */
 status_t protocol_read_data(uint8_t *data, size_t data_length);
 
+/**
+ * Waits until all written data is sent
+ *
+ * @returns status of the operation
+ */
+status_t protocol_flush();
+
+/**
+ * Provides received bytes stored in the transport memory without copying them. Leased bytes have to be returned with
+ * protocol_release before the next read or lease
+ *
+ * @param data pointer to the leased bytes
+ * @param max_length maximum number of bytes to lease
+ * @param data_length number of leased bytes, at least 1 on success
+ *
+ * @returns status of the operation, PROTOCOL_STATUS_NOT_SUPPORTED if the transport does not support leases
+ */
+status_t protocol_lease(const uint8_t **data, size_t max_length, size_t *data_length);
+
+/**
+ * Returns leased bytes to the transport
+ *
+ * @param data_length number of bytes consumed, not greater than the number of leased bytes
+ *
+ * @returns status of the operation
+ */
+status_t protocol_release(size_t data_length);
+
+/**
+ * Changes baudrate of the link. Data already written is sent with the previous baudrate
+ *
+ * @param baudrate new baudrate
+ *
+ * @returns status of the operation
+ */
+status_t protocol_set_baudrate(uint32_t baudrate);
+
+/**
+ * Retrieves current baudrate of the link
+ *
+ * @param baudrate retrieved baudrate
+ *
+ * @returns status of the operation
+ */
+status_t protocol_get_baudrate(uint32_t *baudrate);
+
 #endif // KENNING_INFERENCE_LIB_CORE_PROTOCOL_H_
@@ -7,13 +7,18 @@
 #ifndef KENNING_INFERENCE_LIB_CORE_RUNTIME_WRAPPER_H_
 #define KENNING_INFERENCE_LIB_CORE_RUNTIME_WRAPPER_H_
 
+#include <stdbool.h>
+
 #include "kenning_inference_lib/core/model_constraints.h"
 #include "kenning_inference_lib/core/utils.h"
 
 /**
  * Runtime custom error codes
  */
-#define RUNTIME_WRAPPER_STATUSES(STATUS) STATUS(RUNTIME_WRAPPER_STATUS_OUT_OF_MEMORY_ERROR)
+#define RUNTIME_WRAPPER_STATUSES(STATUS)               \
+    STATUS(RUNTIME_WRAPPER_STATUS_OUT_OF_MEMORY_ERROR) \
+    STATUS(RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED)       \
+    STATUS(RUNTIME_WRAPPER_STATUS_CANCELLED)
 
 GENERATE_MODULE_STATUSES(RUNTIME_WRAPPER);
 
@@ -232,6 +237,15 @@ typedef struct
     uint64_t peak_allocated;
 } runtime_statistics_allocation_t;
 
+/**
+ * Struct describing a contiguous part of the model output stored in the runtime memory
+ */
+typedef struct
+{
+    const uint8_t *data;
+    size_t size;
+} runtime_output_view_t;
+
 /**
  * Initializes runtime
  *
@@ -281,6 +295,18 @@ status_t runtime_run_model();
  */
 status_t runtime_get_model_output(uint8_t *model_output);
 
+/**
+ * Retrieves views of the model output stored in the runtime memory, without copying it. Views are valid until the next
+ * inference or runtime deinitialization.
+ *
+ * @param max_views maximum number of views that can be returned
+ * @param views array for the views of consecutive parts of the model output
+ * @param num_views number of returned views
+ *
+ * @returns status of the runtime, RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED if the runtime cannot expose its output
+ */
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views);
+
 /**
  * Retrieves runtime statistics
  *
@@ -293,6 +319,15 @@ status_t runtime_get_model_output(uint8_t *model_output);
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size);
 
+/**
+ * Checks if cancellation of the inference in progress was requested. Runtimes call it at preemption points, e.g.
+ * between model operators, and abort the inference with RUNTIME_WRAPPER_STATUS_CANCELLED if it returns true. Provided
+ * by the model module, as the request comes from the inference server.
+ *
+ * @returns true if the inference should be aborted
+ */
+bool runtime_cancel_requested();
+
 /**
  * Deinitializes runtime
  *
@@ -310,6 +345,7 @@ status_t runtime_deinit();
     LL_EXTENSION_SYMBOL(runtime_run_model);        \
     LL_EXTENSION_SYMBOL(runtime_run_model_bench);  \
     LL_EXTENSION_SYMBOL(runtime_get_model_output); \
+    LL_EXTENSION_SYMBOL(runtime_get_output_view);  \
     LL_EXTENSION_SYMBOL(runtime_get_statistics);   \
     LL_EXTENSION_SYMBOL(runtime_deinit);
 
@@ -172,6 +172,12 @@
 /**
  * Modules
  */
+#if defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+#define ARTIFACT_CACHE_MODULE(MODULE) MODULE(ARTIFACT_CACHE)
+#else // defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+#define ARTIFACT_CACHE_MODULE(MODULE)
+#endif // defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+
 #ifdef NO_KENNING_COMM
 #define MODULES(MODULE) \
     MODULE(MODEL)       \
@@ -186,7 +192,8 @@
     MODULE(MODEL)            \
     MODULE(PROTOCOL)         \
     MODULE(RUNTIME_WRAPPER)  \
-    MODULE(LOGGER)
+    MODULE(LOGGER)           \
+    ARTIFACT_CACHE_MODULE(MODULE)
 #endif // NO_KENNING_COMM
 
 /**
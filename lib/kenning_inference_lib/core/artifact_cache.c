@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kenning_inference_lib/core/artifact_cache.h"
+
+#include <mbedtls/sha256.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(artifact_cache, CONFIG_ARTIFACT_CACHE_LOG_LEVEL);
+
+GENERATE_MODULE_STATUSES_STR(ARTIFACT_CACHE);
+
+#define ARTIFACT_CACHE_PARTITION_ID FIXED_PARTITION_ID(kenning_cache_partition)
+#define ARTIFACT_CACHE_MAGIC 0x4B434143 // "KCAC"
+// Space reserved for the header at the beginning of the slot, artifact data follows it
+#define ARTIFACT_CACHE_HEADER_SIZE 64
+// Size of the buffer used to copy data between the flash and the loaders
+#define ARTIFACT_CACHE_CHUNK_SIZE 256
+
+/**
+ * Header of the cache slot
+ */
+struct artifact_cache_header
+{
+    uint32_t magic;
+    uint32_t size;
+    uint8_t hash[ARTIFACT_CACHE_HASH_SIZE];
+};
+
+_Static_assert(sizeof(struct artifact_cache_header) <= ARTIFACT_CACHE_HEADER_SIZE,
+               "Artifact cache header does not fit in the space reserved for it");
+
+static uint8_t __attribute__((aligned(8))) g_chunk[ARTIFACT_CACHE_CHUNK_SIZE];
+
+/**
+ * Opens cache partition and computes offset and size of the slot. Slots split the partition equally.
+ *
+ * @param slot cache slot
+ * @param fa opened flash area
+ * @param offset offset of the slot in the flash area
+ * @param size size of the slot
+ *
+ * @returns error status of the cache
+ */
+static status_t open_slot(ARTIFACT_CACHE_SLOT slot, const struct flash_area **fa, off_t *offset, size_t *size)
+{
+    if (slot >= NUM_ARTIFACT_CACHE_SLOTS)
+    {
+        return ARTIFACT_CACHE_STATUS_INV_ARG;
+    }
+    int ret = flash_area_open(ARTIFACT_CACHE_PARTITION_ID, fa);
+    RETURN_ON_ERROR_LOG(ret, ARTIFACT_CACHE_STATUS_FLASH_ERROR, "Cache partition open error: %d", ret);
+
+    *size = (*fa)->fa_size / NUM_ARTIFACT_CACHE_SLOTS;
+    *offset = slot * (*size);
+    return STATUS_OK;
+}
+
+/**
+ * Reads header of the slot and checks if it describes a valid artifact
+ *
+ * @param fa opened flash area
+ * @param offset offset of the slot in the flash area
+ * @param size size of the slot
+ * @param header read header
+ *
+ * @returns STATUS_OK if the slot contains an artifact, ARTIFACT_CACHE_STATUS_MISS if it is empty
+ */
+static status_t read_header(const struct flash_area *fa, off_t offset, size_t size,
+                            struct artifact_cache_header *header)
+{
+    int ret = flash_area_read(fa, offset, header, sizeof(*header));
+    RETURN_ON_ERROR_LOG(ret, ARTIFACT_CACHE_STATUS_FLASH_ERROR, "Cache header read error: %d", ret);
+
+    if (ARTIFACT_CACHE_MAGIC != header->magic || header->size > size - ARTIFACT_CACHE_HEADER_SIZE)
+    {
+        return ARTIFACT_CACHE_STATUS_MISS;
+    }
+    return STATUS_OK;
+}
+
+status_t artifact_cache_find(ARTIFACT_CACHE_SLOT slot, const uint8_t *hash, size_t *size)
+{
+    const struct flash_area *fa;
+    struct artifact_cache_header header;
+    off_t offset;
+    size_t slot_size;
+
+    RETURN_ERROR_IF_POINTER_INVALID(hash, ARTIFACT_CACHE_STATUS_INV_PTR);
+    RETURN_ERROR_IF_POINTER_INVALID(size, ARTIFACT_CACHE_STATUS_INV_PTR);
+
+    status_t status = open_slot(slot, &fa, &offset, &slot_size);
+    RETURN_ON_ERROR(status, status);
+
+    status = read_header(fa, offset, slot_size, &header);
+    flash_area_close(fa);
+    RETURN_ON_ERROR(status, status);
+
+    if (memcmp(header.hash, hash, ARTIFACT_CACHE_HASH_SIZE))
+    {
+        return ARTIFACT_CACHE_STATUS_MISS;
+    }
+    *size = header.size;
+    return STATUS_OK;
+}
+
+status_t artifact_cache_read(ARTIFACT_CACHE_SLOT slot, struct msg_loader *ldr)
+{
+    const struct flash_area *fa;
+    struct artifact_cache_header header;
+    off_t offset;
+    size_t slot_size;
+
+    RETURN_ERROR_IF_POINTER_INVALID(ldr, ARTIFACT_CACHE_STATUS_INV_PTR);
+
+    status_t status = open_slot(slot, &fa, &offset, &slot_size);
+    RETURN_ON_ERROR(status, status);
+
+    status = read_header(fa, offset, slot_size, &header);
+    for (size_t read = 0; STATUS_OK == status && read < header.size; read += ARTIFACT_CACHE_CHUNK_SIZE)
+    {
+        size_t n = MIN(ARTIFACT_CACHE_CHUNK_SIZE, header.size - read);
+        int ret = flash_area_read(fa, offset + ARTIFACT_CACHE_HEADER_SIZE + read, g_chunk, n);
+        if (ret)
+        {
+            LOG_ERR("Cache data read error: %d", ret);
+            status = ARTIFACT_CACHE_STATUS_FLASH_ERROR;
+            break;
+        }
+        status = ldr->save(ldr, g_chunk, n);
+    }
+    flash_area_close(fa);
+    return status;
+}
+
+status_t artifact_cache_store(ARTIFACT_CACHE_SLOT slot, const uint8_t *hash, const uint8_t *data, size_t size)
+{
+    const struct flash_area *fa;
+    struct artifact_cache_header header = {.magic = ARTIFACT_CACHE_MAGIC, .size = size};
+    uint8_t digest[ARTIFACT_CACHE_HASH_SIZE];
+    off_t offset;
+    size_t slot_size;
+    int ret = 0;
+
+    RETURN_ERROR_IF_POINTER_INVALID(hash, ARTIFACT_CACHE_STATUS_INV_PTR);
+    RETURN_ERROR_IF_POINTER_INVALID(data, ARTIFACT_CACHE_STATUS_INV_PTR);
+
+    // hash comes from the client, so data that does not match it (e.g. a different artifact) is not stored under it
+    ret = mbedtls_sha256(data, size, digest, 0);
+    RETURN_ON_ERROR_LOG(ret, ARTIFACT_CACHE_STATUS_ERROR, "Artifact hash computation error: %d", ret);
+    if (memcmp(digest, hash, ARTIFACT_CACHE_HASH_SIZE))
+    {
+        LOG_WRN("Artifact of size %zu does not match the queried hash, it is not cached", size);
+        return ARTIFACT_CACHE_STATUS_HASH_MISMATCH;
+    }
+
+    status_t status = open_slot(slot, &fa, &offset, &slot_size);
+    RETURN_ON_ERROR(status, status);
+
+    size_t align = flash_area_align(fa);
+    uint8_t erased_val = flash_area_erased_val(fa);
+
+    do
+    {
+        if (size > slot_size - ARTIFACT_CACHE_HEADER_SIZE || align > ARTIFACT_CACHE_HEADER_SIZE)
+        {
+            LOG_ERR("Artifact of size %zu does not fit in the cache slot of size %zu", size, slot_size);
+            status = ARTIFACT_CACHE_STATUS_TOO_BIG;
+            break;
+        }
+        ret = flash_area_erase(fa, offset, slot_size);
+        BREAK_ON_TRUE_LOG_SET_STATUS(status, ARTIFACT_CACHE_STATUS_FLASH_ERROR, ret, "Cache slot erase error: %d",
+                                     ret);
+
+        // data is written directly except for its unaligned tail, which is padded in the chunk buffer
+        size_t aligned_size = ROUND_DOWN(size, align);
+        off_t data_offset = offset + ARTIFACT_CACHE_HEADER_SIZE;
+        if (aligned_size > 0)
+        {
+            ret = flash_area_write(fa, data_offset, data, aligned_size);
+            BREAK_ON_TRUE_LOG_SET_STATUS(status, ARTIFACT_CACHE_STATUS_FLASH_ERROR, ret, "Cache data write error: %d",
+                                         ret);
+        }
+        if (aligned_size < size)
+        {
+            memset(g_chunk, erased_val, align);
+            memcpy(g_chunk, data + aligned_size, size - aligned_size);
+            ret = flash_area_write(fa, data_offset + aligned_size, g_chunk, align);
+            BREAK_ON_TRUE_LOG_SET_STATUS(status, ARTIFACT_CACHE_STATUS_FLASH_ERROR, ret, "Cache data write error: %d",
+                                         ret);
+        }
+
+        // header is written last, so that interrupted write leaves the slot empty
+        memcpy(header.hash, hash, ARTIFACT_CACHE_HASH_SIZE);
+        memset(g_chunk, erased_val, ARTIFACT_CACHE_HEADER_SIZE);
+        memcpy(g_chunk, &header, sizeof(header));
+        ret = flash_area_write(fa, offset, g_chunk, ARTIFACT_CACHE_HEADER_SIZE);
+        BREAK_ON_TRUE_LOG_SET_STATUS(status, ARTIFACT_CACHE_STATUS_FLASH_ERROR, ret, "Cache header write error: %d",
+                                     ret);
+
+        LOG_INF("Cached artifact of size %zu in slot %d", size, slot);
+    } while (0);
+
+    flash_area_close(fa);
+    return status;
+}
+
+status_t artifact_cache_invalidate(ARTIFACT_CACHE_SLOT slot)
+{
+    const struct flash_area *fa;
+    off_t offset;
+    size_t slot_size;
+
+    status_t status = open_slot(slot, &fa, &offset, &slot_size);
+    RETURN_ON_ERROR(status, status);
+
+    int ret = flash_area_erase(fa, offset, slot_size);
+    if (ret)
+    {
+        LOG_ERR("Cache slot erase error: %d", ret);
+        status = ARTIFACT_CACHE_STATUS_FLASH_ERROR;
+    }
+    flash_area_close(fa);
+    return status;
+}
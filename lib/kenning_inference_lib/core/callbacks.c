@@ -30,6 +30,14 @@
 #include "kenning_inference_lib/core/logger.h"
 #endif
 
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+#include "kenning_inference_lib/core/inference_server.h"
+#endif
+
+#if defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+#include "kenning_inference_lib/core/artifact_cache.h"
+#endif
+
 // Zephelin includes
 #ifdef CONFIG_ZPL
 #include <tracing_backend.h>
@@ -58,6 +66,27 @@ extern const char *const MESSAGE_TYPE_STR[];
 
 bool g_client_connected = false;
 
+// whether model inputs from DATA transmissions are processed right away and their outputs are pushed to the client
+static bool g_stream_active = false;
+// whether model statistics are appended to the outputs pushed in the stream session
+static bool g_stream_stats = false;
+
+#if defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+// hashes of artifacts queried with CACHE_QUERY and missing in the cache, they are cached after the next upload
+static uint8_t g_cache_pending_hash[NUM_ARTIFACT_CACHE_SLOTS][ARTIFACT_CACHE_HASH_SIZE];
+static bool g_cache_pending[NUM_ARTIFACT_CACHE_SLOTS];
+
+static void cache_uploaded_artifact(ARTIFACT_CACHE_SLOT slot, const protocol_event_t *request,
+                                    const struct msg_loader *ldr);
+#define CACHE_UPLOADED_ARTIFACT(slot, request, ldr) cache_uploaded_artifact(slot, request, ldr)
+#else // defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+#define CACHE_UPLOADED_ARTIFACT(slot, request, ldr)
+#endif // defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+
+static status_t run_inference(size_t input_size, protocol_payload_t *resp_payload, bool with_stats);
+
+bool stream_session_active() { return g_stream_active; }
+
 /**
  * Handles unsupported message
  *
@@ -77,11 +106,66 @@ status_t unsupported_callback(protocol_event_t *request, protocol_payload_t *res
     return STATUS_OK;
 }
 
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+/**
+ * Handles baudrate proposed by the client in the PING request payload (32-bit unsigned integer). The proposed
+ * baudrate is limited to CONFIG_KENNING_BAUDRATE_MAX and the accepted baudrate is sent back in the response payload.
+ * The link switches to the accepted baudrate after the response is sent. If the transport has no baudrate, the response
+ * payload is empty.
+ *
+ * @param request incoming request
+ * @param resp_payload payload, that will be sent in response by the server (accepted baudrate)
+ *
+ * @returns error status of the negotiation
+ */
+static status_t negotiate_baudrate(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    status_t status = STATUS_OK;
+    uint32_t baudrate = 0;
+
+    if (!request->flags.general_purpose_flags.has_payload)
+    {
+        // client did not propose any baudrate
+        return STATUS_OK;
+    }
+    status = protocol_get_baudrate(&baudrate);
+    if (PROTOCOL_STATUS_NOT_SUPPORTED == status)
+    {
+        // empty response tells the client to keep the current link settings
+        LOG_WRN("Transport does not support baudrate change, proposal ignored");
+        return STATUS_OK;
+    }
+    RETURN_ON_ERROR(status, status);
+    if (sizeof(baudrate) != request->payload.size)
+    {
+        LOG_ERR("Invalid baudrate proposal size: %d", request->payload.size);
+        return CALLBACKS_STATUS_INV_ARG;
+    }
+
+    memcpy(&baudrate, request->payload.loader->addr, sizeof(baudrate));
+    if (0 == baudrate)
+    {
+        return CALLBACKS_STATUS_INV_ARG;
+    }
+    baudrate = MIN(baudrate, CONFIG_KENNING_BAUDRATE_MAX);
+
+    memcpy(resp_payload->raw_bytes, &baudrate, sizeof(baudrate));
+    resp_payload->size = sizeof(baudrate);
+
+    LOG_INF("Switching to baudrate %u", baudrate);
+    request_baudrate_change(baudrate);
+
+    return STATUS_OK;
+}
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
+
 /**
  * Serves as a way for client (Kenning) to initiate communication or signal end of communication.
  * PING request with the SUCCESS flag set means that Kenning has connected and wants to start
  * an inference session. Request with FAIL flag set means that the inference sessions has ended and
  * Kenning is disconnecting. Request with both flags set means ending the previous session and starting a new one.
+ * With CONFIG_KENNING_BAUDRATE_NEGOTIATION enabled, the request starting a session may contain baudrate proposed by
+ * the client and disconnection restores the default baudrate.
  *
  * @param request incoming request
  * @param resp_payload payload, that will be sent in response by the server (empty here)
@@ -100,12 +184,16 @@ status_t ping_callback(protocol_event_t *request, protocol_payload_t *resp_paylo
     if (request->flags.general_purpose_flags.fail)
     {
         g_client_connected = false;
+        g_stream_active = false;
 #ifdef CONFIG_ZPL_SCOPE_MARKING
         zpl_code_scope_exit(inference_session);
 #endif
         LOG_INF("Client disconnected.");
 #ifdef CONFIG_KENNING_SEND_LOGS
         logger_stop();
+#endif
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+        request_baudrate_change(0);
 #endif
     }
     if (request->flags.general_purpose_flags.success)
@@ -132,6 +220,9 @@ status_t ping_callback(protocol_event_t *request, protocol_payload_t *resp_paylo
             LOG_INF("Resetting Zephelin trace buffer...");
             struct tracing_backend *working_backend = tracing_backend_get(CONFIG_TRACING_BACKEND_NAME);
             tracing_backend_init(working_backend);
+#endif
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+            return negotiate_baudrate(request, resp_payload);
 #endif
             return STATUS_OK;
         }
@@ -139,9 +230,92 @@ status_t ping_callback(protocol_event_t *request, protocol_payload_t *resp_paylo
     return STATUS_OK;
 }
 
+_Static_assert(NUM_MESSAGE_TYPES <= 8 * sizeof(((device_status_t *)0)->supported_message_types),
+               "Supported message types do not fit in the device status");
+_Static_assert(sizeof(device_status_t) <= CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE,
+               "Device status does not fit in the response payload");
+
+/**
+ * Retrieves maximum size of the payload accepted by the loader of given type
+ *
+ * @param loader_type type of the loader
+ *
+ * @returns maximum size of the payload, 0 if there is no loader of given type
+ */
+static size_t get_loader_max_size(LOADER_TYPE loader_type)
+{
+    size_t max_size = 0;
+
+    // the last table overrides loaders of the previous ones, as in the inference server
+    for (int i = 0; i < LDR_TABLE_COUNT; i++)
+    {
+        if (IS_VALID_POINTER(g_ldr_tables[i][loader_type]))
+        {
+            max_size = g_ldr_tables[i][loader_type]->max_size;
+        }
+    }
+#ifdef CONFIG_LLEXT
+    if (LOADER_TYPE_RUNTIME == loader_type && 0 == max_size)
+    {
+        // runtime buffer is allocated on the LLEXT heap when the runtime is received
+        max_size = CONFIG_LLEXT_HEAP_SIZE * 1024;
+    }
+#endif // CONFIG_LLEXT
+#ifdef CONFIG_KENNING_SERVER_PIPELINE
+    if (LOADER_TYPE_DATA == loader_type)
+    {
+        // model inputs are received to the staging buffers first
+        max_size = MIN(max_size, CONFIG_KENNING_SERVER_PIPELINE_INPUT_BUFFER_SIZE);
+    }
+#endif // CONFIG_KENNING_SERVER_PIPELINE
+    return max_size;
+}
+
+/**
+ * Handles STATUS message. It sends back capabilities of the device (device_status_t), i.e. name of the runtime,
+ * model state, sizes of loaders and protocol buffers and message types handled by the server, so the client can pick
+ * sizes of messages and check if a model fits in the device before sending it.
+ *
+ * @param request incoming request.
+ * @param resp_payload payload, that will be sent in response by the server (device status)
+ *
+ * @returns error status of the callback
+ */
+status_t status_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    device_status_t device_status;
+
+    VALIDATE_HEADER(MESSAGE_TYPE_STATUS, request);
+
+    memset(&device_status, 0, sizeof(device_status));
+    strncpy((char *)device_status.runtime_name, CONFIG_KENNING_ML_RUNTIME_NAME,
+            sizeof(device_status.runtime_name) - 1);
+    device_status.model_state = model_get_state();
+    device_status.num_loader_types = NUM_LOADER_TYPES;
+    for (int i = 0; i < NUM_LOADER_TYPES; i++)
+    {
+        device_status.loader_max_size[i] = get_loader_max_size(i);
+    }
+    device_status.response_payload_size = CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE;
+    device_status.max_outgoing_message_size = CONFIG_KENNING_PROTOCOL_MAX_OUTGOING_MESSAGE_SIZE;
+    device_status.recv_buffer_size = CONFIG_KENNING_MESSAGE_RECV_BUFFER_SIZE;
+    for (int i = 0; i < NUM_MESSAGE_TYPES; i++)
+    {
+        if (unsupported_callback != g_msg_callback[i])
+        {
+            device_status.supported_message_types |= (uint64_t)1 << i;
+        }
+    }
+
+    memcpy(resp_payload->raw_bytes, &device_status, sizeof(device_status));
+    resp_payload->size = sizeof(device_status);
+    return STATUS_OK;
+}
+
 /**
  * Handles DATA message that contains model input. It calls model's function
- * that loads it.
+ * that loads it. In a stream session, input sent in a transmission is also
+ * processed and the model output is prepared to be pushed to the client.
  *
  * @param request incoming request.
  * @param resp_payload payload, that will be sent in response by the server (empty here)
@@ -155,6 +329,11 @@ status_t data_callback(protocol_event_t *request, protocol_payload_t *resp_paylo
 
     VALIDATE_HEADER(MESSAGE_TYPE_DATA, request);
 
+    if (g_stream_active && !request->is_request)
+    {
+        return run_inference(request->payload.size, resp_payload, g_stream_stats);
+    }
+
     ZPL_MARK_CODE_SCOPE(model_input_loading) { status = model_load_input_from_loader(request->payload.size); }
 
     CHECK_STATUS_LOG(status, "model_load_input returned 0x%x (%s)", status, get_status_str(status));
@@ -164,7 +343,8 @@ status_t data_callback(protocol_event_t *request, protocol_payload_t *resp_paylo
 
 /**
  * Handles MODEL message that contains model data. It calls model's function
- * that loads the model.
+ * that loads the model. If the model was queried with CACHE_QUERY and is
+ * missing in the cache, it is cached before loading.
  *
  * @param request incoming request.
  * @param resp_payload payload, that will be sent in response by the server (empty here)
@@ -178,6 +358,9 @@ status_t model_callback(protocol_event_t *request, protocol_payload_t *resp_payl
 
     VALIDATE_HEADER(MESSAGE_TYPE_MODEL, request);
 
+    // runtime may modify the model buffer when loading it, so it is cached first
+    CACHE_UPLOADED_ARTIFACT(ARTIFACT_CACHE_SLOT_MODEL, request, request->payload.loader);
+
     ZPL_MARK_CODE_SCOPE(model_loading) { status = model_load_weights_from_loader(); }
 
     CHECK_STATUS_LOG(status, "model_load_weights returned 0x%x (%s)", status, get_status_str(status));
@@ -209,6 +392,70 @@ status_t process_callback(protocol_event_t *request, protocol_payload_t *resp_pa
     return status;
 }
 
+/**
+ * Prepares response payload with model output, optionally followed by model statistics. If the runtime exposes its
+ * output, the payload consists of segments pointing to the runtime memory, otherwise the output is copied to the
+ * response buffer.
+ *
+ * @param resp_payload payload, that will be sent in response by the server
+ * @param with_stats whether model statistics should be appended to the output
+ *
+ * @returns status of the output retrieval
+ */
+static status_t prepare_output_payload(protocol_payload_t *resp_payload, bool with_stats)
+{
+    static protocol_segment_t output_segments[MAX_MODEL_OUTPUT_NUM + 1];
+    runtime_output_view_t output_views[MAX_MODEL_OUTPUT_NUM];
+    uint8_t *resp_buffer = resp_payload->raw_bytes;
+    status_t status = STATUS_OK;
+    size_t model_output_size = 0;
+    size_t statistics_offset = 0;
+    size_t statistics_size = 0;
+    size_t num_views = 0;
+    bool output_copied = false;
+
+    status = model_get_output_view(MAX_MODEL_OUTPUT_NUM, output_views, &num_views);
+    if (RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED == status)
+    {
+        // runtime cannot expose its output, so it is copied to the response buffer
+        status = model_get_output(CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE, resp_buffer, &model_output_size);
+        statistics_offset = model_output_size;
+        output_copied = true;
+    }
+    RETURN_ON_ERROR(status, status);
+
+    for (size_t i = 0; i < num_views; ++i)
+    {
+        output_segments[i].data = output_views[i].data;
+        output_segments[i].size = output_views[i].size;
+        model_output_size += output_views[i].size;
+    }
+
+    if (with_stats)
+    {
+        status = model_get_statistics(CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE - statistics_offset,
+                                      resp_buffer + statistics_offset, &statistics_size);
+        RETURN_ON_ERROR(status, status);
+    }
+
+    if (!output_copied)
+    {
+        // output is sent directly from the runtime memory, which is valid until the next inference
+        if (statistics_size > 0)
+        {
+            output_segments[num_views].data = resp_buffer;
+            output_segments[num_views].size = statistics_size;
+            num_views++;
+        }
+        resp_payload->type = PROTOCOL_PAYLOAD_TYPE_SEGMENTS;
+        resp_payload->segments = output_segments;
+        resp_payload->segment_count = num_views;
+    }
+
+    resp_payload->size = model_output_size + statistics_size;
+    return STATUS_OK;
+}
+
 /**
  * Handles OUTPUT message. It retrieves model inference output and sends it back
  *
@@ -221,18 +468,13 @@ ZPL_CODE_SCOPE_DEFINE(model_output_retrieval, TRACE_MODEL);
 status_t output_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
 {
     status_t status = STATUS_OK;
-    size_t model_output_size = 0;
 
     VALIDATE_HEADER(MESSAGE_TYPE_OUTPUT, request);
 
-    ZPL_MARK_CODE_SCOPE(model_output_retrieval)
-    {
-        status = model_get_output(CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE, resp_payload->raw_bytes, &model_output_size);
-    }
+    ZPL_MARK_CODE_SCOPE(model_output_retrieval) { status = prepare_output_payload(resp_payload, false); }
 
     CHECK_STATUS_LOG(status, "model_get_output returned 0x%x (%s)", status, get_status_str(status));
 
-    resp_payload->size = model_output_size;
     return STATUS_OK;
 }
 
@@ -286,24 +528,297 @@ status_t iospec_callback(protocol_event_t *request, protocol_payload_t *resp_pay
     return status;
 }
 
-#if defined(CONFIG_LLEXT) || defined(CONFIG_ZTEST)
+/**
+ * Loads model input received to the DATA loader, runs the model and prepares response payload with its output
+ *
+ * @param input_size size of the received model input
+ * @param resp_payload payload, that will be sent in response by the server (model output and statistics)
+ * @param with_stats whether model statistics should be appended to the output
+ *
+ * @returns status of the inference
+ */
+static status_t run_inference(size_t input_size, protocol_payload_t *resp_payload, bool with_stats)
+{
+    status_t status = STATUS_OK;
+
+    ZPL_MARK_CODE_SCOPE(model_input_loading) { status = model_load_input_from_loader(input_size); }
+
+    CHECK_STATUS_LOG(status, "model_load_input returned 0x%x (%s)", status, get_status_str(status));
+    RETURN_ON_ERROR(status, status);
+
+    ZPL_MARK_CODE_SCOPE(model_processing) { status = model_run_bench(); }
+
+    CHECK_STATUS_LOG(status, "model_run returned 0x%x (%s)", status, get_status_str(status));
+    RETURN_ON_ERROR(status, status);
+
+    ZPL_MARK_CODE_SCOPE(model_output_retrieval) { status = prepare_output_payload(resp_payload, with_stats); }
+
+    CHECK_STATUS_LOG(status, "model_get_output returned 0x%x (%s)", status, get_status_str(status));
+
+    return status;
+}
+
+/**
+ * Handles INFER message that contains model input. It loads the input, runs the model and sends back its output,
+ * followed by model statistics if requested, so the inference requires a single request instead of DATA, PROCESS and
+ * OUTPUT requests
+ *
+ * @param request incoming request.
+ * @param resp_payload payload, that will be sent in response by the server (model output and statistics)
+ *
+ * @returns error status of the callback
+ */
+status_t infer_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    VALIDATE_HEADER(MESSAGE_TYPE_INFER, request);
+
+    return run_inference(request->payload.size, resp_payload, request->flags.flags_infer.stats);
+}
 
 /**
- * Handles RUNTIME message. It loads runtime provided as loadable linkable extension.
+ * Handles STREAM message. Request with the SUCCESS flag set opens a stream session, in which model inputs sent by
+ * the client in DATA transmissions are processed without waiting for PROCESS and OUTPUT requests, and the server
+ * sends model output of each of them in an OUTPUT transmission. If the stats flag is set, model statistics are
+ * appended to each output. Request with the FAIL flag set closes the session. The session is also closed when the
+ * client disconnects.
  *
  * @param request incoming request.
  * @param resp_payload payload, that will be sent in response by the server (empty here)
  *
  * @returns error status of the callback
  */
-status_t runtime_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+status_t stream_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    VALIDATE_HEADER(MESSAGE_TYPE_STREAM, request);
+
+    if (request->flags.general_purpose_flags.fail)
+    {
+        g_stream_active = false;
+        LOG_INF("Stream session closed");
+    }
+    if (request->flags.general_purpose_flags.success)
+    {
+        if (g_stream_active)
+        {
+            LOG_ERR("Stream session already open.");
+            return CALLBACKS_STATUS_ERROR;
+        }
+        g_stream_active = true;
+        g_stream_stats = request->flags.flags_infer.stats;
+        LOG_INF("Stream session opened");
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Handles CANCEL message. It requests the inference in progress to be aborted at the next preemption point of the
+ * runtime, the request of that inference is then responded with the FAIL flag set. The inference can be in progress
+ * only if the server pipeline is used, otherwise requests are received after the inference ends and CANCEL has no
+ * effect.
+ *
+ * @param request incoming request.
+ * @param resp_payload payload, that will be sent in response by the server (empty here)
+ *
+ * @returns error status of the callback
+ */
+status_t cancel_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    VALIDATE_HEADER(MESSAGE_TYPE_CANCEL, request);
+
+    model_request_cancel();
+    LOG_DBG("Inference cancellation requested");
+    return STATUS_OK;
+}
+
+/**
+ * Handles UPLOAD_OFFSET message. It sends back the type and the received size of MODEL or RUNTIME transmission
+ * interrupted by a receive error, so that the client can resume it instead of sending the whole payload again.
+ *
+ * @param request incoming request.
+ * @param resp_payload payload, that will be sent in response by the server (upload_offset_resp_t)
+ *
+ * @returns error status of the callback
+ */
+status_t upload_offset_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    upload_offset_resp_t resp = {.interrupted = 0};
+    message_type_t message_type = 0;
+    bool compressed = false;
+    bool patch = false;
+    size_t offset = 0;
+
+    VALIDATE_HEADER(MESSAGE_TYPE_UPLOAD_OFFSET, request);
+
+    if (!protocol_get_interrupted_upload(&message_type, &compressed, &patch, &offset))
+    {
+        LOG_DBG("No interrupted transmission");
+    }
+    else if (offset > UINT32_MAX)
+    {
+        // offset field of the response is 32-bit, so such transmission has to be started from the beginning
+        LOG_WRN("Interrupted %s transmission received up to %zu, it cannot be resumed", MESSAGE_TYPE_STR[message_type],
+                offset);
+    }
+    else
+    {
+        resp.interrupted = 1;
+        resp.message_type = message_type;
+        resp.compressed = compressed;
+        resp.patch = patch;
+        resp.offset = (uint32_t)offset;
+        LOG_DBG("Interrupted %s transmission received up to %zu", MESSAGE_TYPE_STR[message_type], offset);
+    }
+
+    memcpy(resp_payload->raw_bytes, &resp, sizeof(resp));
+    resp_payload->size = sizeof(resp);
+    return STATUS_OK;
+}
+
+#if defined(CONFIG_KENNING_BATCH_INFERENCE) || defined(CONFIG_ZTEST)
+
+/**
+ * Runs inference on consecutive model inputs and stores their outputs and statistics one after another
+ *
+ * @param batch model inputs of the batch
+ * @param num_samples number of model inputs in the batch
+ * @param input_size size of a single model input
+ * @param output_size size of a single model output
+ * @param statistics_size size of model statistics of a single inference, 0 if statistics are not stored
+ * @param outputs buffer for model outputs, it may overlap inputs of the batch that were already run
+ * @param statistics buffer for model statistics
+ *
+ * @returns status of the inference
+ */
+static status_t run_batch(const uint8_t *batch, size_t num_samples, size_t input_size, size_t output_size,
+                          size_t statistics_size, uint8_t *outputs, uint8_t *statistics)
 {
     status_t status = STATUS_OK;
-    int llext_status = 0;
 
-    VALIDATE_HEADER(MESSAGE_TYPE_RUNTIME, request);
+    for (size_t i = 0; i < num_samples; ++i)
+    {
+        status = model_load_input(batch + i * input_size, input_size);
+        RETURN_ON_ERROR_LOG(status, status, "model_load_input returned 0x%x (sample %zu)", status, i);
 
-    size_t llext_size = request->payload.size;
+        status = model_run_bench();
+        RETURN_ON_ERROR_LOG(status, status, "model_run returned 0x%x (sample %zu)", status, i);
+
+        status = model_get_output(output_size, outputs + i * output_size, NULL);
+        RETURN_ON_ERROR_LOG(status, status, "model_get_output returned 0x%x (sample %zu)", status, i);
+
+        if (statistics_size > 0)
+        {
+            size_t sample_statistics_size = 0;
+
+            status = model_get_statistics(statistics_size, statistics + i * statistics_size, &sample_statistics_size);
+            RETURN_ON_ERROR_LOG(status, status, "model_get_statistics returned 0x%x (sample %zu)", status, i);
+        }
+    }
+
+    return STATUS_OK;
+}
+
+/**
+ * Handles INFER_BATCH message that contains consecutive model inputs. It runs the model on each of them and sends
+ * back their outputs, followed by model statistics of each inference if requested. Outputs not larger than inputs
+ * are stored in place of the inputs that were already run and sent from the batch buffer, other outputs and the
+ * statistics are stored in the response buffer. Sizes of the response are checked before the batch is run.
+ *
+ * @param request incoming request.
+ * @param resp_payload payload, that will be sent in response by the server (model outputs and statistics)
+ *
+ * @returns error status of the callback
+ */
+ZPL_CODE_SCOPE_DEFINE(model_batch_processing, TRACE_MODEL);
+status_t infer_batch_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    static protocol_segment_t batch_segments[2];
+    struct msg_loader *msg_loader_batch = g_ldr_tables[0][LOADER_TYPE_BATCH];
+    uint8_t *resp_buffer = resp_payload->raw_bytes;
+    status_t status = STATUS_OK;
+    size_t input_size = 0;
+    size_t output_size = 0;
+    size_t statistics_size = 0;
+    size_t num_samples = 0;
+    size_t resp_outputs_size = 0;
+    uint8_t *outputs = NULL;
+
+    VALIDATE_HEADER(MESSAGE_TYPE_INFER_BATCH, request);
+    RETURN_ERROR_IF_POINTER_INVALID(msg_loader_batch, CALLBACKS_STATUS_INV_PTR);
+
+    status = model_get_input_size(&input_size);
+    RETURN_ON_ERROR_LOG(status, status, "model_get_input_size returned 0x%x (%s)", status, get_status_str(status));
+    status = model_get_output_size(&output_size);
+    RETURN_ON_ERROR_LOG(status, status, "model_get_output_size returned 0x%x (%s)", status, get_status_str(status));
+
+    if (0 == input_size || 0 == request->payload.size || 0 != request->payload.size % input_size)
+    {
+        RETURN_LOG_ERROR(CALLBACKS_STATUS_INV_ARG, "Batch size %u is not a multiple of model input size %zu",
+                         request->payload.size, input_size);
+    }
+    num_samples = request->payload.size / input_size;
+
+    // input is copied to the runtime before the inference, so its place in the batch buffer can hold the output
+    if (output_size <= input_size)
+    {
+        outputs = msg_loader_batch->addr;
+    }
+    else
+    {
+        outputs = resp_buffer;
+        resp_outputs_size = num_samples * output_size;
+    }
+    if (resp_outputs_size > CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE)
+    {
+        RETURN_LOG_ERROR(CALLBACKS_STATUS_INV_ARG, "Outputs of %zu samples do not fit in the response", num_samples);
+    }
+
+    if (request->flags.flags_infer.stats)
+    {
+        // statistics of each inference have the same size, so it is retrieved before the batch is run
+        status = model_get_statistics(CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE, resp_buffer, &statistics_size);
+        RETURN_ON_ERROR_LOG(status, status, "model_get_statistics returned 0x%x (%s)", status, get_status_str(status));
+        if (num_samples * statistics_size > CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE - resp_outputs_size)
+        {
+            RETURN_LOG_ERROR(CALLBACKS_STATUS_INV_ARG, "Statistics of %zu samples do not fit in the response",
+                             num_samples);
+        }
+    }
+
+    ZPL_MARK_CODE_SCOPE(model_batch_processing)
+    {
+        status = run_batch(msg_loader_batch->addr, num_samples, input_size, output_size, statistics_size, outputs,
+                           resp_buffer + resp_outputs_size);
+    }
+    RETURN_ON_ERROR(status, status);
+
+    LOG_DBG("Batch of %zu samples processed", num_samples);
+
+    batch_segments[0].data = outputs;
+    batch_segments[0].size = num_samples * output_size;
+    batch_segments[1].data = resp_buffer + resp_outputs_size;
+    batch_segments[1].size = num_samples * statistics_size;
+    resp_payload->type = PROTOCOL_PAYLOAD_TYPE_SEGMENTS;
+    resp_payload->segments = batch_segments;
+    resp_payload->segment_count = statistics_size > 0 ? 2 : 1;
+    resp_payload->size = batch_segments[0].size + batch_segments[1].size;
+    return STATUS_OK;
+}
+
+#endif // defined(CONFIG_KENNING_BATCH_INFERENCE) || defined(CONFIG_ZTEST)
+
+#if defined(CONFIG_LLEXT) || defined(CONFIG_ZTEST)
+
+/**
+ * Loads runtime provided as loadable linkable extension from the runtime loader buffer and initializes the model
+ *
+ * @param llext_size size of the extension
+ *
+ * @returns error status of the runtime loading
+ */
+static status_t load_runtime(size_t llext_size)
+{
+    status_t status = STATUS_OK;
+    int llext_status = 0;
 
     LOG_INF("Attempting to load %d", llext_size);
     struct llext_buf_loader buf_loader = LLEXT_BUF_LOADER(g_ldr_tables[0][LOADER_TYPE_RUNTIME]->addr, llext_size);
@@ -350,9 +865,180 @@ status_t runtime_callback(protocol_event_t *request, protocol_payload_t *resp_pa
 
     CHECK_STATUS_LOG(status, "LLEXT runtime load returned: 0x%x (%s)", status, get_status_str(status));
 
+    return status;
+}
+
+/**
+ * Handles RUNTIME message. It loads runtime provided as loadable linkable extension. If the runtime was queried with
+ * CACHE_QUERY and is missing in the cache, it is cached before loading.
+ *
+ * @param request incoming request.
+ * @param resp_payload payload, that will be sent in response by the server (empty here)
+ *
+ * @returns error status of the callback
+ */
+status_t runtime_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    VALIDATE_HEADER(MESSAGE_TYPE_RUNTIME, request);
+
+    // relocations are applied in the runtime buffer, so it is cached first
+    CACHE_UPLOADED_ARTIFACT(ARTIFACT_CACHE_SLOT_RUNTIME, request, g_ldr_tables[0][LOADER_TYPE_RUNTIME]);
+
+    return load_runtime(request->payload.size);
+}
+
+#endif // defined(CONFIG_LLEXT) || defined(CONFIG_ZTEST)
+
+#if defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
+
+/**
+ * Caches uploaded artifact if it was queried with CACHE_QUERY and was missing in the cache. The queried hash is used
+ * only by the first upload after the query, and only if the upload is a whole artifact matching it. Failure to cache
+ * the artifact does not affect its loading.
+ *
+ * @param slot cache slot of the artifact
+ * @param request upload request
+ * @param ldr loader the artifact was uploaded to
+ */
+static void cache_uploaded_artifact(ARTIFACT_CACHE_SLOT slot, const protocol_event_t *request,
+                                    const struct msg_loader *ldr)
+{
+    if (!g_cache_pending[slot])
+    {
+        return;
+    }
+    g_cache_pending[slot] = false;
+
+    if (request->flags.flags_upload.patch)
+    {
+        LOG_WRN("Patched artifact is not cached");
+        return;
+    }
+
+    if (!IS_VALID_POINTER(ldr) || !IS_VALID_POINTER(ldr->addr))
+    {
+        LOG_WRN("Artifact is not stored in a buffer and cannot be cached");
+        return;
+    }
+    status_t status = artifact_cache_store(slot, g_cache_pending_hash[slot], ldr->addr, request->payload.size);
+    if (STATUS_OK != status)
+    {
+        LOG_WRN("Artifact caching returned 0x%x (%s)", status, get_status_str(status));
+    }
+}
+
+/**
+ * Restores artifact from the cache to its loader and loads it
+ *
+ * @param slot cache slot of the artifact
+ * @param hash content hash of the artifact
+ *
+ * @returns STATUS_OK if the artifact was loaded, ARTIFACT_CACHE_STATUS_MISS if it is not cached
+ */
+static status_t restore_cached_artifact(ARTIFACT_CACHE_SLOT slot, const uint8_t *hash)
+{
+    size_t size = 0;
+
+    status_t status = artifact_cache_find(slot, hash, &size);
     RETURN_ON_ERROR(status, status);
 
-    return status;
+    if (ARTIFACT_CACHE_SLOT_MODEL == slot)
+    {
+        struct msg_loader *ldr = g_ldr_tables[1][LOADER_TYPE_MODEL];
+        RETURN_ERROR_IF_POINTER_INVALID(ldr, CALLBACKS_STATUS_INV_PTR);
+
+        status = ldr->reset(ldr);
+        RETURN_ON_ERROR(status, status);
+        status = artifact_cache_read(slot, ldr);
+        RETURN_ON_ERROR(status, status);
+
+        return model_load_weights_from_loader();
+    }
+#if defined(CONFIG_LLEXT) || defined(CONFIG_ZTEST)
+    if (ARTIFACT_CACHE_SLOT_RUNTIME == slot)
+    {
+        struct msg_loader *ldr = g_ldr_tables[0][LOADER_TYPE_RUNTIME];
+        uint32_t runtime_size = size;
+        RETURN_ERROR_IF_POINTER_INVALID(ldr, CALLBACKS_STATUS_INV_PTR);
+
+        // runtime loader expects the size of the runtime before its data, as in the RUNTIME payload
+        status = ldr->reset(ldr);
+        RETURN_ON_ERROR(status, status);
+        status = ldr->save(ldr, (const uint8_t *)&runtime_size, sizeof(runtime_size));
+        RETURN_ON_ERROR(status, status);
+        status = artifact_cache_read(slot, ldr);
+        RETURN_ON_ERROR(status, status);
+
+        return load_runtime(size);
+    }
+#endif // defined(CONFIG_LLEXT) || defined(CONFIG_ZTEST)
+    return CALLBACKS_STATUS_INV_ARG;
 }
 
+/**
+ * Handles CACHE_QUERY message. It checks if the model or runtime with the hash given in the request (cache_query_t)
+ * is cached and, if so, restores and loads it, so that it does not have to be uploaded. Otherwise the hash is kept
+ * and the artifact is cached after it is uploaded. If the cached artifact fails to load, it is reported as missing.
+ *
+ * @param request incoming request.
+ * @param resp_payload payload, that will be sent in response by the server (cache_query_resp_t)
+ *
+ * @returns error status of the callback
+ */
+ZPL_CODE_SCOPE_DEFINE(cached_artifact_loading, TRACE_MODEL);
+status_t cache_query_callback(protocol_event_t *request, protocol_payload_t *resp_payload)
+{
+    status_t status = STATUS_OK;
+    cache_query_t query;
+    cache_query_resp_t resp = {.hit = 0};
+    ARTIFACT_CACHE_SLOT slot;
+
+    VALIDATE_HEADER(MESSAGE_TYPE_CACHE_QUERY, request);
+
+    if (sizeof(query) != request->payload.size || !IS_VALID_POINTER(request->payload.loader))
+    {
+        LOG_ERR("Invalid cache query size: %d", request->payload.size);
+        return CALLBACKS_STATUS_INV_ARG;
+    }
+    memcpy(&query, request->payload.loader->addr, sizeof(query));
+
+    switch (query.message_type)
+    {
+    case MESSAGE_TYPE_MODEL:
+        slot = ARTIFACT_CACHE_SLOT_MODEL;
+        break;
+#if defined(CONFIG_LLEXT) || defined(CONFIG_ZTEST)
+    case MESSAGE_TYPE_RUNTIME:
+        slot = ARTIFACT_CACHE_SLOT_RUNTIME;
+        break;
 #endif // defined(CONFIG_LLEXT) || defined(CONFIG_ZTEST)
+    default:
+        LOG_ERR("Message type %d cannot be cached", query.message_type);
+        return CALLBACKS_STATUS_INV_ARG;
+    }
+
+    ZPL_MARK_CODE_SCOPE(cached_artifact_loading) { status = restore_cached_artifact(slot, query.hash); }
+
+    if (STATUS_OK == status)
+    {
+        LOG_INF("Loaded cached %s", MESSAGE_TYPE_STR[query.message_type]);
+        resp.hit = 1;
+        g_cache_pending[slot] = false;
+    }
+    else
+    {
+        if (ARTIFACT_CACHE_STATUS_MISS != status)
+        {
+            LOG_WRN("Cached artifact restore returned 0x%x (%s)", status, get_status_str(status));
+            artifact_cache_invalidate(slot);
+        }
+        memcpy(g_cache_pending_hash[slot], query.hash, ARTIFACT_CACHE_HASH_SIZE);
+        g_cache_pending[slot] = true;
+    }
+
+    memcpy(resp_payload->raw_bytes, &resp, sizeof(resp));
+    resp_payload->size = sizeof(resp);
+    return STATUS_OK;
+}
+
+#endif // defined(CONFIG_KENNING_ARTIFACT_CACHE) || defined(CONFIG_ZTEST)
@@ -11,12 +11,14 @@
 #include "kenning_inference_lib/core/protocol.h"
 #include "kenning_inference_lib/core/utils.h"
 
+#include <string.h>
 #include <zephyr/sys/util.h>
 
 #ifndef __UNIT_TEST__
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #else // __UNIT_TEST__
+#include "mocks/kernel.h"
 #include "mocks/log.h"
 #endif
 
@@ -46,6 +48,16 @@ _Static_assert(
 #define TRACE_SERVER false
 #endif
 
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+// baudrate of the link after initialization, restored on failed baudrate change and client disconnection
+static uint32_t g_default_baudrate = 0;
+// baudrate to be set after the response is sent, 0 means the default baudrate
+static uint32_t g_requested_baudrate = 0;
+static bool g_baudrate_change_requested = false;
+// set after changing baudrate until the first event is received
+static bool g_baudrate_unconfirmed = false;
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
+
 #if defined(CONFIG_LLEXT)
 
 // Size in bytes of the field at the beginning of the runtime transmission/request payload,
@@ -132,6 +144,80 @@ status_t prepare_llext_loader()
 
 #endif // defined(CONFIG_LLEXT)
 
+status_t prepare_control_loader()
+{
+    static uint8_t __attribute__((aligned(4))) control_payload[CONTROL_PAYLOAD_SIZE];
+    static struct msg_loader msg_loader_control = MSG_LOADER_BUF(control_payload, sizeof(control_payload));
+    g_ldr_tables[0][LOADER_TYPE_CONTROL] = &msg_loader_control;
+
+    return STATUS_OK;
+}
+
+#ifdef CONFIG_KENNING_BATCH_INFERENCE
+
+status_t prepare_batch_loader()
+{
+    static uint8_t __attribute__((aligned(4))) batch_payload[CONFIG_KENNING_BATCH_BUFFER_SIZE];
+    static struct msg_loader msg_loader_batch = MSG_LOADER_BUF(batch_payload, sizeof(batch_payload));
+    g_ldr_tables[0][LOADER_TYPE_BATCH] = &msg_loader_batch;
+
+    return STATUS_OK;
+}
+
+#endif // CONFIG_KENNING_BATCH_INFERENCE
+
+void request_baudrate_change(uint32_t baudrate)
+{
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+    g_requested_baudrate = baudrate;
+    g_baudrate_change_requested = 0 != g_default_baudrate;
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
+}
+
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+/**
+ * Applies baudrate change requested with request_baudrate_change
+ */
+static void apply_baudrate_change()
+{
+    if (!g_baudrate_change_requested)
+    {
+        return;
+    }
+    g_baudrate_change_requested = false;
+
+    uint32_t baudrate = g_requested_baudrate ? g_requested_baudrate : g_default_baudrate;
+    status_t status = protocol_set_baudrate(baudrate);
+    if (STATUS_OK != status)
+    {
+        LOG_ERR("Changing baudrate to %u failed: 0x%x (%s)", baudrate, status, get_status_str(status));
+        return;
+    }
+    g_baudrate_unconfirmed = baudrate != g_default_baudrate;
+    LOG_INF("Baudrate changed to %u", baudrate);
+}
+
+/**
+ * Restores default baudrate if the first event after baudrate change was not received properly
+ *
+ * @param listen_status status of receiving the event
+ */
+static void confirm_baudrate_change(status_t listen_status)
+{
+    if (!g_baudrate_unconfirmed)
+    {
+        return;
+    }
+    g_baudrate_unconfirmed = false;
+
+    if (STATUS_OK != listen_status)
+    {
+        LOG_WRN("Communication failed after baudrate change, restoring %u", g_default_baudrate);
+        protocol_set_baudrate(g_default_baudrate);
+    }
+}
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
+
 status_t init_server()
 {
     status_t status = STATUS_OK;
@@ -140,6 +226,22 @@ status_t init_server()
     status = protocol_init();
     CHECK_INIT_STATUS_RET(status, "protocol_init returned 0x%x (%s)", status, get_status_str(status));
 
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+    status = protocol_get_baudrate(&g_default_baudrate);
+    if (PROTOCOL_STATUS_NOT_SUPPORTED == status)
+    {
+        // baudrate change requests are ignored for links without baudrate, e.g. TCP
+        g_default_baudrate = 0;
+        status = STATUS_OK;
+    }
+    CHECK_INIT_STATUS_RET(status, "protocol_get_baudrate returned 0x%x (%s)", status, get_status_str(status));
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
+
+    prepare_control_loader();
+#ifdef CONFIG_KENNING_BATCH_INFERENCE
+    prepare_batch_loader();
+#endif // CONFIG_KENNING_BATCH_INFERENCE
+
 // initialize model if LLEXT is not used
 #if !defined(CONFIG_LLEXT)
     status = model_init();
@@ -151,8 +253,10 @@ status_t init_server()
     return STATUS_OK;
 }
 
-struct msg_loader *loader_picker(message_type_t message_type)
+struct msg_loader *loader_picker(message_type_t message_type, payload_size_t payload_size)
 {
+    ARG_UNUSED(payload_size);
+
     struct msg_loader *ldr = NULL;
     for (int i = 0; i < LDR_TABLE_COUNT; i++)
     {
@@ -166,7 +270,16 @@ struct msg_loader *loader_picker(message_type_t message_type)
 }
 
 ZPL_CODE_SCOPE_DEFINE(server_wait_for_request, TRACE_SERVER);
-status_t wait_for_protocol_event(protocol_event_t *event)
+/**
+ * Waits for incoming transmission or request, its payload is received to the loader returned by the given picker
+ *
+ * @param event pointer to the protocol event received
+ * @param picker function returning loader for the payload of the given message type and size
+ *
+ * @returns STATUS_OK if event was received
+ */
+static status_t receive_protocol_event(protocol_event_t *event,
+                                       struct msg_loader *(*picker)(message_type_t, payload_size_t))
 {
 #ifdef CONFIG_ZPL_SCOPE_MARKING
     zpl_code_scope_enter(server_wait_for_request);
@@ -180,7 +293,10 @@ status_t wait_for_protocol_event(protocol_event_t *event)
 #endif
         return INFERENCE_SERVER_STATUS_INV_PTR;
     }
-    status = protocol_listen(event, loader_picker);
+    status = protocol_listen(event, picker);
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+    confirm_baudrate_change(status);
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
     if (KENNING_PROTOCOL_STATUS_TIMEOUT == status)
     {
         LOG_WRN("Listening timeout.");
@@ -208,8 +324,83 @@ status_t wait_for_protocol_event(protocol_event_t *event)
     return STATUS_OK;
 }
 
+status_t wait_for_protocol_event(protocol_event_t *event) { return receive_protocol_event(event, loader_picker); }
+
 ZPL_CODE_SCOPE_DEFINE(server_handle_request, TRACE_SERVER);
+/**
+ * Runs callback of the event and marks the response as successful or failed
+ *
+ * @param event event to handle
+ * @param resp response to the event, its payload is filled by the callback
+ *
+ * @returns status of the callback
+ */
+static status_t run_event_callback(protocol_event_t *event, protocol_event_t *resp)
+{
+    status_t status = STATUS_OK;
+    ZPL_MARK_CODE_SCOPE(server_handle_request)
+    {
+        resp->flags.general_purpose_flags.is_zephyr = 1;
+
+        status = g_msg_callback[event->message_type](event, &resp->payload);
+    }
+    if (STATUS_OK != status)
+    {
+        LOG_ERR("Runtime error: 0x%x (%s)", status, get_status_str(status));
+        resp->flags.general_purpose_flags.fail = 1;
+    }
+    else
+    {
+        resp->flags.general_purpose_flags.success = 1;
+    }
+    return status;
+}
+
 ZPL_CODE_SCOPE_DEFINE(server_send_response, TRACE_SERVER);
+/**
+ * Sends response to the request
+ *
+ * @param resp response to be sent
+ *
+ * @returns status of the transmission
+ */
+static status_t send_event_response(const protocol_event_t *resp)
+{
+    status_t status = STATUS_OK;
+    ZPL_MARK_CODE_SCOPE(server_send_response)
+    {
+        const char *message_type_str =
+            resp->message_type < NUM_MESSAGE_TYPES ? MESSAGE_TYPE_STR[resp->message_type] : "UNKNOWN";
+        LOG_DBG("Sending response. Size: %d, type: %lld (%s), flags: 0x%04x", resp->payload.size, resp->message_type,
+                message_type_str, resp->flags.raw_bytes);
+
+        status = protocol_transmit(resp);
+
+        if (STATUS_OK != status)
+        {
+            LOG_ERR("Error sending message: 0x%x (%s)", status, get_status_str(status));
+        }
+        else
+        {
+            LOG_DBG("Response sent");
+        }
+    }
+    return status;
+}
+
+/**
+ * Checks if the event carries model input pushed by the client in a stream session, in which case its output is sent
+ * in an OUTPUT transmission even though the event is not a request
+ *
+ * @param event handled event
+ *
+ * @returns true if the event is model input pushed in a stream session
+ */
+static bool is_stream_input(const protocol_event_t *event)
+{
+    return !event->is_request && MESSAGE_TYPE_DATA == event->message_type && stream_session_active();
+}
+
 status_t handle_protocol_event(protocol_event_t *event)
 {
     static uint8_t __attribute__((aligned(4))) resp_payload[CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE];
@@ -220,41 +411,454 @@ status_t handle_protocol_event(protocol_event_t *event)
         return INFERENCE_SERVER_STATUS_INV_PTR;
     }
     protocol_event_t resp = {.payload.size = 0, .payload.raw_bytes = resp_payload, .message_type = event->message_type};
-    ZPL_MARK_CODE_SCOPE(server_handle_request)
+
+    status = run_event_callback(event, &resp);
+    if (is_stream_input(event))
     {
-        resp.flags.general_purpose_flags.is_zephyr = 1;
+        resp.message_type = MESSAGE_TYPE_OUTPUT;
+        status = send_event_response(&resp);
+    }
+    else if (event->is_request)
+    {
+        status = send_event_response(&resp);
+    }
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+    apply_baudrate_change();
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
+    return status;
+}
+
+#ifdef CONFIG_KENNING_SERVER_PIPELINE
 
-        status = g_msg_callback[event->message_type](event, &resp.payload);
+// Number of staging buffers for model inputs and of response buffers. One buffer is filled by a thread while the
+// other one waits to be processed by the next thread.
+#define PIPELINE_BUFFER_COUNT 2
+#define PIPELINE_INPUT_BUFFER_SIZE CONFIG_KENNING_SERVER_PIPELINE_INPUT_BUFFER_SIZE
+
+/**
+ * Response passed from the compute thread to the transmit thread
+ */
+struct pipeline_response
+{
+    protocol_event_t resp;
+    bool respond;  // response to a request or output pushed in a stream session
+    bool borrowed; // payload refers to memory of the callback, compute thread waits until it is sent
+};
+
+K_THREAD_STACK_DEFINE(g_server_rx_stack, CONFIG_KENNING_SERVER_RX_THREAD_STACK_SIZE);
+K_THREAD_STACK_DEFINE(g_server_compute_stack, CONFIG_KENNING_SERVER_COMPUTE_THREAD_STACK_SIZE);
+K_THREAD_STACK_DEFINE(g_server_tx_stack, CONFIG_KENNING_SERVER_TX_THREAD_STACK_SIZE);
+static struct k_thread g_server_rx_thread;
+static struct k_thread g_server_compute_thread;
+static struct k_thread g_server_tx_thread;
+static bool g_pipeline_started = false;
+
+K_MSGQ_DEFINE(g_compute_msgq, sizeof(protocol_event_t), PIPELINE_BUFFER_COUNT, 4);
+K_MSGQ_DEFINE(g_transmit_msgq, sizeof(struct pipeline_response), PIPELINE_BUFFER_COUNT, 4);
+K_SEM_DEFINE(g_staging_free_sem, PIPELINE_BUFFER_COUNT, PIPELINE_BUFFER_COUNT);
+K_SEM_DEFINE(g_resp_free_sem, PIPELINE_BUFFER_COUNT, PIPELINE_BUFFER_COUNT);
+K_SEM_DEFINE(g_borrowed_sent_sem, 0, 1);
+K_MUTEX_DEFINE(g_pipeline_mutex);
+K_CONDVAR_DEFINE(g_pipeline_idle_condvar);
+
+static uint8_t __attribute__((aligned(4))) g_staging_payloads[PIPELINE_BUFFER_COUNT][PIPELINE_INPUT_BUFFER_SIZE];
+static struct msg_loader g_staging_ldrs[PIPELINE_BUFFER_COUNT] = {
+    MSG_LOADER_BUF(g_staging_payloads[0], PIPELINE_INPUT_BUFFER_SIZE),
+    MSG_LOADER_BUF(g_staging_payloads[1], PIPELINE_INPUT_BUFFER_SIZE),
+};
+static uint8_t __attribute__((aligned(4))) g_resp_payloads[PIPELINE_BUFFER_COUNT][CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE];
+
+// staging buffer for the next payload and whether it was already taken from the free ones, used by receive thread
+static size_t g_staging_idx = 0;
+static bool g_staging_reserved = false;
+// set by the loader picker when payload not fitting in the staging buffer is received while the pipeline is busy
+static bool g_payload_rejected = false;
+// number of received events that were not handled or responded to yet, guarded by g_pipeline_mutex
+ut_static size_t g_pending_events = 0;
+
+/**
+ * Marks the end of handling of the event and wakes up threads waiting for the pipeline to become idle
+ */
+static void finish_pipeline_event()
+{
+    k_mutex_lock(&g_pipeline_mutex, K_FOREVER);
+    g_pending_events--;
+    if (0 == g_pending_events)
+    {
+        k_condvar_broadcast(&g_pipeline_idle_condvar);
     }
-    ZPL_MARK_CODE_SCOPE(server_send_response)
+    k_mutex_unlock(&g_pipeline_mutex);
+}
+
+/**
+ * Checks if all received events are handled and responses to them are sent
+ *
+ * @returns true if the pipeline is idle
+ */
+static bool is_pipeline_idle()
+{
+    k_mutex_lock(&g_pipeline_mutex, K_FOREVER);
+    bool idle = 0 == g_pending_events;
+    k_mutex_unlock(&g_pipeline_mutex);
+    return idle;
+}
+
+/**
+ * Waits until all received events are handled and responses to them are sent
+ */
+static void wait_for_pipeline_idle()
+{
+    k_mutex_lock(&g_pipeline_mutex, K_FOREVER);
+    while (g_pending_events > 0)
     {
-        if (STATUS_OK != status)
+        k_condvar_wait(&g_pipeline_idle_condvar, &g_pipeline_mutex, K_FOREVER);
+    }
+    k_mutex_unlock(&g_pipeline_mutex);
+}
+
+/**
+ * Checks if the next message can be received while the message is still handled
+ *
+ * @param message_type type of the message
+ *
+ * @returns true if the message carries model input or no payload at all
+ */
+static bool is_pipelined_message(message_type_t message_type)
+{
+    LOADER_TYPE loader_type = MSGT_TO_LDRT(message_type);
+
+    return LOADER_TYPE_DATA == loader_type || LOADER_TYPE_NONE == loader_type;
+}
+
+/**
+ * Picks loader for the message received by the receive thread. It never waits, as the header of the message is
+ * already received and the rest of it has to be read from the link. If the pipeline is idle, the payload is received
+ * directly to its loader. Otherwise, the loader may be in use, so the payload is received to the staging buffer
+ * reserved before the message. Model and runtime uploads, as well as other payloads larger than the staging buffer,
+ * do not fit in it and are rejected.
+ *
+ * @param message_type type of the message
+ * @param payload_size size of the payload of the first message
+ *
+ * @returns loader for the payload of the message
+ */
+ut_static struct msg_loader *pipeline_loader_picker(message_type_t message_type, payload_size_t payload_size)
+{
+    LOADER_TYPE loader_type = MSGT_TO_LDRT(message_type);
+
+    if (LOADER_TYPE_NONE == loader_type || is_pipeline_idle())
+    {
+        return loader_picker(message_type, payload_size);
+    }
+    if (LOADER_TYPE_MODEL == loader_type || LOADER_TYPE_RUNTIME == loader_type ||
+        payload_size > PIPELINE_INPUT_BUFFER_SIZE)
+    {
+        LOG_WRN("%s received before previous messages are handled does not fit in the staging buffer, it is rejected",
+                MESSAGE_TYPE_STR[message_type]);
+        g_payload_rejected = true;
+        return NULL;
+    }
+    return &g_staging_ldrs[g_staging_idx];
+}
+
+/**
+ * Copies payload from the staging buffer to the loader of the message and releases the staging buffer
+ *
+ * @param event received event, its loader is replaced with the loader of the message
+ *
+ * @returns status of the loader
+ */
+ut_static status_t load_staged_payload(protocol_event_t *event)
+{
+    status_t status = STATUS_OK;
+    struct msg_loader *staging_ldr = event->payload.loader;
+    bool staged = false;
+
+    for (int i = 0; i < PIPELINE_BUFFER_COUNT; i++)
+    {
+        staged = staged || staging_ldr == &g_staging_ldrs[i];
+    }
+    if (!staged)
+    {
+        return STATUS_OK;
+    }
+
+    struct msg_loader *ldr = loader_picker(event->message_type, event->payload.size);
+
+    event->payload.loader = ldr;
+    if (event->payload.size > 0)
+    {
+        if (!IS_VALID_POINTER(ldr))
         {
-            LOG_ERR("Runtime error: 0x%x (%s)", status, get_status_str(status));
-            resp.flags.general_purpose_flags.fail = 1;
+            status = INFERENCE_SERVER_STATUS_UNINIT;
         }
         else
         {
-            resp.flags.general_purpose_flags.success = 1;
+            status = ldr->reset(ldr);
+            if (STATUS_OK == status)
+            {
+                status = ldr->save(ldr, staging_ldr->addr, event->payload.size);
+            }
         }
-        if (event->is_request)
-        {
-            const char *message_type_str =
-                resp.message_type < NUM_MESSAGE_TYPES ? MESSAGE_TYPE_STR[resp.message_type] : "UNKNOWN";
-            LOG_DBG("Sending response. Size: %d, type: %lld (%s), flags: 0x%04x", resp.payload.size, resp.message_type,
-                    message_type_str, resp.flags.raw_bytes);
+    }
+    k_sem_give(&g_staging_free_sem);
+    return status;
+}
+
+/**
+ * Checks if the data lies in the response buffer
+ *
+ * @param data checked data
+ * @param buffer response buffer of CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE bytes
+ *
+ * @returns true if the data starts in the response buffer
+ */
+static bool is_in_response_buffer(const uint8_t *data, const uint8_t *buffer)
+{
+    return data >= buffer && data < buffer + CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE;
+}
 
-            status = protocol_transmit(&resp);
+/**
+ * Copies payload of the response to the response buffer if it refers to memory of the callback (e.g. model output
+ * in the runtime memory), so that the next event can be handled while the response is sent
+ *
+ * @param payload payload of the response
+ * @param buffer response buffer of CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE bytes
+ *
+ * @returns true if the payload still refers to memory of the callback
+ */
+ut_static bool detach_response_payload(protocol_payload_t *payload, uint8_t *buffer)
+{
+    if (0 == payload->size || (PROTOCOL_PAYLOAD_TYPE_BYTES == payload->type && buffer == payload->raw_bytes))
+    {
+        return false;
+    }
+    if (payload->size > CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE)
+    {
+        return true;
+    }
+    if (PROTOCOL_PAYLOAD_TYPE_SEGMENTS == payload->type)
+    {
+        payload_size_t offset = 0;
 
-            if (STATUS_OK != status)
+        // segments referring to the response buffer (e.g. model statistics written at its beginning after the output
+        // views) are moved to their place first, so that the segments copied after them do not overwrite them
+        for (int in_buffer = 1; in_buffer >= 0; in_buffer--)
+        {
+            offset = 0;
+            for (size_t i = 0; i < payload->segment_count && offset < payload->size; i++)
             {
-                LOG_ERR("Error sending message: 0x%x (%s)", status, get_status_str(status));
+                payload_size_t size = MIN(payload->segments[i].size, payload->size - offset);
+
+                if (in_buffer == is_in_response_buffer(payload->segments[i].data, buffer))
+                {
+                    memmove(buffer + offset, payload->segments[i].data, size);
+                }
+                offset += size;
             }
-            else
+        }
+        if (offset < payload->size)
+        {
+            // invalid segments are reported by the protocol
+            return true;
+        }
+    }
+    else
+    {
+        memmove(buffer, payload->raw_bytes, payload->size);
+    }
+    payload->type = PROTOCOL_PAYLOAD_TYPE_BYTES;
+    payload->raw_bytes = buffer;
+    return false;
+}
+
+/**
+ * Sends failure response to the payload rejected by the loader picker or not fitting in the staging buffer
+ *
+ * @param event received event
+ */
+static void respond_rejected_payload(protocol_event_t *event)
+{
+    protocol_event_t resp = {.payload.size = 0, .payload.raw_bytes = NULL, .message_type = event->message_type};
+
+    resp.flags.general_purpose_flags.is_zephyr = 1;
+    resp.flags.general_purpose_flags.fail = 1;
+    if (event->is_request)
+    {
+        send_event_response(&resp);
+    }
+}
+
+/**
+ * Handles CANCEL event in the receive thread, as it cannot wait for the inference it aborts
+ *
+ * @param event received event
+ */
+static void handle_cancel_event(protocol_event_t *event)
+{
+    protocol_event_t resp = {.payload.size = 0, .payload.raw_bytes = NULL, .message_type = event->message_type};
+
+    run_event_callback(event, &resp);
+    if (event->is_request)
+    {
+        send_event_response(&resp);
+    }
+}
+
+/**
+ * Receives events and passes them to the compute thread
+ */
+static void server_rx_thread(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1)
+    {
+        protocol_event_t event;
+
+        // staging buffer is reserved before the message, so that its payload does not wait for it
+        if (!g_staging_reserved)
+        {
+            k_sem_take(&g_staging_free_sem, K_FOREVER);
+            g_staging_reserved = true;
+        }
+        g_payload_rejected = false;
+        event.payload.loader = NULL;
+        if (STATUS_OK != receive_protocol_event(&event, pipeline_loader_picker))
+        {
+            // the rest of the transmission may not fit in the staging buffer, even if the first message does, so the
+            // client is not left waiting for the response to the message it failed to stage
+            if (g_payload_rejected || (g_staging_reserved && event.payload.loader == &g_staging_ldrs[g_staging_idx]))
             {
-                LOG_DBG("Response sent");
+                respond_rejected_payload(&event);
             }
+            continue;
+        }
+        if (MESSAGE_TYPE_CANCEL == event.message_type)
+        {
+            handle_cancel_event(&event);
+            continue;
+        }
+        if (g_staging_reserved && event.payload.loader == &g_staging_ldrs[g_staging_idx])
+        {
+            // staging buffer is released by the compute thread after the payload is copied to its loader
+            g_staging_reserved = false;
+            g_staging_idx = (g_staging_idx + 1) % PIPELINE_BUFFER_COUNT;
+        }
+        k_mutex_lock(&g_pipeline_mutex, K_FOREVER);
+        g_pending_events++;
+        k_mutex_unlock(&g_pipeline_mutex);
+        k_msgq_put(&g_compute_msgq, &event, K_FOREVER);
+        if (!is_pipelined_message(event.message_type))
+        {
+            // e.g. baudrate change has to be applied before the next message is received
+            wait_for_pipeline_idle();
+        }
+    }
+}
+
+/**
+ * Handles events and passes responses to the transmit thread
+ */
+static void server_compute_thread(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    size_t resp_idx = 0;
+
+    while (1)
+    {
+        protocol_event_t event;
+        struct pipeline_response response = {0};
+
+        k_msgq_get(&g_compute_msgq, &event, K_FOREVER);
+        k_sem_take(&g_resp_free_sem, K_FOREVER);
+
+        response.resp.message_type = event.message_type;
+        response.resp.payload.raw_bytes = g_resp_payloads[resp_idx];
+        response.respond = event.is_request;
+
+        status_t status = load_staged_payload(&event);
+        if (STATUS_OK == status)
+        {
+            run_event_callback(&event, &response.resp);
+        }
+        else
+        {
+            LOG_ERR("Loading staged payload failed: 0x%x (%s)", status, get_status_str(status));
+            response.resp.flags.general_purpose_flags.is_zephyr = 1;
+            response.resp.flags.general_purpose_flags.fail = 1;
+        }
+        if (is_stream_input(&event))
+        {
+            response.resp.message_type = MESSAGE_TYPE_OUTPUT;
+            response.respond = true;
+        }
+        response.borrowed = detach_response_payload(&response.resp.payload, g_resp_payloads[resp_idx]);
+        resp_idx = (resp_idx + 1) % PIPELINE_BUFFER_COUNT;
+
+        k_msgq_put(&g_transmit_msgq, &response, K_FOREVER);
+        if (response.borrowed)
+        {
+            k_sem_take(&g_borrowed_sent_sem, K_FOREVER);
         }
     }
-    return status;
 }
+
+/**
+ * Sends responses prepared by the compute thread
+ */
+static void server_tx_thread(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1)
+    {
+        struct pipeline_response response;
+
+        k_msgq_get(&g_transmit_msgq, &response, K_FOREVER);
+        if (response.respond)
+        {
+            send_event_response(&response.resp);
+        }
+#ifdef CONFIG_KENNING_BAUDRATE_NEGOTIATION
+        apply_baudrate_change();
+#endif // CONFIG_KENNING_BAUDRATE_NEGOTIATION
+        if (response.borrowed)
+        {
+            k_sem_give(&g_borrowed_sent_sem);
+        }
+        k_sem_give(&g_resp_free_sem);
+        finish_pipeline_event();
+    }
+}
+
+status_t start_server_pipeline()
+{
+    if (g_pipeline_started)
+    {
+        RETURN_LOG_ERROR(INFERENCE_SERVER_STATUS_ERROR, "Inference server pipeline is already started");
+    }
+    k_thread_create(&g_server_tx_thread, g_server_tx_stack, K_THREAD_STACK_SIZEOF(g_server_tx_stack),
+                    server_tx_thread, NULL, NULL, NULL, CONFIG_KENNING_SERVER_TX_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&g_server_tx_thread, "kenning_tx");
+    k_thread_create(&g_server_compute_thread, g_server_compute_stack, K_THREAD_STACK_SIZEOF(g_server_compute_stack),
+                    server_compute_thread, NULL, NULL, NULL, CONFIG_KENNING_SERVER_COMPUTE_THREAD_PRIORITY, 0,
+                    K_NO_WAIT);
+    k_thread_name_set(&g_server_compute_thread, "kenning_compute");
+    k_thread_create(&g_server_rx_thread, g_server_rx_stack, K_THREAD_STACK_SIZEOF(g_server_rx_stack),
+                    server_rx_thread, NULL, NULL, NULL, CONFIG_KENNING_SERVER_RX_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&g_server_rx_thread, "kenning_rx");
+    g_pipeline_started = true;
+
+    LOG_INF("Inference server pipeline started");
+    return STATUS_OK;
+}
+
+#endif // CONFIG_KENNING_SERVER_PIPELINE
@@ -6,9 +6,15 @@
 
 #include "kenning_inference_lib/core/kenning_protocol.h"
 #include "kenning_inference_lib/core/loaders.h"
+#include <string.h>
 #include <zephyr/sys/util.h>
 
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+#include <zephyr/sys/crc.h>
+#endif
+
 #ifndef __UNIT_TEST__
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #else // __UNIT_TEST__
 #include "mocks/log.h"
@@ -32,12 +38,677 @@ GENERATE_MODULE_STATUSES_STR(KENNING_PROTOCOL);
 const char *const MESSAGE_TYPE_STR[] = {MESSAGE_TYPES(GENERATE_STR)};
 const char *const FLOW_CONTROL_STR[] = {FLOW_CONTROL_VALUES(GENERATE_STR)};
 
+#if defined(CONFIG_MULTITHREADING) && !defined(__UNIT_TEST__)
+#define TX_MULTITHREADED
+#endif
+
 /*
- Flag informing us whether the protocol is just now in progress of sending a message.
- If it is, we cannot send any other messages, because they could end up being sent
+ Flag informing us whether the transport is owned by a sender. Its owner can send many messages,
+ other messages sent in the meantime (e.g. logs of the owner thread) could end up being sent
  between header and payload of the message that is already being sent.
 */
-static bool protocol_busy = false;
+static bool g_tx_busy = false;
+
+#ifdef TX_MULTITHREADED
+// Serializes threads sending messages, e.g. receive (confirmations) and transmit threads of the inference server. The
+// mutex is recursive, so g_tx_busy still detects messages sent while sending another one from the same thread.
+K_MUTEX_DEFINE(g_protocol_send_mutex);
+// number of threads waiting to send a response, queued transmissions are not sent until they are done
+static atomic_t g_responses_waiting = ATOMIC_INIT(0);
+#endif // TX_MULTITHREADED
+
+/**
+ * Priority classes of transmissions, lower value means higher priority
+ */
+typedef enum
+{
+    TX_PRIORITY_RESPONSE = 0,
+    TX_PRIORITY_LOGS,
+    TX_PRIORITY_TRACES,
+    NUM_TX_PRIORITIES
+} TX_PRIORITY;
+
+/*
+ Logs and traces are copied to the queue of their priority class, so their producers never wait
+ for the transport. Queued transmissions are sent by the owner of the transport before releasing
+ it, in order of priority classes, unless a response is waiting for the transport. Each queue is
+ filled from the start of its buffer and reset when all of its transmissions are sent.
+*/
+#define NUM_TX_QUEUES (NUM_TX_PRIORITIES - TX_PRIORITY_LOGS)
+
+struct tx_queue_entry
+{
+    message_type_t message_type;
+    flags_t flags;
+    payload_size_t size;
+    uint8_t data[];
+};
+
+// entries are aligned to 8 bytes, as message_type_t is 64-bit
+#define TX_QUEUE_ENTRY_SIZE(payload_size) ROUND_UP(sizeof(struct tx_queue_entry) + (payload_size), 8)
+
+struct tx_queue
+{
+    uint8_t __attribute__((aligned(8))) buffer[CONFIG_KENNING_PROTOCOL_TX_QUEUE_SIZE];
+    size_t used; // bytes taken by queued entries
+    size_t sent; // bytes taken by entries that were already sent
+};
+
+static struct tx_queue g_tx_queues[NUM_TX_QUEUES];
+
+#ifndef __UNIT_TEST__
+// queues are filled from any context, including interrupts
+static struct k_spinlock g_tx_queue_lock;
+#define TX_QUEUE_LOCK(key) k_spinlock_key_t key = k_spin_lock(&g_tx_queue_lock)
+#define TX_QUEUE_UNLOCK(key) k_spin_unlock(&g_tx_queue_lock, key)
+#else // __UNIT_TEST__
+#define TX_QUEUE_LOCK(key)
+#define TX_QUEUE_UNLOCK(key)
+#endif // __UNIT_TEST__
+
+static status_t send_event_messages(const protocol_event_t *event);
+
+/*
+ MODEL or RUNTIME transmission interrupted by a receive error. Its loader is not reset until
+ the next transmission without the resume flag, so the upload can be continued from the offset.
+*/
+static struct
+{
+    bool active;
+    message_type_t message_type;
+    bool compressed;
+    bool patch;
+    size_t offset;
+} g_interrupted_upload = {.active = false};
+
+/*
+ MODEL transmission that did not complete leaves partial model in the model loader, so patches are rejected until a
+ whole model is received.
+*/
+static bool g_model_incomplete = false;
+
+/**
+ * Returns priority class of the transmission
+ *
+ * @param message_type type of the transmission
+ *
+ * @returns priority class
+ */
+static TX_PRIORITY get_tx_priority(message_type_t message_type)
+{
+    switch (message_type)
+    {
+    case MESSAGE_TYPE_LOGS:
+        return TX_PRIORITY_LOGS;
+    case MESSAGE_TYPE_TRACE_DATA:
+        return TX_PRIORITY_TRACES;
+    default:
+        return TX_PRIORITY_RESPONSE;
+    }
+}
+
+/**
+ * Copies the transmission to the queue of its priority class
+ *
+ * @param priority priority class of the transmission
+ * @param event transmission with payload of PROTOCOL_PAYLOAD_TYPE_BYTES type
+ *
+ * @returns status of the protocol, KENNING_PROTOCOL_STATUS_BUSY if the queue is full
+ */
+static status_t tx_queue_put(TX_PRIORITY priority, const protocol_event_t *event)
+{
+    status_t status = KENNING_PROTOCOL_STATUS_BUSY;
+    struct tx_queue *queue = &g_tx_queues[priority - TX_PRIORITY_LOGS];
+    size_t entry_size = TX_QUEUE_ENTRY_SIZE(event->payload.size);
+
+    TX_QUEUE_LOCK(key);
+    if (queue->used + entry_size <= sizeof(queue->buffer))
+    {
+        struct tx_queue_entry *entry = (struct tx_queue_entry *)(queue->buffer + queue->used);
+        entry->message_type = event->message_type;
+        entry->flags = event->flags;
+        entry->size = event->payload.size;
+        memcpy(entry->data, event->payload.raw_bytes, event->payload.size);
+        queue->used += entry_size;
+        status = STATUS_OK;
+    }
+    TX_QUEUE_UNLOCK(key);
+    return status;
+}
+
+/**
+ * Checks if queued transmissions can be sent, i.e. any is queued and no response waits for the transport
+ *
+ * @returns true if queued transmissions can be sent
+ */
+static bool tx_queue_ready()
+{
+    bool ready = false;
+#ifdef TX_MULTITHREADED
+    if (0 != atomic_get(&g_responses_waiting))
+    {
+        return false;
+    }
+#endif // TX_MULTITHREADED
+    TX_QUEUE_LOCK(key);
+    for (int i = 0; i < NUM_TX_QUEUES; i++)
+    {
+        ready = ready || g_tx_queues[i].sent < g_tx_queues[i].used;
+    }
+    TX_QUEUE_UNLOCK(key);
+    return ready;
+}
+
+/**
+ * Sends the first queued transmission of the highest priority class. Has to be called by the owner of the transport.
+ *
+ * @returns true if a transmission was sent
+ */
+static bool tx_queue_send_next()
+{
+    if (!tx_queue_ready())
+    {
+        return false;
+    }
+    for (int i = 0; i < NUM_TX_QUEUES; i++)
+    {
+        struct tx_queue *queue = &g_tx_queues[i];
+        struct tx_queue_entry *entry = NULL;
+        protocol_event_t event;
+
+        TX_QUEUE_LOCK(key);
+        if (queue->sent < queue->used)
+        {
+            entry = (struct tx_queue_entry *)(queue->buffer + queue->sent);
+        }
+        TX_QUEUE_UNLOCK(key);
+        if (NULL == entry)
+        {
+            continue;
+        }
+        // entries are not modified until they are sent, only new ones are appended
+        event.message_type = entry->message_type;
+        event.flags = entry->flags;
+        event.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
+        event.payload.raw_bytes = entry->data;
+        event.payload.size = entry->size;
+        // transmission that failed is dropped, its producer has already moved on
+        (void)send_event_messages(&event);
+
+        TX_QUEUE_LOCK(key2);
+        queue->sent += TX_QUEUE_ENTRY_SIZE(entry->size);
+        if (queue->sent == queue->used)
+        {
+            queue->sent = 0;
+            queue->used = 0;
+        }
+        TX_QUEUE_UNLOCK(key2);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Acquires the transport for sending messages
+ *
+ * @param wait whether to wait for messages sent by other threads
+ *
+ * @returns status of the protocol
+ */
+static status_t protocol_send_lock(bool wait)
+{
+#ifdef TX_MULTITHREADED
+    int ret = 0;
+    // mutex cannot be taken in interrupt context, e.g. by logs
+    if (k_is_in_isr())
+    {
+        return KENNING_PROTOCOL_STATUS_BUSY;
+    }
+    if (wait)
+    {
+        atomic_inc(&g_responses_waiting);
+    }
+    ret = k_mutex_lock(&g_protocol_send_mutex, wait ? K_FOREVER : K_NO_WAIT);
+    if (wait)
+    {
+        atomic_dec(&g_responses_waiting);
+    }
+    if (0 != ret)
+    {
+        return KENNING_PROTOCOL_STATUS_BUSY;
+    }
+#endif // TX_MULTITHREADED
+    if (g_tx_busy)
+    {
+#ifdef TX_MULTITHREADED
+        k_mutex_unlock(&g_protocol_send_mutex);
+#endif // TX_MULTITHREADED
+        return KENNING_PROTOCOL_STATUS_BUSY;
+    }
+    g_tx_busy = true;
+    return STATUS_OK;
+}
+
+/**
+ * Sends queued transmissions and releases the transport acquired with protocol_send_lock
+ */
+static void protocol_send_unlock()
+{
+    // transmissions queued by other threads while the transport was being released would not be sent by their
+    // producers, so the queue is checked once more after releasing it
+    do
+    {
+        while (tx_queue_send_next())
+        {
+        }
+        g_tx_busy = false;
+#ifdef TX_MULTITHREADED
+        k_mutex_unlock(&g_protocol_send_mutex);
+#endif // TX_MULTITHREADED
+    } while (tx_queue_ready() && STATUS_OK == protocol_send_lock(false));
+}
+
+#ifdef CONFIG_KENNING_PROTOCOL_FRAMING
+
+/*
+ Messages are encoded with COBS (Consistent Overhead Byte Stuffing) and each frame is terminated
+ with a delimiter. Encoded data consists of blocks, each starting with a code byte equal to the
+ number of data bytes in the block plus one. Every block shorter than FRAME_MAX_BLOCK_SIZE is
+ followed by a zero byte in decoded data, except for the last block in the frame. As zero bytes
+ are never present in encoded data, receiver can find the start of the next frame right away.
+*/
+#define FRAME_DELIMITER (0x00)
+#define FRAME_MAX_BLOCK_SIZE (0xFE)
+
+/**
+ * State of the received frame
+ */
+struct frame_decoder
+{
+    uint8_t block_remaining; // number of data bytes left in the current block
+    bool zero_pending;       // whether the current block is followed by zero byte, if it is not the last one
+    bool in_frame;           // whether the delimiter of the current frame was not received yet
+    // bytes that follow an unexpected delimiter, they belong to the next frame and are read before new data
+    uint8_t pushback[FRAME_MAX_BLOCK_SIZE];
+    size_t pushback_length;
+    size_t pushback_offset;
+    bool last_read_pushed_back; // whether the last raw read returned pushed back bytes
+};
+
+static struct frame_decoder g_frame_decoder;
+
+// block of the sent frame that is currently encoded, first byte is reserved for the code
+static uint8_t g_frame_block[FRAME_MAX_BLOCK_SIZE + 1];
+static size_t g_frame_block_length = 0;
+
+/**
+ * Reads encoded bytes, returns bytes pushed back by the decoder first
+ *
+ * @param data buffer for read data
+ * @param data_length maximum number of bytes to read, set to the number of read bytes
+ *
+ * @returns status of the lower layer
+ */
+static status_t frame_read_raw(uint8_t *data, size_t *data_length)
+{
+    size_t pushed_back = g_frame_decoder.pushback_length - g_frame_decoder.pushback_offset;
+
+    g_frame_decoder.last_read_pushed_back = pushed_back > 0;
+    if (pushed_back > 0)
+    {
+        *data_length = MIN(*data_length, pushed_back);
+        memcpy(data, g_frame_decoder.pushback + g_frame_decoder.pushback_offset, *data_length);
+        g_frame_decoder.pushback_offset += *data_length;
+        return STATUS_OK;
+    }
+    return protocol_read_data(data, *data_length);
+}
+
+/**
+ * Marks the current frame as finished
+ *
+ * @param next bytes read after the delimiter, they are returned by subsequent reads
+ * @param next_length number of bytes read after the delimiter
+ */
+static void frame_finish(const uint8_t *next, size_t next_length)
+{
+    if (g_frame_decoder.last_read_pushed_back)
+    {
+        // bytes were taken from the pushback buffer, so they are still there
+        g_frame_decoder.pushback_offset -= next_length;
+    }
+    else if (next_length > 0)
+    {
+        memcpy(g_frame_decoder.pushback, next, next_length);
+        g_frame_decoder.pushback_length = next_length;
+        g_frame_decoder.pushback_offset = 0;
+    }
+    g_frame_decoder.block_remaining = 0;
+    g_frame_decoder.zero_pending = false;
+    g_frame_decoder.in_frame = false;
+}
+
+/**
+ * Reads and decodes data of the received frame. Empty frames preceding the data are skipped.
+ *
+ * @param data buffer for decoded data
+ * @param data_length number of decoded bytes to read
+ *
+ * @returns status of the protocol
+ */
+static status_t frame_read(uint8_t *data, size_t data_length)
+{
+    status_t status = STATUS_OK;
+
+    while (data_length > 0)
+    {
+        if (0 == g_frame_decoder.block_remaining)
+        {
+            uint8_t code = 0;
+            size_t code_length = sizeof(code);
+
+            status = frame_read_raw(&code, &code_length);
+            CHECK_PROTOCOL_STATUS(status);
+            if (FRAME_DELIMITER == code)
+            {
+                bool in_frame = g_frame_decoder.in_frame;
+                frame_finish(NULL, 0);
+                if (in_frame)
+                {
+                    LOG_ERR("Frame too short");
+                    return KENNING_PROTOCOL_STATUS_FRAMING_ERROR;
+                }
+                continue;
+            }
+            g_frame_decoder.in_frame = true;
+            if (g_frame_decoder.zero_pending)
+            {
+                *data++ = 0;
+                data_length--;
+            }
+            g_frame_decoder.block_remaining = code - 1;
+            g_frame_decoder.zero_pending = code <= FRAME_MAX_BLOCK_SIZE;
+            continue;
+        }
+
+        size_t to_read = MIN(data_length, g_frame_decoder.block_remaining);
+
+        status = frame_read_raw(data, &to_read);
+        CHECK_PROTOCOL_STATUS(status);
+
+        const uint8_t *delimiter = memchr(data, FRAME_DELIMITER, to_read);
+        if (IS_VALID_POINTER(delimiter))
+        {
+            // the frame was cut short, e.g. by lost bytes, the rest of data belongs to the next frame
+            frame_finish(delimiter + 1, data + to_read - delimiter - 1);
+            LOG_ERR("Frame too short");
+            return KENNING_PROTOCOL_STATUS_FRAMING_ERROR;
+        }
+        g_frame_decoder.block_remaining -= to_read;
+        data_length -= to_read;
+        data += to_read;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Discards received data up to the end of the current frame
+ *
+ * @returns status of the protocol
+ */
+static status_t frame_resync()
+{
+    status_t status = STATUS_OK;
+
+    while (g_frame_decoder.in_frame)
+    {
+        uint8_t byte = 0;
+        size_t byte_length = sizeof(byte);
+
+        status = frame_read_raw(&byte, &byte_length);
+        CHECK_PROTOCOL_STATUS(status);
+        if (FRAME_DELIMITER == byte)
+        {
+            frame_finish(NULL, 0);
+        }
+    }
+    return status;
+}
+
+/**
+ * Receives the end of the current frame, discards the rest of the frame if it contains more data
+ *
+ * @returns status of the protocol
+ */
+static status_t frame_read_end()
+{
+    status_t status = STATUS_OK;
+    uint8_t code = 0;
+    size_t code_length = sizeof(code);
+
+    if (0 == g_frame_decoder.block_remaining)
+    {
+        status = frame_read_raw(&code, &code_length);
+        CHECK_PROTOCOL_STATUS(status);
+        // empty block after a full one does not add any data
+        if (0x01 == code && !g_frame_decoder.zero_pending)
+        {
+            status = frame_read_raw(&code, &code_length);
+            CHECK_PROTOCOL_STATUS(status);
+        }
+        if (FRAME_DELIMITER == code)
+        {
+            frame_finish(NULL, 0);
+            return STATUS_OK;
+        }
+    }
+    LOG_ERR("Frame too long");
+    status = frame_resync();
+    RETURN_ON_ERROR(status, status);
+    return KENNING_PROTOCOL_STATUS_FRAMING_ERROR;
+}
+
+/**
+ * Sends the current block of the encoded frame
+ *
+ * @returns status of the protocol
+ */
+static status_t frame_write_block()
+{
+    status_t status = STATUS_OK;
+
+    g_frame_block[0] = g_frame_block_length + 1;
+    status = protocol_write_data(g_frame_block, g_frame_block_length + 1);
+    g_frame_block_length = 0;
+    CHECK_PROTOCOL_STATUS(status);
+    return status;
+}
+
+/**
+ * Encodes and sends data of the current frame
+ *
+ * @param data data to be sent
+ * @param data_length size of the data
+ *
+ * @returns status of the protocol
+ */
+static status_t frame_write(const uint8_t *data, size_t data_length)
+{
+    status_t status = STATUS_OK;
+
+    while (data_length > 0)
+    {
+        // full block is sent only when more data follows, so that it is not followed by an empty block
+        if (FRAME_MAX_BLOCK_SIZE == g_frame_block_length)
+        {
+            status = frame_write_block();
+            RETURN_ON_ERROR(status, status);
+        }
+        size_t chunk_size = MIN(data_length, FRAME_MAX_BLOCK_SIZE - g_frame_block_length);
+        const uint8_t *delimiter = memchr(data, FRAME_DELIMITER, chunk_size);
+
+        if (IS_VALID_POINTER(delimiter))
+        {
+            chunk_size = delimiter - data;
+        }
+        memcpy(g_frame_block + 1 + g_frame_block_length, data, chunk_size);
+        g_frame_block_length += chunk_size;
+        data += chunk_size;
+        data_length -= chunk_size;
+
+        if (IS_VALID_POINTER(delimiter))
+        {
+            // zero byte is encoded in the code of the block
+            status = frame_write_block();
+            RETURN_ON_ERROR(status, status);
+            data++;
+            data_length--;
+        }
+    }
+    return status;
+}
+
+/**
+ * Sends the last block and the delimiter of the current frame
+ *
+ * @returns status of the protocol
+ */
+static status_t frame_write_end()
+{
+    static const uint8_t delimiter = FRAME_DELIMITER;
+    status_t status = STATUS_OK;
+
+    status = frame_write_block();
+    RETURN_ON_ERROR(status, status);
+
+    status = protocol_write_data(&delimiter, sizeof(delimiter));
+    CHECK_PROTOCOL_STATUS(status);
+    return status;
+}
+
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
+
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+
+#define CHECKSUM_INIT (0xFF)
+
+status_t send_message(const outgoing_message_t *msg);
+
+/**
+ * Computes checksum of the message header, checksum field of the header is treated as zero
+ *
+ * @param header message header
+ *
+ * @returns checksum of the header, to be updated with the payload
+ */
+static checksum_t header_checksum(const message_hdr_t *header)
+{
+    message_hdr_t hdr = *header;
+
+    hdr.checksum = 0;
+    return crc8_ccitt(CHECKSUM_INIT, &hdr, sizeof(message_hdr_t));
+}
+
+/**
+ * Sends message without payload confirming reception of a message
+ *
+ * @param message_type type of the received message
+ * @param flow_control_flags FLOW_CONTROL_ACKNOWLEDGE or FLOW_CONTROL_REQUEST_RETRANSMIT
+ *
+ * @returns status of the protocol
+ */
+static status_t send_confirmation(message_type_t message_type, flow_control_flags_t flow_control_flags)
+{
+    status_t status = STATUS_OK;
+    outgoing_message_t msg;
+
+    memset(&msg.hdr, 0, sizeof(message_hdr_t));
+    msg.hdr.message_type = message_type;
+    msg.hdr.flow_control_flags = flow_control_flags;
+    msg.hdr.flags.general_purpose_flags.first = 1;
+    msg.hdr.flags.general_purpose_flags.last = 1;
+    msg.payload = NULL;
+
+    status = protocol_send_lock(true);
+    RETURN_ON_ERROR(status, status);
+    status = send_message(&msg);
+    protocol_send_unlock();
+    return status;
+}
+
+/**
+ * Drops payload of the corrupted message from the loader and requests its retransmission
+ *
+ * @param ldr loader for message payload
+ * @param message_type type of the corrupted message
+ * @param written number of bytes written to the loader before the corrupted message
+ * @param retransmissions number of consecutive retransmissions of the message, incremented by the function
+ *
+ * @returns status of the protocol
+ */
+static status_t request_retransmission(struct msg_loader *ldr, message_type_t message_type, size_t written,
+                                       int *retransmissions)
+{
+    if (*retransmissions >= CONFIG_KENNING_PROTOCOL_MAX_RETRANSMISSIONS)
+    {
+        LOG_ERR("Message corrupted %d times in a row", *retransmissions + 1);
+        return KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR;
+    }
+    if (!IS_VALID_POINTER(ldr->rewind) || ldr->rewind(ldr, written))
+    {
+        LOG_ERR("Loader cannot drop corrupted data");
+        return KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR;
+    }
+    (*retransmissions)++;
+    LOG_WRN("Message corrupted, requesting retransmission");
+    return send_confirmation(message_type, FLOW_CONTROL_REQUEST_RETRANSMIT);
+}
+
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+
+/**
+ * Discards payload of the received message
+ *
+ * @param header header of the message
+ */
+static void discard_message_payload(const message_hdr_t *header)
+{
+#ifdef CONFIG_KENNING_PROTOCOL_FRAMING
+    // the rest of the frame is dropped regardless of the declared payload size
+    ARG_UNUSED(header);
+    frame_resync();
+#else  // CONFIG_KENNING_PROTOCOL_FRAMING
+    protocol_read_data(NULL, header->payload_size);
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
+}
+
+/**
+ * Discards payload of the first message of a transmission, unless it was already received
+ *
+ * @param header header of the message
+ * @param received whether the payload was already received, e.g. to verify the message
+ */
+static void discard_first_message_payload(const message_hdr_t *header, bool received)
+{
+    if (!received)
+    {
+        discard_message_payload(header);
+    }
+}
+
+/**
+ * Receives the end of the message, if messages are framed
+ *
+ * @returns status of the protocol
+ */
+static status_t receive_message_end()
+{
+#ifdef CONFIG_KENNING_PROTOCOL_FRAMING
+    return frame_read_end();
+#else  // CONFIG_KENNING_PROTOCOL_FRAMING
+    return STATUS_OK;
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
+}
 
 /**
  * Receives a single message header.
@@ -52,20 +723,80 @@ status_t receive_message_header(message_hdr_t *header)
 
     RETURN_ERROR_IF_POINTER_INVALID(header, KENNING_PROTOCOL_STATUS_INV_PTR);
 
+#ifdef CONFIG_KENNING_PROTOCOL_FRAMING
+    // drop the rest of the frame in which an error occurred, the header starts after its delimiter
+    status = frame_resync();
+    RETURN_ON_ERROR(status, status);
+
+    status = frame_read((uint8_t *)header, sizeof(message_hdr_t));
+    RETURN_ON_ERROR(status, status);
+#else  // CONFIG_KENNING_PROTOCOL_FRAMING
     status = protocol_read_data((uint8_t *)header, sizeof(message_hdr_t));
     CHECK_PROTOCOL_STATUS(status);
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
+    return status;
+}
+
+#ifndef CONFIG_KENNING_PROTOCOL_FRAMING
+/**
+ * Checks whether data leased from the transport can be passed to a loader. Loaders may access the data in words,
+ * so the data has to be word aligned and, unless it is the end of the payload, its size has to be a multiple of word
+ * size.
+ *
+ * @param data leased data
+ * @param data_length size of the leased data, rounded down to a multiple of word size if needed
+ * @param remaining number of payload bytes that are yet to be received
+ *
+ * @returns true if the leased data can be passed to a loader
+ */
+static bool lease_usable_by_loader(const uint8_t *data, size_t *data_length, size_t remaining)
+{
+    if (0 != (uintptr_t)data % sizeof(uint32_t))
+    {
+        return false;
+    }
+    if (*data_length < remaining)
+    {
+        *data_length -= *data_length % sizeof(uint32_t);
+    }
+    return *data_length > 0;
+}
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
+
+/**
+ * Reads payload data from the transport to the given buffer, decoding it if framing is enabled.
+ *
+ * @param data buffer for the data.
+ * @param data_length number of bytes to read.
+ *
+ * @returns status of the protocol
+ */
+static status_t read_payload_data(uint8_t *data, size_t data_length)
+{
+    status_t status = STATUS_OK;
+
+#ifdef CONFIG_KENNING_PROTOCOL_FRAMING
+    status = frame_read(data, data_length);
+#else  // CONFIG_KENNING_PROTOCOL_FRAMING
+    status = protocol_read_data(data, data_length);
+    CHECK_PROTOCOL_STATUS(status);
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
     return status;
 }
 
 /**
  * Receives a single message payload of a given size,
  *
+ * If the loader provides a write window, the payload is read directly to the loader memory. Otherwise it is passed
+ * to the loader either straight from the transport or through the receive buffer.
+ *
  * @param ldr loader for the payload.
  * @param n size of the payload in bytes.
+ * @param checksum checksum of the message, updated with the payload if checksums are enabled.
  *
  * @returns status of the protocol
  */
-status_t receive_message_payload(struct msg_loader *ldr, size_t n)
+status_t receive_message_payload(struct msg_loader *ldr, size_t n, checksum_t *checksum)
 {
     static uint8_t __attribute__((aligned(4))) msg_recv_buffer[CONFIG_KENNING_MESSAGE_RECV_BUFFER_SIZE];
     status_t status = STATUS_OK;
@@ -75,14 +806,61 @@ status_t receive_message_payload(struct msg_loader *ldr, size_t n)
 
     while (n)
     {
-        int to_read = (buffer_size > n) ? n : buffer_size;
-        status = protocol_read_data(msg_recv_buffer, to_read);
+        const uint8_t *data = NULL;
+        uint8_t *window = NULL;
+        size_t to_read = 0;
+        bool leased = false;
 
-        CHECK_PROTOCOL_STATUS(status);
-        if (ldr->save(ldr, msg_recv_buffer, to_read))
+        if (IS_VALID_POINTER(ldr->lease_window) && IS_VALID_POINTER(ldr->commit_window) &&
+            STATUS_OK == ldr->lease_window(ldr, &window, &to_read))
+        {
+            // the transport writes directly to the loader memory
+            to_read = MIN(to_read, n);
+            data = window;
+            status = read_payload_data(window, to_read);
+            RETURN_ON_ERROR(status, status);
+        }
+        else
+        {
+            window = NULL;
+#ifndef CONFIG_KENNING_PROTOCOL_FRAMING
+            // use data stored in the transport directly if possible to avoid copying it to the buffer, framed data
+            // has to be decoded, so it is always copied
+            status = protocol_lease(&data, n, &to_read);
+            if (STATUS_OK == status)
+            {
+                leased = lease_usable_by_loader(data, &to_read, n);
+                if (!leased)
+                {
+                    protocol_release(0);
+                }
+            }
+            else if (PROTOCOL_STATUS_NOT_SUPPORTED != status)
+            {
+                CHECK_PROTOCOL_STATUS(status);
+            }
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
+
+            if (!leased)
+            {
+                to_read = (buffer_size > n) ? n : buffer_size;
+                data = msg_recv_buffer;
+                status = read_payload_data(msg_recv_buffer, to_read);
+                RETURN_ON_ERROR(status, status);
+            }
+        }
+
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+        *checksum = crc8_ccitt(*checksum, data, to_read);
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+        if (IS_VALID_POINTER(window) ? ldr->commit_window(ldr, to_read) : ldr->save(ldr, data, to_read))
         {
             status = KENNING_PROTOCOL_STATUS_MSG_TOO_BIG;
         }
+        if (leased)
+        {
+            protocol_release(to_read);
+        }
         n -= to_read;
     }
     return status;
@@ -90,46 +868,88 @@ status_t receive_message_payload(struct msg_loader *ldr, size_t n)
 
 /**
  * Receives a series of messages, assuming that the header of the first message
- * has already been received and passed as argument.
+ * has already been received and passed as argument. If checksums are enabled,
+ * each message is confirmed and corrupted messages are received again.
  *
  * @param ldr loader for message payload.
  * @param header received header of the first message.
+ * @param first_received whether the whole first message was already received and
+ * confirmed, in which case reception starts from the header of the next message.
  *
  * @returns status of the protocol
  */
 ZPL_CODE_SCOPE_DEFINE(protocol_receive_header, TRACE_MESSAGES);
 ZPL_CODE_SCOPE_DEFINE(protocol_receive_payload, TRACE_MESSAGES);
-status_t receive_messages(struct msg_loader *ldr, message_hdr_t *header)
+status_t receive_messages(struct msg_loader *ldr, message_hdr_t *header, bool first_received)
 {
     status_t status = STATUS_OK;
     message_type_t message_type = header->message_type;
     flow_control_flags_t flow_control_flags = header->flow_control_flags;
-    for (int i = 0;; i++)
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+    int retransmissions = 0;
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+    for (int i = first_received ? 1 : 0;; i++)
     {
+        checksum_t checksum = 0;
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+        // data saved before the message, restored if the message has to be retransmitted
+        size_t written = ldr->written;
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+
         // Header of the first message should already be received before this function is called.
         if (i != 0)
         {
             ZPL_MARK_CODE_SCOPE(protocol_receive_header) { status = receive_message_header(header); }
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+            if (KENNING_PROTOCOL_STATUS_FRAMING_ERROR == status)
+            {
+                status = request_retransmission(ldr, message_type, written, &retransmissions);
+                RETURN_ON_ERROR(status, status);
+                continue;
+            }
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
             RETURN_ON_ERROR(status, status);
             if (header->message_type != message_type)
             {
-                protocol_read_data(NULL, header->payload_size);
+                discard_message_payload(header);
                 return KENNING_PROTOCOL_STATUS_INVALID_MESSAGE_TYPE;
             }
             if (header->flow_control_flags != flow_control_flags)
             {
-                protocol_read_data(NULL, header->payload_size);
+                discard_message_payload(header);
                 return KENNING_PROTOCOL_STATUS_FLOW_CONTROL_ERROR;
             }
         }
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+        checksum = header_checksum(header);
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
         if (header->flags.general_purpose_flags.has_payload)
         {
             ZPL_MARK_CODE_SCOPE(protocol_receive_payload)
             {
-                status = receive_message_payload(ldr, header->payload_size);
+                status = receive_message_payload(ldr, header->payload_size, &checksum);
             }
+        }
+        if (STATUS_OK == status)
+        {
+            status = receive_message_end();
+        }
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+        if (STATUS_OK == status && checksum != header->checksum)
+        {
+            status = KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR;
+        }
+        if (KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR == status || KENNING_PROTOCOL_STATUS_FRAMING_ERROR == status)
+        {
+            status = request_retransmission(ldr, message_type, written, &retransmissions);
             RETURN_ON_ERROR(status, status);
+            continue;
         }
+        RETURN_ON_ERROR(status, status);
+        status = send_confirmation(message_type, FLOW_CONTROL_ACKNOWLEDGE);
+        retransmissions = 0;
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+        RETURN_ON_ERROR(status, status);
         if (header->flags.general_purpose_flags.last)
         {
             return status;
@@ -137,6 +957,135 @@ status_t receive_messages(struct msg_loader *ldr, message_hdr_t *header)
     }
 }
 
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+
+static uint8_t __attribute__((aligned(4))) g_staging_buffer[CONFIG_KENNING_MESSAGE_RECV_BUFFER_SIZE];
+
+/**
+ * Keeps payload in the staging buffer, payload that does not fit is only counted
+ */
+static status_t staging_save(struct msg_loader *ldr, const uint8_t *src, size_t n)
+{
+    if (ldr->written + n <= ldr->max_size)
+    {
+        memcpy((uint8_t *)ldr->addr + ldr->written, src, n);
+    }
+    ldr->written += n;
+    return STATUS_OK;
+}
+
+static status_t staging_rewind(struct msg_loader *ldr, size_t written)
+{
+    ldr->written = written;
+    return STATUS_OK;
+}
+
+static struct msg_loader g_staging_ldr = {.save = staging_save,
+                                          .rewind = staging_rewind,
+                                          .written = 0,
+                                          .max_size = sizeof(g_staging_buffer),
+                                          .addr = g_staging_buffer};
+
+/**
+ * Receives the first message of a transmission and verifies its checksum, so that its header can be trusted before
+ * a loader is picked and reset. Payload that fits in the staging buffer is kept there. Larger payload is dropped and,
+ * once the message is verified, the message is requested again to be received straight by the loader.
+ *
+ * @param header received header of the first message, replaced with the header of the retransmitted message
+ * @param staged set if the payload of the message is kept in the staging loader
+ *
+ * @returns status of the protocol
+ */
+static status_t receive_first_message(message_hdr_t *header, bool *staged)
+{
+    status_t status = STATUS_OK;
+    int retransmissions = 0;
+
+    *staged = false;
+    while (true)
+    {
+        checksum_t checksum = header_checksum(header);
+        bool has_payload = header->flags.general_purpose_flags.has_payload;
+
+        g_staging_ldr.written = 0;
+        if (has_payload)
+        {
+            status = receive_message_payload(&g_staging_ldr, header->payload_size, &checksum);
+        }
+        if (STATUS_OK == status)
+        {
+            status = receive_message_end();
+        }
+        if (STATUS_OK == status && checksum != header->checksum)
+        {
+            LOG_ERR("Invalid checksum of message type %llu", (message_type_t)header->message_type);
+            status = KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR;
+        }
+        if (!has_payload)
+        {
+            // messages without payload are not confirmed, so they cannot be requested again
+            return status;
+        }
+        if (STATUS_OK == status)
+        {
+            *staged = g_staging_ldr.written <= g_staging_ldr.max_size;
+            if (*staged)
+            {
+                return STATUS_OK;
+            }
+            message_hdr_t verified = *header;
+
+            status = send_confirmation(header->message_type, FLOW_CONTROL_REQUEST_RETRANSMIT);
+            RETURN_ON_ERROR(status, status);
+            status = receive_message_header(header);
+            if (STATUS_OK == status)
+            {
+                if (0 == memcmp(&verified, header, sizeof(message_hdr_t)))
+                {
+                    return STATUS_OK;
+                }
+                // retransmitted header differs from the verified one, so it has to be verified again
+                continue;
+            }
+        }
+        if (KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR != status && KENNING_PROTOCOL_STATUS_FRAMING_ERROR != status)
+        {
+            return status;
+        }
+        status = request_retransmission(&g_staging_ldr, header->message_type, 0, &retransmissions);
+        RETURN_ON_ERROR(status, status);
+        status = receive_message_header(header);
+        RETURN_ON_ERROR(status, status);
+    }
+}
+
+/**
+ * Passes the staged payload of the first message to the loader and receives the rest of the transmission
+ *
+ * @param ldr loader for message payload
+ * @param header header of the first message
+ *
+ * @returns status of the protocol
+ */
+static status_t receive_staged_messages(struct msg_loader *ldr, message_hdr_t *header)
+{
+    status_t status = STATUS_OK;
+
+    if (ldr->save(ldr, g_staging_buffer, g_staging_ldr.written))
+    {
+        return KENNING_PROTOCOL_STATUS_MSG_TOO_BIG;
+    }
+    status = send_confirmation(header->message_type, FLOW_CONTROL_ACKNOWLEDGE);
+    RETURN_ON_ERROR(status, status);
+    if (header->flags.general_purpose_flags.last)
+    {
+        return status;
+    }
+    return receive_messages(ldr, header, true);
+}
+
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+
 /**
  * Sends given message
  *
@@ -150,7 +1099,30 @@ status_t send_message(const outgoing_message_t *msg)
 
     RETURN_ERROR_IF_POINTER_INVALID(msg, KENNING_PROTOCOL_STATUS_INV_PTR);
 
-    status = protocol_write_data((uint8_t *)(&msg->hdr), sizeof(message_hdr_t));
+    message_hdr_t hdr = msg->hdr;
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+    hdr.checksum = header_checksum(&hdr);
+    if (hdr.flags.general_purpose_flags.has_payload)
+    {
+        hdr.checksum = crc8_ccitt(hdr.checksum, msg->payload, hdr.payload_size);
+    }
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+
+#ifdef CONFIG_KENNING_PROTOCOL_FRAMING
+    // drop data left by a frame that failed to be sent
+    g_frame_block_length = 0;
+
+    status = frame_write((uint8_t *)(&hdr), sizeof(message_hdr_t));
+    RETURN_ON_ERROR(status, status);
+
+    if (msg->hdr.flags.general_purpose_flags.has_payload)
+    {
+        status = frame_write(msg->payload, msg->hdr.payload_size);
+        RETURN_ON_ERROR(status, status);
+    }
+    status = frame_write_end();
+#else  // CONFIG_KENNING_PROTOCOL_FRAMING
+    status = protocol_write_data((uint8_t *)(&hdr), sizeof(message_hdr_t));
     CHECK_PROTOCOL_STATUS(status);
 
     if (msg->hdr.flags.general_purpose_flags.has_payload)
@@ -158,54 +1130,142 @@ status_t send_message(const outgoing_message_t *msg)
         status = protocol_write_data(msg->payload, msg->hdr.payload_size);
         CHECK_PROTOCOL_STATUS(status);
     }
+#endif // CONFIG_KENNING_PROTOCOL_FRAMING
     return status;
 }
 
-ZPL_CODE_SCOPE_DEFINE(kenning_protocol_transmit, TRACE_PROTOCOL);
+/**
+ * Position of the next data to be sent in the transmitted payload
+ */
+struct payload_cursor
+{
+    payload_size_t offset;
+    size_t segment;
+    payload_size_t segment_offset;
+};
+
+/**
+ * Retrieves the next part of the transmitted payload that fits in a single message
+ *
+ * @param payload transmitted payload
+ * @param cursor position of the data in the payload, moved past the retrieved data
+ * @param data retrieved data, NULL if there is no data left
+ * @param size size of the retrieved data
+ *
+ * @returns status of the protocol
+ */
+static status_t next_payload_chunk(const protocol_payload_t *payload, struct payload_cursor *cursor,
+                                   const uint8_t **data, payload_size_t *size)
+{
+    *data = NULL;
+    *size = MIN(payload->size - cursor->offset, CONFIG_KENNING_PROTOCOL_MAX_OUTGOING_MESSAGE_SIZE);
+    if (0 == *size)
+    {
+        return STATUS_OK;
+    }
+
+    switch (payload->type)
+    {
+    case PROTOCOL_PAYLOAD_TYPE_BYTES:
+        *data = payload->raw_bytes + cursor->offset;
+        break;
+    case PROTOCOL_PAYLOAD_TYPE_SEGMENTS:
+        RETURN_ERROR_IF_POINTER_INVALID(payload->segments, KENNING_PROTOCOL_STATUS_INV_PTR);
+        // skip segments that were sent entirely, messages do not span multiple segments
+        while (cursor->segment < payload->segment_count &&
+               cursor->segment_offset >= payload->segments[cursor->segment].size)
+        {
+            cursor->segment++;
+            cursor->segment_offset = 0;
+        }
+        if (cursor->segment >= payload->segment_count)
+        {
+            LOG_ERR("Payload segments are smaller than payload size");
+            return KENNING_PROTOCOL_STATUS_INV_ARG;
+        }
+        *size = MIN(*size, payload->segments[cursor->segment].size - cursor->segment_offset);
+        *data = payload->segments[cursor->segment].data + cursor->segment_offset;
+        cursor->segment_offset += *size;
+        break;
+    default:
+        return KENNING_PROTOCOL_STATUS_INV_ARG;
+    }
+    cursor->offset += *size;
+    return STATUS_OK;
+}
+
 ZPL_CODE_SCOPE_DEFINE(protocol_receive_send_message, TRACE_MESSAGES);
+/**
+ * Sends the transmission in as many messages as needed. Has to be called by the owner of the transport.
+ *
+ * @param event transmission to send
+ *
+ * @returns status of the protocol
+ */
+static status_t send_event_messages(const protocol_event_t *event)
+{
+    status_t status = STATUS_OK;
+    bool has_payload = event->payload.size > 0;
+    struct payload_cursor cursor = {0};
+    // data of the payload is retrieved message by message, so that segmented payload is never gathered in a single
+    // buffer
+    do
+    {
+        outgoing_message_t message;
+        payload_size_t message_payload_size = 0;
+        bool first = (0 == cursor.offset);
+        status = next_payload_chunk(&event->payload, &cursor, &message.payload, &message_payload_size);
+        BREAK_ON_ERROR(status);
+        message.hdr.flags = event->flags;
+        message.hdr.message_type = event->message_type;
+        message.hdr.flow_control_flags = FLOW_CONTROL_TRANSMISSION;
+        message.hdr.payload_size = message_payload_size;
+        message.hdr.flags.general_purpose_flags.first = first ? 1 : 0;
+        message.hdr.flags.general_purpose_flags.last = (cursor.offset == event->payload.size) ? 1 : 0;
+        message.hdr.flags.general_purpose_flags.has_payload = has_payload;
+        message.hdr.flags.general_purpose_flags.is_host_message = 0;
+        ZPL_MARK_CODE_SCOPE(protocol_receive_send_message) { status = send_message(&message); }
+        BREAK_ON_ERROR(status);
+    } while (cursor.offset < event->payload.size);
+    return status;
+}
+
+ZPL_CODE_SCOPE_DEFINE(kenning_protocol_transmit, TRACE_PROTOCOL);
 status_t protocol_transmit(const protocol_event_t *event)
 {
-    if (protocol_busy)
+    status_t status = STATUS_OK;
+    RETURN_ERROR_IF_POINTER_INVALID(event, KENNING_PROTOCOL_STATUS_INV_PTR);
+    TX_PRIORITY priority = get_tx_priority(event->message_type);
+    // logs and traces are queued, so they do not wait for other messages, they are sent right away if the transport
+    // is free and by its owner otherwise
+    if (TX_PRIORITY_RESPONSE != priority && PROTOCOL_PAYLOAD_TYPE_BYTES == event->payload.type &&
+        STATUS_OK == tx_queue_put(priority, event))
+    {
+        if (STATUS_OK == protocol_send_lock(false))
+        {
+            protocol_send_unlock();
+        }
+        return STATUS_OK;
+    }
+    if (protocol_send_lock(TX_PRIORITY_RESPONSE == priority))
     {
         LOG_DBG("Attempted to start a transmission, while a message was being sent.");
         return KENNING_PROTOCOL_STATUS_BUSY;
     }
-    status_t status = STATUS_OK;
-    RETURN_ERROR_IF_POINTER_INVALID(event, KENNING_PROTOCOL_STATUS_INV_PTR);
     ZPL_MARK_CODE_SCOPE(kenning_protocol_transmit)
     {
-        bool has_payload = event->payload.size > 0;
-        unsigned int message_count =
-            has_payload ? ((event->payload.size - 1) / CONFIG_KENNING_PROTOCOL_MAX_OUTGOING_MESSAGE_SIZE) + 1
-                        : 1; // Rounding
-                             // up.
-        payload_size_t bytes_sent = 0;
-        for (int i = 0; i < message_count; i++)
-        {
-            payload_size_t message_payload_size =
-                MIN(event->payload.size - bytes_sent, CONFIG_KENNING_PROTOCOL_MAX_OUTGOING_MESSAGE_SIZE);
-            outgoing_message_t message;
-            message.hdr.flags = event->flags;
-            message.hdr.message_type = event->message_type;
-            message.hdr.flow_control_flags = FLOW_CONTROL_TRANSMISSION;
-            message.hdr.payload_size = message_payload_size;
-            message.hdr.flags.general_purpose_flags.first = (i == 0) ? 1 : 0;
-            message.hdr.flags.general_purpose_flags.last = (i == (message_count - 1)) ? 1 : 0;
-            message.hdr.flags.general_purpose_flags.has_payload = has_payload;
-            message.hdr.flags.general_purpose_flags.is_host_message = 0;
-            message.payload = has_payload ? event->payload.raw_bytes + bytes_sent : NULL;
-            protocol_busy = true;
-            ZPL_MARK_CODE_SCOPE(protocol_receive_send_message) { status = send_message(&message); }
-            protocol_busy = false;
-            BREAK_ON_ERROR(status);
-            bytes_sent += message_payload_size;
+        // background transmission that did not fit in the queue is sent after the ones queued before it
+        while (TX_PRIORITY_RESPONSE != priority && tx_queue_send_next())
+        {
         }
+        status = send_event_messages(event);
     }
+    protocol_send_unlock();
     return status;
 }
 
 ZPL_CODE_SCOPE_DEFINE(kenning_protocol_listen, TRACE_PROTOCOL);
-status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_callback)(message_type_t))
+status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_callback)(message_type_t, payload_size_t))
 {
     status_t status = STATUS_OK;
     RETURN_ERROR_IF_POINTER_INVALID(event, KENNING_PROTOCOL_STATUS_INV_PTR);
@@ -214,7 +1274,18 @@ status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_ca
     zpl_code_scope_enter(kenning_protocol_listen);
 #endif
     message_hdr_t header;
+    // set if the payload of the first message does not have to be discarded on error
+    bool received = false;
     ZPL_MARK_CODE_SCOPE(protocol_receive_header) { status = receive_message_header(&header); }
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+    // header decides which loader is picked and reset, so it is used only after the message is verified
+    bool staged = false;
+    if (STATUS_OK == status)
+    {
+        status = receive_first_message(&header, &staged);
+        received = staged || !header.flags.general_purpose_flags.has_payload;
+    }
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
     if (status)
     {
 #ifdef CONFIG_ZPL_SCOPE_MARKING
@@ -229,7 +1300,7 @@ status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_ca
                                            ? FLOW_CONTROL_STR[header.flow_control_flags]
                                            : "UNKNOWN";
         LOG_ERR("Invalid message at this time: %d (%s)", header.flow_control_flags, flow_control_str);
-        protocol_read_data(NULL, header.payload_size);
+        discard_first_message_payload(&header, received);
 #ifdef CONFIG_ZPL_SCOPE_MARKING
         zpl_code_scope_exit(kenning_protocol_listen);
 #endif
@@ -238,7 +1309,7 @@ status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_ca
     if (header.flags.general_purpose_flags.first == 0)
     {
         LOG_ERR("First message received did not have the 'first' flag set");
-        protocol_read_data(NULL, header.payload_size);
+        discard_first_message_payload(&header, received);
 #ifdef CONFIG_ZPL_SCOPE_MARKING
         zpl_code_scope_exit(kenning_protocol_listen);
 #endif
@@ -252,33 +1323,147 @@ status_t protocol_listen(protocol_event_t *event, struct msg_loader *(*loader_ca
     if (header.message_type >= NUM_MESSAGE_TYPES)
     {
         LOG_ERR("Invalid message type: %llu", (message_type_t)header.message_type);
-        protocol_read_data(NULL, header.payload_size);
+        discard_first_message_payload(&header, received);
 #ifdef CONFIG_ZPL_SCOPE_MARKING
         zpl_code_scope_exit(kenning_protocol_listen);
 #endif
         return KENNING_PROTOCOL_STATUS_INVALID_MESSAGE_TYPE;
     }
 
-    struct msg_loader *ldr = loader_callback(header.message_type);
+    struct msg_loader *ldr =
+        loader_callback(header.message_type, header.flags.general_purpose_flags.has_payload ? header.payload_size : 0);
 
     event->payload.loader = ldr;
     if (header.flags.general_purpose_flags.has_payload)
     {
-        status_t loader_status = ldr->reset(ldr);
+        if (!IS_VALID_POINTER(ldr))
+        {
+            LOG_ERR("Message type %llu does not accept payload", (message_type_t)header.message_type);
+            discard_first_message_payload(&header, received);
+#ifdef CONFIG_ZPL_SCOPE_MARKING
+            zpl_code_scope_exit(kenning_protocol_listen);
+#endif
+            return KENNING_PROTOCOL_STATUS_UNEXPECTED_PAYLOAD;
+        }
+        bool is_upload = MESSAGE_TYPE_MODEL == header.message_type || MESSAGE_TYPE_RUNTIME == header.message_type;
+        bool resume = is_upload && header.flags.flags_upload.resume;
+        if (resume && (!g_interrupted_upload.active || g_interrupted_upload.message_type != header.message_type ||
+                       g_interrupted_upload.compressed != header.flags.flags_upload.compressed ||
+                       g_interrupted_upload.patch != header.flags.flags_upload.patch))
+        {
+            LOG_ERR("No interrupted transmission of message type %llu to resume", (message_type_t)header.message_type);
+            discard_first_message_payload(&header, received);
+#ifdef CONFIG_ZPL_SCOPE_MARKING
+            zpl_code_scope_exit(kenning_protocol_listen);
+#endif
+            return KENNING_PROTOCOL_STATUS_INV_ARG;
+        }
+        struct msg_loader *payload_ldr = ldr;
+        if (is_upload && header.flags.flags_upload.patch)
+        {
+            if (MESSAGE_TYPE_MODEL != header.message_type)
+            {
+                LOG_ERR("Message type %llu cannot be patched", (message_type_t)header.message_type);
+                discard_first_message_payload(&header, received);
+#ifdef CONFIG_ZPL_SCOPE_MARKING
+                zpl_code_scope_exit(kenning_protocol_listen);
+#endif
+                return KENNING_PROTOCOL_STATUS_INV_ARG;
+            }
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+            // records are applied to the loaded model before the checksum of the message is verified, so a corrupted
+            // message could not be dropped and retransmitted
+            LOG_ERR("Model patches are not supported with message checksums");
+            discard_first_message_payload(&header, received);
+#ifdef CONFIG_ZPL_SCOPE_MARKING
+            zpl_code_scope_exit(kenning_protocol_listen);
+#endif
+            return KENNING_PROTOCOL_STATUS_INV_ARG;
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+            if (g_model_incomplete && !resume)
+            {
+                LOG_ERR("Model transmission did not complete, it cannot be patched");
+                discard_first_message_payload(&header, received);
+#ifdef CONFIG_ZPL_SCOPE_MARKING
+                zpl_code_scope_exit(kenning_protocol_listen);
+#endif
+                return KENNING_PROTOCOL_STATUS_INV_ARG;
+            }
+            // patch is applied to the loaded model, so the model loader is not reset
+            payload_ldr = patching_loader(payload_ldr);
+        }
+        if (is_upload && header.flags.flags_upload.compressed)
+        {
+#ifdef CONFIG_KENNING_COMPRESSED_UPLOAD
+            // payload is decompressed on the fly, so the loader receives and reports decompressed data
+            payload_ldr = decompressing_loader(payload_ldr);
+#else  // CONFIG_KENNING_COMPRESSED_UPLOAD
+            LOG_ERR("Compressed payload of message type %llu is not supported", (message_type_t)header.message_type);
+            discard_first_message_payload(&header, received);
+#ifdef CONFIG_ZPL_SCOPE_MARKING
+            zpl_code_scope_exit(kenning_protocol_listen);
+#endif
+            return KENNING_PROTOCOL_STATUS_INV_ARG;
+#endif // CONFIG_KENNING_COMPRESSED_UPLOAD
+        }
+        // resumed transmission is appended to the data received before the interruption
+        status_t loader_status = resume ? STATUS_OK : payload_ldr->reset(payload_ldr);
         if (loader_status)
         {
             LOG_ERR("Loader reset failure, status: %d", loader_status);
-            protocol_read_data(NULL, header.payload_size);
+            discard_first_message_payload(&header, received);
 #ifdef CONFIG_ZPL_SCOPE_MARKING
             zpl_code_scope_exit(kenning_protocol_listen);
 #endif
             return loader_status;
         }
-        status = receive_messages(ldr, &header);
+        if (resume)
+        {
+            LOG_INF("Resuming transmission of message type %llu from offset %zu", (message_type_t)header.message_type,
+                    payload_ldr->written);
+        }
+#ifdef CONFIG_KENNING_PROTOCOL_CHECKSUM
+        status = staged ? receive_staged_messages(payload_ldr, &header) : receive_messages(payload_ldr, &header, false);
+#else  // CONFIG_KENNING_PROTOCOL_CHECKSUM
+        status = receive_messages(payload_ldr, &header, false);
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+        if (is_upload)
+        {
+            // loader errors would repeat after resuming, so only transport errors interrupt the transmission
+            g_interrupted_upload.active = STATUS_OK != status && KENNING_PROTOCOL_STATUS_MSG_TOO_BIG != status;
+            g_interrupted_upload.message_type = header.message_type;
+            g_interrupted_upload.compressed = header.flags.flags_upload.compressed;
+            g_interrupted_upload.patch = header.flags.flags_upload.patch;
+            g_interrupted_upload.offset = payload_ldr->written;
+        }
+        if (MESSAGE_TYPE_MODEL == header.message_type && !header.flags.flags_upload.patch)
+        {
+            g_model_incomplete = STATUS_OK != status;
+        }
     }
-    event->payload.size = ldr->written;
+    // with checksums, message without payload was already received entirely when it was verified
+#ifndef CONFIG_KENNING_PROTOCOL_CHECKSUM
+    else
+    {
+        status = receive_message_end();
+    }
+#endif // CONFIG_KENNING_PROTOCOL_CHECKSUM
+    event->payload.size = IS_VALID_POINTER(ldr) ? ldr->written : 0;
 #ifdef CONFIG_ZPL_SCOPE_MARKING
     zpl_code_scope_exit(kenning_protocol_listen);
 #endif
     return status;
 }
+
+bool protocol_get_interrupted_upload(message_type_t *message_type, bool *compressed, bool *patch, size_t *offset)
+{
+    if (!g_interrupted_upload.active)
+    {
+        return false;
+    }
+    *message_type = g_interrupted_upload.message_type;
+    *compressed = g_interrupted_upload.compressed;
+    *patch = g_interrupted_upload.patch;
+    *offset = g_interrupted_upload.offset;
+    return true;
+}
@@ -5,6 +5,7 @@
  */
 
 #include <kenning_inference_lib/core/loaders.h>
+#include <zephyr/sys/util.h>
 
 GENERATE_MODULE_STATUSES_STR(LOADERS);
 
@@ -40,4 +41,301 @@ status_t buf_reset(struct msg_loader *ldr)
     return STATUS_OK;
 }
 
+status_t buf_rewind(struct msg_loader *ldr, size_t written)
+{
+    if (written > ldr->written)
+    {
+        return LOADERS_STATUS_INV_ARG;
+    }
+
+    ldr->written = written;
+
+    return STATUS_OK;
+}
+
+status_t buf_lease_window(struct msg_loader *ldr, uint8_t **dst, size_t *size)
+{
+    if (!IS_VALID_POINTER(ldr->addr) || ldr->written >= ldr->max_size)
+    {
+        return LOADERS_STATUS_NOT_ENOUGH_MEMORY;
+    }
+
+    *dst = (uint8_t *)(ldr->addr) + ldr->written;
+    *size = ldr->max_size - ldr->written;
+
+    return STATUS_OK;
+}
+
+status_t buf_commit_window(struct msg_loader *ldr, size_t n)
+{
+    if (ldr->written + n > ldr->max_size)
+    {
+        return LOADERS_STATUS_NOT_ENOUGH_MEMORY;
+    }
+
+    ldr->written += n;
+
+    return STATUS_OK;
+}
+
 struct msg_loader *g_ldr_tables[LDR_TABLE_COUNT][NUM_LOADER_TYPES];
+
+struct patch_state
+{
+    struct msg_loader *ldr;
+    struct patch_record_header header;
+    size_t header_read; // number of bytes of the current record header received so far
+    size_t data_left;   // number of data bytes of the current record yet to be received
+    size_t position;    // offset at which the next data byte is written
+};
+
+static status_t patch_save(struct msg_loader *ldr, const uint8_t *src, size_t n)
+{
+    struct patch_state *state = ldr->state;
+    struct msg_loader *target = state->ldr;
+    size_t i = 0;
+
+    while (i < n)
+    {
+        if (state->header_read < sizeof(state->header))
+        {
+            size_t to_copy = MIN(sizeof(state->header) - state->header_read, n - i);
+            memcpy((uint8_t *)&state->header + state->header_read, src + i, to_copy);
+            state->header_read += to_copy;
+            i += to_copy;
+            if (state->header_read < sizeof(state->header))
+            {
+                break;
+            }
+            if (!IS_VALID_POINTER(target->addr))
+            {
+                return LOADERS_STATUS_INV_PTR;
+            }
+            // records can only replace data that is already stored
+            if (state->header.offset > target->written || state->header.size > target->written - state->header.offset)
+            {
+                return LOADERS_STATUS_INV_ARG;
+            }
+            state->position = state->header.offset;
+            state->data_left = state->header.size;
+        }
+        size_t to_copy = MIN(state->data_left, n - i);
+        memcpy((uint8_t *)target->addr + state->position, src + i, to_copy);
+        state->position += to_copy;
+        state->data_left -= to_copy;
+        i += to_copy;
+        if (0 == state->data_left)
+        {
+            state->header_read = 0;
+        }
+    }
+    ldr->written += n;
+    return STATUS_OK;
+}
+
+static status_t patch_save_one(struct msg_loader *ldr, void *c) { return patch_save(ldr, c, 1); }
+
+static status_t patch_reset(struct msg_loader *ldr)
+{
+    struct patch_state *state = ldr->state;
+
+    // patched data is kept, only the parser starts over
+    state->header_read = 0;
+    state->data_left = 0;
+    ldr->written = 0;
+    return STATUS_OK;
+}
+
+struct msg_loader *patching_loader(struct msg_loader *ldr)
+{
+    static struct patch_state state;
+    static struct msg_loader patch_ldr = {.save = patch_save,
+                                          .save_one = patch_save_one,
+                                          .reset = patch_reset,
+                                          .rewind = NULL,
+                                          .written = 0,
+                                          .max_size = SIZE_MAX,
+                                          .addr = NULL,
+                                          .state = &state};
+
+    state.ldr = ldr;
+    return &patch_ldr;
+}
+
+#ifdef CONFIG_KENNING_COMPRESSED_UPLOAD
+
+#define HEATSHRINK_WINDOW_SIZE (1 << CONFIG_KENNING_DECOMPRESSION_WINDOW_BITS)
+#define HEATSHRINK_WINDOW_MASK (HEATSHRINK_WINDOW_SIZE - 1)
+// size of the buffer for decompressed data, which is passed to the wrapped loader when the buffer is full
+#define DECOMPRESS_OUTPUT_BUFFER_SIZE 64
+
+_Static_assert(CONFIG_KENNING_DECOMPRESSION_LOOKAHEAD_BITS < CONFIG_KENNING_DECOMPRESSION_WINDOW_BITS,
+               "Heatshrink lookahead has to be smaller than the window");
+
+/*
+ Heatshrink stream is a sequence of bits, most significant bit of each byte first. Each
+ element starts with a tag bit, 1 is followed by an 8-bit literal, 0 is followed by a
+ back-reference: offset minus one (window bits) and length minus one (lookahead bits). The
+ back-reference copies bytes from the window of recently decompressed data, which is
+ zero-filled at the start of the stream. Padding bits at the end of the stream are ignored.
+*/
+typedef enum
+{
+    HEATSHRINK_FIELD_TAG,
+    HEATSHRINK_FIELD_LITERAL,
+    HEATSHRINK_FIELD_BACKREF_INDEX,
+    HEATSHRINK_FIELD_BACKREF_COUNT,
+} HEATSHRINK_FIELD;
+
+struct decompress_state
+{
+    struct msg_loader *ldr;
+    uint8_t window[HEATSHRINK_WINDOW_SIZE];
+    uint16_t head; // number of decompressed bytes modulo window size
+    uint16_t backref_index;
+    HEATSHRINK_FIELD field;
+    uint16_t field_value;
+    uint8_t field_bits_left;
+    uint8_t output[DECOMPRESS_OUTPUT_BUFFER_SIZE];
+    size_t output_size;
+};
+
+static void decompress_start_field(struct decompress_state *state, HEATSHRINK_FIELD field, uint8_t bits)
+{
+    state->field = field;
+    state->field_value = 0;
+    state->field_bits_left = bits;
+}
+
+static status_t decompress_flush(struct decompress_state *state)
+{
+    status_t status = STATUS_OK;
+
+    if (state->output_size > 0)
+    {
+        status = state->ldr->save(state->ldr, state->output, state->output_size);
+        state->output_size = 0;
+    }
+    return status;
+}
+
+static status_t decompress_output(struct decompress_state *state, uint8_t c)
+{
+    state->window[state->head & HEATSHRINK_WINDOW_MASK] = c;
+    state->head++;
+    state->output[state->output_size++] = c;
+    if (state->output_size == DECOMPRESS_OUTPUT_BUFFER_SIZE)
+    {
+        return decompress_flush(state);
+    }
+    return STATUS_OK;
+}
+
+static status_t decompress_bit(struct decompress_state *state, uint8_t bit)
+{
+    status_t status = STATUS_OK;
+
+    state->field_value = (state->field_value << 1) | bit;
+    if (--state->field_bits_left > 0)
+    {
+        return STATUS_OK;
+    }
+    switch (state->field)
+    {
+    case HEATSHRINK_FIELD_TAG:
+        if (state->field_value)
+        {
+            decompress_start_field(state, HEATSHRINK_FIELD_LITERAL, 8);
+        }
+        else
+        {
+            decompress_start_field(state, HEATSHRINK_FIELD_BACKREF_INDEX, CONFIG_KENNING_DECOMPRESSION_WINDOW_BITS);
+        }
+        break;
+    case HEATSHRINK_FIELD_LITERAL:
+        status = decompress_output(state, (uint8_t)state->field_value);
+        decompress_start_field(state, HEATSHRINK_FIELD_TAG, 1);
+        break;
+    case HEATSHRINK_FIELD_BACKREF_INDEX:
+        state->backref_index = state->field_value + 1;
+        decompress_start_field(state, HEATSHRINK_FIELD_BACKREF_COUNT, CONFIG_KENNING_DECOMPRESSION_LOOKAHEAD_BITS);
+        break;
+    case HEATSHRINK_FIELD_BACKREF_COUNT:
+    {
+        size_t count = state->field_value + 1;
+
+        for (size_t i = 0; i < count && STATUS_OK == status; i++)
+        {
+            status = decompress_output(
+                state, state->window[(uint16_t)(state->head - state->backref_index) & HEATSHRINK_WINDOW_MASK]);
+        }
+        decompress_start_field(state, HEATSHRINK_FIELD_TAG, 1);
+        break;
+    }
+    }
+    return status;
+}
+
+static status_t decompress_save(struct msg_loader *ldr, const uint8_t *src, size_t n)
+{
+    struct decompress_state *state = ldr->state;
+    status_t status = STATUS_OK;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        for (int bit = 7; bit >= 0; bit--)
+        {
+            status = decompress_bit(state, (src[i] >> bit) & 1);
+            RETURN_ON_ERROR(status, status);
+        }
+    }
+    ldr->written += n;
+    // decompressed data is passed on with each saved chunk, so that it can be used right after the last one
+    return decompress_flush(state);
+}
+
+static status_t decompress_save_one(struct msg_loader *ldr, void *c) { return decompress_save(ldr, c, 1); }
+
+static status_t decompress_reset(struct msg_loader *ldr)
+{
+    struct decompress_state *state = ldr->state;
+
+    memset(state->window, 0, sizeof(state->window));
+    state->head = 0;
+    state->output_size = 0;
+    decompress_start_field(state, HEATSHRINK_FIELD_TAG, 1);
+    ldr->written = 0;
+    return state->ldr->reset(state->ldr);
+}
+
+static status_t decompress_rewind(struct msg_loader *ldr, size_t written)
+{
+    // state of the decompressor is known only at the start of the payload
+    if (written == ldr->written)
+    {
+        return STATUS_OK;
+    }
+    if (0 == written)
+    {
+        return decompress_reset(ldr);
+    }
+    return LOADERS_STATUS_INV_ARG;
+}
+
+struct msg_loader *decompressing_loader(struct msg_loader *ldr)
+{
+    static struct decompress_state state;
+    static struct msg_loader decompress_ldr = {.save = decompress_save,
+                                               .save_one = decompress_save_one,
+                                               .reset = decompress_reset,
+                                               .rewind = decompress_rewind,
+                                               .written = 0,
+                                               .max_size = SIZE_MAX,
+                                               .addr = NULL,
+                                               .state = &state};
+
+    state.ldr = ldr;
+    return &decompress_ldr;
+}
+
+#endif // CONFIG_KENNING_COMPRESSED_UPLOAD
@@ -70,11 +70,12 @@ void send_all_messages()
         transmission.message_type = MESSAGE_TYPE_LOGS;
         transmission.flags.raw_bytes = 0;
         transmission.flags.general_purpose_flags.is_zephyr = 1;
+        transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
         transmission.payload.raw_bytes = msg_buffer;
         transmission.payload.size = msg_buffer_len;
         status_t status = protocol_transmit(&transmission);
 
-        // Erase the buffer, if the transmission succeeded.
+        // Erase the buffer, if the transmission was sent or queued by the protocol.
         if (status == STATUS_OK)
         {
             msg_buffer_len = 0;
@@ -38,6 +38,37 @@ MODEL_STATE model_get_state() { return g_model_state; }
 
 void model_reset_state() { g_model_state = MODEL_STATE_UNINITIALIZED; }
 
+// set by the thread receiving requests while another thread runs the inference
+static volatile bool g_inference_running = false;
+static volatile bool g_cancel_requested = false;
+
+void model_request_cancel() { g_cancel_requested = g_inference_running; }
+
+bool runtime_cancel_requested() { return g_cancel_requested; }
+
+/**
+ * Runs the inference with the given runtime function, so that it can be cancelled with model_request_cancel
+ *
+ * @param run runtime function running the inference
+ *
+ * @returns status of the runtime
+ */
+static status_t run_cancellable(status_t (*run)())
+{
+    status_t status = STATUS_OK;
+
+    g_cancel_requested = false;
+    g_inference_running = true;
+    status = run();
+    g_inference_running = false;
+    g_cancel_requested = false;
+    if (RUNTIME_WRAPPER_STATUS_CANCELLED == status)
+    {
+        LOG_INF("Model inference cancelled");
+    }
+    return status;
+}
+
 /**
  * Validates metadata (shapes and data types) of tensors stored in a struct
  * (intended for use with the model_spec_t struct from runtime_wrapper.h)
@@ -304,7 +335,7 @@ status_t model_run()
     }
 
     // perform inference
-    ZPL_MARK_CODE_SCOPE(runtime_run) { status = runtime_run_model(); }
+    ZPL_MARK_CODE_SCOPE(runtime_run) { status = run_cancellable(runtime_run_model); }
     RETURN_ON_ERROR(status, status);
 
     LOG_DBG("Model inference done");
@@ -324,7 +355,7 @@ status_t model_run_bench()
     }
 
     // perform inference
-    ZPL_MARK_CODE_SCOPE(runtime_run) { status = runtime_run_model_bench(); }
+    ZPL_MARK_CODE_SCOPE(runtime_run) { status = run_cancellable(runtime_run_model_bench); }
     RETURN_ON_ERROR(status, status);
 
     LOG_DBG("Model inference with a benchmark done");
@@ -393,6 +424,41 @@ status_t model_get_output(const size_t buffer_size, uint8_t *model_output, size_
     return status;
 }
 
+status_t model_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    status_t status = STATUS_OK;
+    size_t output_size = 0;
+    size_t views_size = 0;
+
+    RETURN_ERROR_IF_POINTER_INVALID(views, MODEL_STATUS_INV_PTR);
+    RETURN_ERROR_IF_POINTER_INVALID(num_views, MODEL_STATUS_INV_PTR);
+
+    if (g_model_state < MODEL_STATE_INFERENCE_DONE)
+    {
+        return MODEL_STATUS_INV_STATE;
+    }
+
+    status = model_get_output_size(&output_size);
+    RETURN_ON_ERROR(status, status);
+
+    ZPL_MARK_CODE_SCOPE(runtime_get_output) { status = runtime_get_output_view(max_views, views, num_views); }
+    RETURN_ON_ERROR(status, status);
+
+    for (size_t i = 0; i < *num_views; ++i)
+    {
+        views_size += views[i].size;
+    }
+    if (views_size != output_size)
+    {
+        LOG_ERR("Invalid output view size. View size: %zu. Model output size: %zu", views_size, output_size);
+        return MODEL_STATUS_ERROR;
+    }
+
+    LOG_DBG("Model output view retrieved");
+
+    return status;
+}
+
 ZPL_CODE_SCOPE_DEFINE(runtime_get_stats, TRACE_RUNTIME);
 status_t model_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer, size_t *statistics_size)
 {
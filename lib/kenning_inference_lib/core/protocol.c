@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kenning_inference_lib/core/protocol.h"
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#ifndef __UNIT_TEST__
+#include <zephyr/logging/log.h>
+#else // __UNIT_TEST__
+#include "mocks/log.h"
+#endif
+
+LOG_MODULE_REGISTER(protocol, CONFIG_PROTOCOL_LOG_LEVEL);
+
+GENERATE_MODULE_STATUSES_STR(PROTOCOL);
+
+#define TRANSPORT_DECLARE(config, transport) \
+    COND_CODE_1(config, (extern const struct protocol_transport transport;), ())
+#define TRANSPORT_ENTRY(config, transport) COND_CODE_1(config, (&transport, ), ())
+
+PROTOCOL_TRANSPORTS(TRANSPORT_DECLARE)
+
+static const struct protocol_transport *const G_TRANSPORTS[] = {PROTOCOL_TRANSPORTS(TRANSPORT_ENTRY)};
+
+_Static_assert(ARRAY_SIZE(G_TRANSPORTS) > 0, "No transport selected for communication with Kenning");
+
+ut_static const struct protocol_transport *gp_transport = NULL;
+
+#define CHECK_TRANSPORT_BOUND() RETURN_ERROR_IF_POINTER_INVALID(gp_transport, PROTOCOL_STATUS_UNINIT)
+
+status_t protocol_init()
+{
+    status_t status = PROTOCOL_STATUS_ERROR;
+
+    if (IS_VALID_POINTER(gp_transport))
+    {
+        return gp_transport->init();
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(G_TRANSPORTS); ++i)
+    {
+        status = G_TRANSPORTS[i]->init();
+        if (STATUS_OK == status)
+        {
+            gp_transport = G_TRANSPORTS[i];
+            LOG_INF("Using %s transport", gp_transport->name);
+            return STATUS_OK;
+        }
+        LOG_WRN("Transport %s not available, status: 0x%x", G_TRANSPORTS[i]->name, status);
+    }
+    return status;
+}
+
+status_t protocol_select_transport(const char *name)
+{
+    RETURN_ERROR_IF_POINTER_INVALID(name, PROTOCOL_STATUS_INV_PTR);
+
+    for (size_t i = 0; i < ARRAY_SIZE(G_TRANSPORTS); ++i)
+    {
+        if (0 != strcmp(G_TRANSPORTS[i]->name, name))
+        {
+            continue;
+        }
+        status_t status = G_TRANSPORTS[i]->init();
+        RETURN_ON_ERROR(status, status);
+
+        gp_transport = G_TRANSPORTS[i];
+        LOG_INF("Using %s transport", gp_transport->name);
+        return STATUS_OK;
+    }
+    LOG_ERR("Unknown transport %s", name);
+    return PROTOCOL_STATUS_INV_ARG;
+}
+
+const char *protocol_get_transport_name()
+{
+    if (!IS_VALID_POINTER(gp_transport))
+    {
+        return NULL;
+    }
+    return gp_transport->name;
+}
+
+status_t protocol_write_data(const uint8_t *data, size_t data_length)
+{
+    CHECK_TRANSPORT_BOUND();
+
+    return gp_transport->write(data, data_length);
+}
+
+status_t protocol_read_data(uint8_t *data, size_t data_length)
+{
+    CHECK_TRANSPORT_BOUND();
+
+    return gp_transport->read(data, data_length);
+}
+
+status_t protocol_flush()
+{
+    CHECK_TRANSPORT_BOUND();
+
+    if (!IS_VALID_POINTER(gp_transport->flush))
+    {
+        // transport writes are synchronous
+        return STATUS_OK;
+    }
+    return gp_transport->flush();
+}
+
+status_t protocol_lease(const uint8_t **data, size_t max_length, size_t *data_length)
+{
+    CHECK_TRANSPORT_BOUND();
+    RETURN_ERROR_IF_POINTER_INVALID(data, PROTOCOL_STATUS_INV_PTR);
+    RETURN_ERROR_IF_POINTER_INVALID(data_length, PROTOCOL_STATUS_INV_PTR);
+
+    if (!IS_VALID_POINTER(gp_transport->lease))
+    {
+        return PROTOCOL_STATUS_NOT_SUPPORTED;
+    }
+    return gp_transport->lease(data, max_length, data_length);
+}
+
+status_t protocol_release(size_t data_length)
+{
+    CHECK_TRANSPORT_BOUND();
+
+    if (!IS_VALID_POINTER(gp_transport->release))
+    {
+        return PROTOCOL_STATUS_NOT_SUPPORTED;
+    }
+    return gp_transport->release(data_length);
+}
+
+status_t protocol_set_baudrate(uint32_t baudrate)
+{
+    CHECK_TRANSPORT_BOUND();
+
+    if (!IS_VALID_POINTER(gp_transport->set_baudrate))
+    {
+        return PROTOCOL_STATUS_NOT_SUPPORTED;
+    }
+    return gp_transport->set_baudrate(baudrate);
+}
+
+status_t protocol_get_baudrate(uint32_t *baudrate)
+{
+    CHECK_TRANSPORT_BOUND();
+
+    if (!IS_VALID_POINTER(gp_transport->get_baudrate))
+    {
+        return PROTOCOL_STATUS_NOT_SUPPORTED;
+    }
+    return gp_transport->get_baudrate(baudrate);
+}
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kenning_inference_lib/core/protocol.h"
+#include <stdbool.h>
+#include <string.h>
+
+#ifndef __UNIT_TEST__
+#include <zephyr/ipc/ipc_service.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/util.h>
+#else // __UNIT_TEST__
+#include "mocks/ipc.h"
+#include "mocks/kernel.h"
+#include "mocks/log.h"
+#include "mocks/ring_buffer.h"
+#endif
+
+LOG_MODULE_REGISTER(kenning_ipc, CONFIG_KENNING_IPC_LOG_LEVEL);
+
+#define IPC_TIMEOUT_MS (500) /* timeout between consecutive chunks of data, same as in UART */
+#define IPC_INSTANCE_NODE DT_ALIAS(kipc)
+
+/**
+ * Data received in a single IPC message. If the backend allows holding RX buffers, data points to the shared memory,
+ * otherwise it is NULL and the data was copied to the RX ring buffer
+ */
+struct ipc_rx_chunk
+{
+    const uint8_t *data;
+    size_t length;
+};
+
+static const struct device *const G_IPC_INSTANCE = DEVICE_DT_GET(IPC_INSTANCE_NODE);
+
+ut_static struct ipc_ept g_ipc_ept;
+ut_static bool g_ipc_initialized = false;
+
+K_MSGQ_DEFINE(g_ipc_rx_msgq, sizeof(struct ipc_rx_chunk), CONFIG_KENNING_IPC_RX_QUEUE_SIZE, 4);
+RING_BUF_DECLARE(g_ipc_rx_ring_buf, CONFIG_KENNING_IPC_RX_RING_BUFFER_SIZE);
+K_SEM_DEFINE(g_ipc_bound_sem, 0, 1);
+
+// chunk that is currently read and number of bytes of the chunk that were already read
+static struct ipc_rx_chunk g_ipc_rx_chunk;
+static size_t g_ipc_rx_offset = 0;
+
+// set by the callback when received data could not be queued
+static volatile bool g_ipc_rx_overflow = false;
+
+/**
+ * Endpoint bound callback
+ *
+ * @param priv unused
+ */
+static void ipc_ept_bound(void *priv)
+{
+    ARG_UNUSED(priv);
+
+    k_sem_give(&g_ipc_bound_sem);
+    LOG_INF("IPC endpoint bound");
+}
+
+/**
+ * Endpoint data callback, keeps received buffer in the shared memory if the backend supports it
+ *
+ * @param data received data
+ * @param len size of the received data
+ * @param priv unused
+ */
+static void ipc_ept_received(const void *data, size_t len, void *priv)
+{
+    ARG_UNUSED(priv);
+
+    struct ipc_rx_chunk chunk = {.data = data, .length = len};
+
+    // the callback is the only producer, so once there is a free slot the chunk cannot be rejected by the queue,
+    // checking it first ensures that no data ends up in the ring buffer without a chunk describing it
+    if (0 == k_msgq_num_free_get(&g_ipc_rx_msgq))
+    {
+        g_ipc_rx_overflow = true;
+        return;
+    }
+
+    if (0 != ipc_service_hold_rx_buffer(&g_ipc_ept, (void *)data))
+    {
+        // buffer is reused by the backend after the callback returns, so data has to be copied
+        if (ring_buf_space_get(&g_ipc_rx_ring_buf) < len)
+        {
+            g_ipc_rx_overflow = true;
+            return;
+        }
+        ring_buf_put(&g_ipc_rx_ring_buf, data, len);
+        chunk.data = NULL;
+    }
+
+    k_msgq_put(&g_ipc_rx_msgq, &chunk, K_NO_WAIT);
+}
+
+/**
+ * Returns buffer of the current chunk to the backend
+ */
+static void ipc_release_chunk()
+{
+    if (IS_VALID_POINTER(g_ipc_rx_chunk.data))
+    {
+        ipc_service_release_rx_buffer(&g_ipc_ept, (void *)g_ipc_rx_chunk.data);
+    }
+    g_ipc_rx_chunk.data = NULL;
+    g_ipc_rx_chunk.length = 0;
+    g_ipc_rx_offset = 0;
+}
+
+/**
+ * Drops all queued chunks, returning held buffers to the backend and removing copied data from the ring buffer
+ */
+static void ipc_purge_chunks()
+{
+    struct ipc_rx_chunk chunk;
+
+    while (0 == k_msgq_get(&g_ipc_rx_msgq, &chunk, K_NO_WAIT))
+    {
+        if (IS_VALID_POINTER(chunk.data))
+        {
+            ipc_service_release_rx_buffer(&g_ipc_ept, (void *)chunk.data);
+        }
+        else
+        {
+            ring_buf_get(&g_ipc_rx_ring_buf, NULL, chunk.length);
+        }
+    }
+}
+
+/**
+ * Waits for the next chunk if the current one was read entirely
+ *
+ * @returns status of the operation
+ */
+static status_t ipc_get_chunk()
+{
+    while (g_ipc_rx_offset >= g_ipc_rx_chunk.length)
+    {
+        ipc_release_chunk();
+
+        if (g_ipc_rx_overflow)
+        {
+            g_ipc_rx_overflow = false;
+            // data around the dropped chunk is not a valid continuation of the stream, so it is dropped as well
+            ipc_purge_chunks();
+            LOG_ERR("IPC RX queue overflow");
+            return PROTOCOL_STATUS_RECV_ERROR;
+        }
+        if (0 != k_msgq_get(&g_ipc_rx_msgq, &g_ipc_rx_chunk, K_MSEC(IPC_TIMEOUT_MS)))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Marks data of the current chunk as read
+ *
+ * @param data_length number of bytes read
+ */
+static void ipc_consume_chunk(size_t data_length)
+{
+    g_ipc_rx_offset += data_length;
+    if (g_ipc_rx_offset >= g_ipc_rx_chunk.length)
+    {
+        // return shared memory buffer to the sender as soon as possible
+        ipc_release_chunk();
+    }
+}
+
+#ifdef __UNIT_TEST__
+extern int64_t g_ticks;
+
+static int64_t k_uptime_get() { return g_ticks++; }
+#endif // __UNIT_TEST__
+
+static status_t ipc_transport_init()
+{
+    static const struct ipc_ept_cfg ept_cfg = {
+        .name = CONFIG_KENNING_IPC_ENDPOINT_NAME,
+        .cb =
+            {
+                .bound = ipc_ept_bound,
+                .received = ipc_ept_received,
+            },
+    };
+    int ret = 0;
+
+    if (g_ipc_initialized)
+    {
+        return STATUS_OK;
+    }
+
+    if (!device_is_ready(G_IPC_INSTANCE))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    ret = ipc_service_open_instance(G_IPC_INSTANCE);
+    if (ret < 0 && -EALREADY != ret)
+    {
+        LOG_ERR("Opening IPC instance failed: %d", ret);
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    k_msgq_purge(&g_ipc_rx_msgq);
+    ring_buf_reset(&g_ipc_rx_ring_buf);
+    k_sem_reset(&g_ipc_bound_sem);
+    g_ipc_rx_chunk.data = NULL;
+    g_ipc_rx_chunk.length = 0;
+    g_ipc_rx_offset = 0;
+    g_ipc_rx_overflow = false;
+
+    ret = ipc_service_register_endpoint(G_IPC_INSTANCE, &g_ipc_ept, &ept_cfg);
+    if (ret < 0)
+    {
+        LOG_ERR("Registering IPC endpoint failed: %d", ret);
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    g_ipc_initialized = true;
+
+    return STATUS_OK;
+}
+
+static status_t ipc_transport_write(const uint8_t *data, size_t data_length)
+{
+    size_t data_written = 0;
+
+    if (!g_ipc_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    RETURN_ERROR_IF_POINTER_INVALID(data, PROTOCOL_STATUS_INV_PTR);
+
+    LOG_DBG("Writing %zu bytes to IPC endpoint", data_length);
+
+    // the remote endpoint has to be bound before any data is sent, the semaphore stays given afterwards
+    if (0 != k_sem_take(&g_ipc_bound_sem, K_MSEC(IPC_TIMEOUT_MS)))
+    {
+        return PROTOCOL_STATUS_TIMEOUT;
+    }
+    k_sem_give(&g_ipc_bound_sem);
+
+    int max_size = ipc_service_get_tx_buffer_size(&g_ipc_ept);
+    int64_t start_timer = k_uptime_get();
+
+    while (data_written < data_length)
+    {
+        size_t to_write = data_length - data_written;
+        int ret = 0;
+
+        if (max_size > 0)
+        {
+            to_write = MIN(to_write, (size_t)max_size);
+        }
+
+        ret = ipc_service_send(&g_ipc_ept, data + data_written, to_write);
+        if (-ENOMEM == ret || -EBUSY == ret)
+        {
+            // no free buffers in the shared memory, wait until the remote releases them
+            if (k_uptime_get() - start_timer > IPC_TIMEOUT_MS)
+            {
+                return PROTOCOL_STATUS_TIMEOUT;
+            }
+            k_yield();
+            continue;
+        }
+        if (ret < 0)
+        {
+            LOG_ERR("Sending IPC message failed: %d", ret);
+            return PROTOCOL_STATUS_ERROR;
+        }
+        data_written += to_write;
+        start_timer = k_uptime_get();
+    }
+    return STATUS_OK;
+}
+
+static status_t ipc_transport_read(uint8_t *data, size_t data_length)
+{
+    size_t data_read = 0;
+    status_t status = STATUS_OK;
+
+    if (!g_ipc_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    LOG_DBG("Reading %zu bytes from IPC endpoint", data_length);
+
+    while (data_read < data_length)
+    {
+        status = ipc_get_chunk();
+        RETURN_ON_ERROR(status, status);
+
+        size_t chunk_size = MIN(data_length - data_read, g_ipc_rx_chunk.length - g_ipc_rx_offset);
+        uint8_t *dst = IS_VALID_POINTER(data) ? data + data_read : NULL;
+
+        if (IS_VALID_POINTER(g_ipc_rx_chunk.data))
+        {
+            if (IS_VALID_POINTER(dst))
+            {
+                memcpy(dst, g_ipc_rx_chunk.data + g_ipc_rx_offset, chunk_size);
+            }
+        }
+        else
+        {
+            chunk_size = ring_buf_get(&g_ipc_rx_ring_buf, dst, chunk_size);
+        }
+        ipc_consume_chunk(chunk_size);
+        data_read += chunk_size;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Leases data of the received message without copying it, waits for a message if none is available
+ *
+ * @param data leased data
+ * @param max_length maximum number of bytes to lease
+ * @param data_length number of leased bytes
+ *
+ * @returns status of the lease
+ */
+static status_t ipc_transport_lease(const uint8_t **data, size_t max_length, size_t *data_length)
+{
+    status_t status = STATUS_OK;
+
+    if (!g_ipc_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    status = ipc_get_chunk();
+    RETURN_ON_ERROR(status, status);
+
+    size_t chunk_size = MIN(max_length, g_ipc_rx_chunk.length - g_ipc_rx_offset);
+
+    if (IS_VALID_POINTER(g_ipc_rx_chunk.data))
+    {
+        *data = g_ipc_rx_chunk.data + g_ipc_rx_offset;
+    }
+    else
+    {
+        chunk_size = ring_buf_get_claim(&g_ipc_rx_ring_buf, (uint8_t **)data, chunk_size);
+    }
+    *data_length = chunk_size;
+    return STATUS_OK;
+}
+
+/**
+ * Marks leased data as read, the shared memory buffer is returned to the backend when all of its data is read
+ *
+ * @param data_length number of bytes consumed
+ *
+ * @returns status of the release
+ */
+static status_t ipc_transport_release(size_t data_length)
+{
+    if (!IS_VALID_POINTER(g_ipc_rx_chunk.data) && 0 != ring_buf_get_finish(&g_ipc_rx_ring_buf, data_length))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    if (data_length > 0)
+    {
+        ipc_consume_chunk(data_length);
+    }
+    return STATUS_OK;
+}
+
+const struct protocol_transport g_ipc_transport = {
+    .name = "ipc",
+    .init = ipc_transport_init,
+    .write = ipc_transport_write,
+    .read = ipc_transport_read,
+    .lease = ipc_transport_lease,
+    .release = ipc_transport_release,
+};
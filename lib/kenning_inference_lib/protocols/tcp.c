@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kenning_inference_lib/core/protocol.h"
+#include <errno.h>
+#include <stdbool.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(kenning_tcp, CONFIG_KENNING_TCP_LOG_LEVEL);
+
+#define TCP_TIMEOUT_MS (500) /* read timeout between consecutive chunks of data, same as in UART */
+#define TCP_DISCARD_BUFFER_SIZE (64)
+
+static int g_tcp_listen_sock = -1;
+static int g_tcp_client_sock = -1;
+
+/**
+ * Closes connection with the current client
+ */
+static void tcp_close_client()
+{
+    if (g_tcp_client_sock < 0)
+    {
+        return;
+    }
+    zsock_close(g_tcp_client_sock);
+    g_tcp_client_sock = -1;
+    LOG_INF("Client disconnected");
+}
+
+/**
+ * Waits for a client connection if no client is connected
+ *
+ * @returns status of the operation
+ */
+static status_t tcp_accept_client()
+{
+    struct zsock_pollfd fd = {.fd = g_tcp_listen_sock, .events = ZSOCK_POLLIN};
+    int flag = 1;
+    int ret = 0;
+
+    if (g_tcp_client_sock >= 0)
+    {
+        return STATUS_OK;
+    }
+
+    ret = zsock_poll(&fd, 1, TCP_TIMEOUT_MS);
+    if (0 == ret)
+    {
+        return PROTOCOL_STATUS_TIMEOUT;
+    }
+    if (ret < 0)
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    g_tcp_client_sock = zsock_accept(g_tcp_listen_sock, NULL, NULL);
+    if (g_tcp_client_sock < 0)
+    {
+        LOG_ERR("Accepting connection failed: %d", errno);
+        return PROTOCOL_STATUS_ERROR;
+    }
+    // messages are exchanged in request-response manner, so they should not wait for more data
+    zsock_setsockopt(g_tcp_client_sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+    LOG_INF("Client connected");
+    return STATUS_OK;
+}
+
+static status_t tcp_transport_init()
+{
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(CONFIG_KENNING_TCP_PORT),
+        .sin_addr = INADDR_ANY_INIT,
+    };
+    int flag = 1;
+    int sock = -1;
+
+    if (g_tcp_listen_sock >= 0)
+    {
+        return STATUS_OK;
+    }
+
+    sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock < 0)
+    {
+        LOG_ERR("Creating socket failed: %d", errno);
+        return PROTOCOL_STATUS_ERROR;
+    }
+    zsock_setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+    if (zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || zsock_listen(sock, 1) < 0)
+    {
+        LOG_ERR("Listening on port %d failed: %d", CONFIG_KENNING_TCP_PORT, errno);
+        zsock_close(sock);
+        return PROTOCOL_STATUS_ERROR;
+    }
+    g_tcp_listen_sock = sock;
+
+    LOG_INF("Listening on TCP port %d", CONFIG_KENNING_TCP_PORT);
+    return STATUS_OK;
+}
+
+static status_t tcp_transport_write(const uint8_t *data, size_t data_length)
+{
+    size_t data_written = 0;
+
+    if (g_tcp_listen_sock < 0)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    RETURN_ERROR_IF_POINTER_INVALID(data, PROTOCOL_STATUS_INV_PTR);
+
+    LOG_DBG("Writing %zu bytes to TCP socket", data_length);
+
+    if (g_tcp_client_sock < 0)
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    while (data_written < data_length)
+    {
+        ssize_t ret = zsock_send(g_tcp_client_sock, data + data_written, data_length - data_written, 0);
+        if (ret < 0)
+        {
+            LOG_ERR("Sending data failed: %d", errno);
+            tcp_close_client();
+            return PROTOCOL_STATUS_ERROR;
+        }
+        data_written += ret;
+    }
+    return STATUS_OK;
+}
+
+static status_t tcp_transport_read(uint8_t *data, size_t data_length)
+{
+    static uint8_t discard_buffer[TCP_DISCARD_BUFFER_SIZE];
+    size_t data_read = 0;
+    status_t status = STATUS_OK;
+
+    if (g_tcp_listen_sock < 0)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    LOG_DBG("Reading %zu bytes from TCP socket", data_length);
+
+    if (0 == data_length)
+    {
+        return STATUS_OK;
+    }
+
+    status = tcp_accept_client();
+    RETURN_ON_ERROR(status, status);
+
+    while (data_read < data_length)
+    {
+        struct zsock_pollfd fd = {.fd = g_tcp_client_sock, .events = ZSOCK_POLLIN};
+        uint8_t *buffer = discard_buffer;
+        size_t to_read = MIN(sizeof(discard_buffer), data_length - data_read);
+        ssize_t ret = 0;
+
+        if (IS_VALID_POINTER(data))
+        {
+            buffer = data + data_read;
+            to_read = data_length - data_read;
+        }
+
+        // the timeout is measured between consecutive chunks of data, same as in UART
+        ret = zsock_poll(&fd, 1, TCP_TIMEOUT_MS);
+        if (0 == ret)
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+        if (ret < 0)
+        {
+            return PROTOCOL_STATUS_RECV_ERROR;
+        }
+
+        ret = zsock_recv(g_tcp_client_sock, buffer, to_read, 0);
+        if (ret <= 0)
+        {
+            // connection closed by the client, the next read waits for a new one
+            tcp_close_client();
+            return PROTOCOL_STATUS_RECV_ERROR;
+        }
+        data_read += ret;
+    }
+    return STATUS_OK;
+}
+
+const struct protocol_transport g_tcp_transport = {
+    .name = "tcp",
+    .init = tcp_transport_init,
+    .write = tcp_transport_write,
+    .read = tcp_transport_read,
+};
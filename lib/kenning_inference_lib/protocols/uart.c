@@ -13,27 +13,209 @@
 #include <zephyr/drivers/uart.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+#include <zephyr/sys/ring_buffer.h>
+#endif // CONFIG_KENNING_UART_RX_IRQ
 #else // __UNIT_TEST__
 #include "mocks/kernel.h"
 #include "mocks/log.h"
+#include "mocks/ring_buffer.h"
 #include "mocks/uart.h"
 #endif
 
 LOG_MODULE_REGISTER(uart, CONFIG_UART_LOG_LEVEL);
 
-GENERATE_MODULE_STATUSES_STR(PROTOCOL);
-
 ut_static const struct device *const G_UART_DEV = DEVICE_DT_GET(UART_DEVICE_NODE);
 
 ut_static bool g_uart_initialized = false;
 
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+RING_BUF_DECLARE(g_uart_rx_ring_buf, CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE);
+K_SEM_DEFINE(g_uart_rx_sem, 0, 1);
+
+#ifdef CONFIG_KENNING_UART_HW_FLOW_CONTROL
+#define UART_RX_PAUSE_THRESHOLD CONFIG_KENNING_UART_RX_RTS_THRESHOLD
+#else // CONFIG_KENNING_UART_HW_FLOW_CONTROL
+#define UART_RX_PAUSE_THRESHOLD 0
+#endif // CONFIG_KENNING_UART_HW_FLOW_CONTROL
+
+// set by the ISR when RX interrupt was disabled because the ring buffer was (nearly) full
+static volatile bool g_uart_rx_paused = false;
+
+/**
+ * Stops draining the UART FIFO. Remaining bytes stay in the UART and, with hardware flow control enabled, RTS is
+ * deasserted so that the sender stops before the FIFO overflows
+ *
+ * @param dev UART device
+ */
+static void uart_rx_pause(const struct device *dev)
+{
+    uart_irq_rx_disable(dev);
+#if defined(CONFIG_KENNING_UART_HW_FLOW_CONTROL) && defined(CONFIG_UART_LINE_CTRL)
+    // UARTs with automatic RTS deassert it on their own when the FIFO fills up
+    uart_line_ctrl_set(dev, UART_LINE_CTRL_RTS, 0);
+#endif
+    g_uart_rx_paused = true;
+}
+
+/**
+ * Resumes reception paused with uart_rx_pause
+ *
+ * @param dev UART device
+ */
+static void uart_rx_resume(const struct device *dev)
+{
+    g_uart_rx_paused = false;
+#if defined(CONFIG_KENNING_UART_HW_FLOW_CONTROL) && defined(CONFIG_UART_LINE_CTRL)
+    uart_line_ctrl_set(dev, UART_LINE_CTRL_RTS, 1);
+#endif
+    uart_irq_rx_enable(dev);
+}
+
+/**
+ * UART interrupt handler, moves received bytes from UART FIFO to the ring buffer
+ *
+ * ISR is the only producer and the transport read or lease is the only consumer of the ring buffer, so no locking is
+ * needed.
+ *
+ * @param dev UART device
+ * @param user_data unused
+ */
+static void uart_rx_isr(const struct device *dev, void *user_data)
+{
+    ARG_UNUSED(user_data);
+
+    bool data_received = false;
+
+    if (!uart_irq_update(dev))
+    {
+        return;
+    }
+
+    while (uart_irq_rx_ready(dev))
+    {
+        if (ring_buf_space_get(&g_uart_rx_ring_buf) <= UART_RX_PAUSE_THRESHOLD)
+        {
+            uart_rx_pause(dev);
+            break;
+        }
+
+        uint8_t *rx_data = NULL;
+        uint32_t free_space = ring_buf_put_claim(&g_uart_rx_ring_buf, &rx_data, UINT32_MAX);
+        int rx_count = uart_fifo_read(dev, rx_data, free_space);
+
+        ring_buf_put_finish(&g_uart_rx_ring_buf, rx_count > 0 ? rx_count : 0);
+        if (rx_count <= 0)
+        {
+            break;
+        }
+        data_received = true;
+    }
+
+    if (data_received)
+    {
+        k_sem_give(&g_uart_rx_sem);
+    }
+}
+
+/**
+ * Resumes reception paused by the ISR if enough data was read from the ring buffer
+ */
+static void uart_rx_resume_if_drained()
+{
+    if (g_uart_rx_paused && ring_buf_space_get(&g_uart_rx_ring_buf) > UART_RX_PAUSE_THRESHOLD)
+    {
+        uart_rx_resume(G_UART_DEV);
+    }
+}
+
+/**
+ * Reads data received by the UART RX interrupt from the ring buffer
+ *
+ * @param data buffer for the data, if NULL then the data is discarded
+ * @param data_length number of bytes to read
+ *
+ * @returns status of the read
+ */
+static status_t uart_read_data_irq(uint8_t *data, size_t data_length)
+{
+    size_t data_read = 0;
+
+    while (data_read < data_length)
+    {
+        uint32_t chunk_size = ring_buf_get(&g_uart_rx_ring_buf, IS_VALID_POINTER(data) ? data + data_read : NULL,
+                                           data_length - data_read);
+        if (chunk_size > 0)
+        {
+            data_read += chunk_size;
+            uart_rx_resume_if_drained();
+            continue;
+        }
+        // the timeout is measured between consecutive bytes, same as in the polling mode
+        if (0 != k_sem_take(&g_uart_rx_sem, K_MSEC((int32_t)(UART_TIMEOUT_S * 1000))))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Leases contiguous data from the ring buffer, waits for data if the ring buffer is empty
+ *
+ * @param data leased data
+ * @param max_length maximum number of bytes to lease
+ * @param data_length number of leased bytes
+ *
+ * @returns status of the lease
+ */
+static status_t uart_transport_lease(const uint8_t **data, size_t max_length, size_t *data_length)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    while (true)
+    {
+        uint32_t chunk_size = ring_buf_get_claim(&g_uart_rx_ring_buf, (uint8_t **)data, max_length);
+        if (chunk_size > 0)
+        {
+            *data_length = chunk_size;
+            return STATUS_OK;
+        }
+        if (0 != k_sem_take(&g_uart_rx_sem, K_MSEC((int32_t)(UART_TIMEOUT_S * 1000))))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+}
+
+/**
+ * Frees leased data in the ring buffer
+ *
+ * @param data_length number of bytes consumed
+ *
+ * @returns status of the release
+ */
+static status_t uart_transport_release(size_t data_length)
+{
+    if (0 != ring_buf_get_finish(&g_uart_rx_ring_buf, data_length))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    uart_rx_resume_if_drained();
+    return STATUS_OK;
+}
+#endif // CONFIG_KENNING_UART_RX_IRQ
+
 #ifdef __UNIT_TEST__
 extern int64_t g_ticks;
 
 static int64_t k_uptime_get() { return g_ticks++; }
 #endif // __UNIT_TEST__
 
-status_t protocol_init()
+static status_t uart_transport_init()
 {
     if (g_uart_initialized)
     {
@@ -45,12 +227,44 @@ status_t protocol_init()
         return PROTOCOL_STATUS_ERROR;
     }
 
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+    ring_buf_reset(&g_uart_rx_ring_buf);
+    k_sem_reset(&g_uart_rx_sem);
+    g_uart_rx_paused = false;
+
+#ifdef CONFIG_KENNING_UART_HW_FLOW_CONTROL
+    struct uart_config config;
+
+    if (0 != uart_config_get(G_UART_DEV, &config))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    // flow control may be already enabled with `hw-flow-control` devicetree property
+    if (UART_CFG_FLOW_CTRL_RTS_CTS != config.flow_ctrl)
+    {
+        config.flow_ctrl = UART_CFG_FLOW_CTRL_RTS_CTS;
+        if (0 != uart_configure(G_UART_DEV, &config))
+        {
+            LOG_ERR("UART hardware flow control not supported");
+            return PROTOCOL_STATUS_ERROR;
+        }
+    }
+#endif // CONFIG_KENNING_UART_HW_FLOW_CONTROL
+
+    if (0 != uart_irq_callback_user_data_set(G_UART_DEV, uart_rx_isr, NULL))
+    {
+        LOG_ERR("UART interrupt-driven API not supported");
+        return PROTOCOL_STATUS_ERROR;
+    }
+    uart_irq_rx_enable(G_UART_DEV);
+#endif // CONFIG_KENNING_UART_RX_IRQ
+
     g_uart_initialized = true;
 
     return STATUS_OK;
 }
 
-status_t protocol_write_data(const uint8_t *data, size_t data_length)
+static status_t uart_transport_write(const uint8_t *data, size_t data_length)
 {
     if (!g_uart_initialized)
     {
@@ -70,7 +284,7 @@ status_t protocol_write_data(const uint8_t *data, size_t data_length)
     return status;
 }
 
-status_t protocol_read_data(uint8_t *data, size_t data_length)
+static status_t uart_transport_read(uint8_t *data, size_t data_length)
 {
     if (!g_uart_initialized)
     {
@@ -79,6 +293,9 @@ status_t protocol_read_data(uint8_t *data, size_t data_length)
 
     LOG_DBG("Reading %zu bytes from UART", data_length);
 
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+    return uart_read_data_irq(data, data_length);
+#else  // CONFIG_KENNING_UART_RX_IRQ
     size_t data_read = 0;
     int rx_status = 0;
     int64_t start_timer = k_uptime_get();
@@ -87,12 +304,12 @@ status_t protocol_read_data(uint8_t *data, size_t data_length)
     {
         uint8_t c = 0;
         rx_status = uart_poll_in(G_UART_DEV, &c);
-#ifdef CONFIG_NRF_UART_SLEEP_AFTER_POLL_WORKAROUND
+#ifdef CONFIG_KENNING_NRF_UART_SLEEP_AFTER_POLL_WORKAROUND
         if (0 == data_read % 128)
         {
             k_sleep(K_TICKS(1));
         }
-#endif // CONFIG_NRF_UART_SLEEP_AFTER_POLL_WORKAROUND
+#endif // CONFIG_KENNING_NRF_UART_SLEEP_AFTER_POLL_WORKAROUND
         if (0 == rx_status)
         {
             if (IS_VALID_POINTER(data))
@@ -116,4 +333,69 @@ status_t protocol_read_data(uint8_t *data, size_t data_length)
         }
     }
     return STATUS_OK;
+#endif // CONFIG_KENNING_UART_RX_IRQ
 }
+
+static status_t uart_transport_set_baudrate(uint32_t baudrate)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    struct uart_config config;
+
+    if (0 != uart_config_get(G_UART_DEV, &config))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    if (config.baudrate == baudrate)
+    {
+        return STATUS_OK;
+    }
+
+    // last characters written with uart_poll_out may still be in the shift register
+    k_busy_wait(2 * UART_CHAR_TIME_US(config.baudrate));
+
+    LOG_DBG("Changing UART baudrate from %u to %u", config.baudrate, baudrate);
+
+    config.baudrate = baudrate;
+    if (0 != uart_configure(G_UART_DEV, &config))
+    {
+        LOG_ERR("UART baudrate %u not supported", baudrate);
+        return PROTOCOL_STATUS_INV_ARG_BAUDRATE;
+    }
+    return STATUS_OK;
+}
+
+static status_t uart_transport_get_baudrate(uint32_t *baudrate)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    RETURN_ERROR_IF_POINTER_INVALID(baudrate, PROTOCOL_STATUS_INV_PTR);
+
+    struct uart_config config;
+
+    if (0 != uart_config_get(G_UART_DEV, &config))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    *baudrate = config.baudrate;
+    return STATUS_OK;
+}
+
+const struct protocol_transport g_uart_transport = {
+    .name = "uart",
+    .init = uart_transport_init,
+    .write = uart_transport_write,
+    .read = uart_transport_read,
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+    .lease = uart_transport_lease,
+    .release = uart_transport_release,
+#endif // CONFIG_KENNING_UART_RX_IRQ
+    .set_baudrate = uart_transport_set_baudrate,
+    .get_baudrate = uart_transport_get_baudrate,
+};
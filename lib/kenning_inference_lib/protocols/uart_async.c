@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kenning_inference_lib/core/protocol.h"
+#include "uart_config.h"
+#include <stdbool.h>
+#include <string.h>
+
+#ifndef __UNIT_TEST__
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/ring_buffer.h>
+#else // __UNIT_TEST__
+#include "mocks/kernel.h"
+#include "mocks/log.h"
+#include "mocks/ring_buffer.h"
+#include "mocks/uart.h"
+#endif
+
+LOG_MODULE_REGISTER(uart_async, CONFIG_UART_LOG_LEVEL);
+
+#define UART_ASYNC_RX_BUF_COUNT 2
+
+ut_static const struct device *const G_UART_DEV = DEVICE_DT_GET(UART_DEVICE_NODE);
+
+ut_static bool g_uart_initialized = false;
+
+// RX buffers handed to the driver, one is filled by DMA while the other one is queued
+ut_static uint8_t g_uart_rx_bufs[UART_ASYNC_RX_BUF_COUNT][CONFIG_KENNING_UART_ASYNC_RX_BUFFER_SIZE];
+static uint8_t g_uart_next_rx_buf = 0;
+
+RING_BUF_DECLARE(g_uart_rx_ring_buf, CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE);
+K_SEM_DEFINE(g_uart_rx_sem, 0, 1);
+K_SEM_DEFINE(g_uart_tx_done_sem, 0, 1);
+K_SEM_DEFINE(g_uart_rx_disabled_sem, 0, 1);
+
+// set while UART is reconfigured, prevents the callback from restarting reception
+static volatile bool g_uart_rx_paused = false;
+
+// set by the callback when received data did not fit in the ring buffer
+static volatile bool g_uart_rx_overflow = false;
+static volatile int g_uart_tx_result = 0;
+
+// current baudrate, used to limit the time of waiting for the end of transmission
+static uint32_t g_uart_baudrate = UART_ASYNC_TX_DEFAULT_BAUDRATE;
+
+/**
+ * Enables UART reception into the first RX buffer
+ *
+ * @returns status of the operation
+ */
+static status_t uart_async_rx_start()
+{
+    g_uart_next_rx_buf = 1;
+    if (0 != uart_rx_enable(G_UART_DEV, g_uart_rx_bufs[0], sizeof(g_uart_rx_bufs[0]), UART_ASYNC_RX_TIMEOUT_US))
+    {
+        return PROTOCOL_STATUS_RECV_ERROR;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * UART asynchronous API events handler
+ *
+ * @param dev UART device
+ * @param evt UART event
+ * @param user_data unused
+ */
+static void uart_async_callback(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+    ARG_UNUSED(user_data);
+
+    switch (evt->type)
+    {
+    case UART_TX_DONE:
+        g_uart_tx_result = 0;
+        k_sem_give(&g_uart_tx_done_sem);
+        break;
+    case UART_TX_ABORTED:
+        g_uart_tx_result = -ECANCELED;
+        k_sem_give(&g_uart_tx_done_sem);
+        break;
+    case UART_RX_RDY:
+        if (ring_buf_put(&g_uart_rx_ring_buf, evt->data.rx.buf + evt->data.rx.offset, evt->data.rx.len) <
+            evt->data.rx.len)
+        {
+            g_uart_rx_overflow = true;
+        }
+        k_sem_give(&g_uart_rx_sem);
+        break;
+    case UART_RX_BUF_REQUEST:
+        uart_rx_buf_rsp(dev, g_uart_rx_bufs[g_uart_next_rx_buf], sizeof(g_uart_rx_bufs[0]));
+        g_uart_next_rx_buf = (g_uart_next_rx_buf + 1) % UART_ASYNC_RX_BUF_COUNT;
+        break;
+    case UART_RX_DISABLED:
+        if (g_uart_rx_paused)
+        {
+            k_sem_give(&g_uart_rx_disabled_sem);
+            break;
+        }
+        // reception stops after a line error or when both buffers were filled before a new one was provided
+        uart_async_rx_start();
+        break;
+    case UART_RX_STOPPED:
+        LOG_WRN("UART RX stopped, reason: %d", evt->data.rx_stop.reason);
+        break;
+    default:
+        break;
+    }
+}
+
+static status_t uart_async_transport_init()
+{
+    if (g_uart_initialized)
+    {
+        return STATUS_OK;
+    }
+
+    if (!device_is_ready(G_UART_DEV))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    if (0 != uart_callback_set(G_UART_DEV, uart_async_callback, NULL))
+    {
+        LOG_ERR("UART asynchronous API not supported");
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    struct uart_config config;
+
+    g_uart_baudrate = UART_ASYNC_TX_DEFAULT_BAUDRATE;
+    if (0 == uart_config_get(G_UART_DEV, &config) && config.baudrate > 0)
+    {
+        g_uart_baudrate = config.baudrate;
+    }
+
+    ring_buf_reset(&g_uart_rx_ring_buf);
+    g_uart_rx_overflow = false;
+
+    RETURN_ON_ERROR(uart_async_rx_start(), PROTOCOL_STATUS_ERROR);
+
+    g_uart_initialized = true;
+
+    return STATUS_OK;
+}
+
+static status_t uart_async_transport_write(const uint8_t *data, size_t data_length)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    RETURN_ERROR_IF_POINTER_INVALID(data, PROTOCOL_STATUS_INV_PTR);
+
+    LOG_DBG("Writing %zu bytes to UART", data_length);
+
+    if (0 == data_length)
+    {
+        return STATUS_OK;
+    }
+
+    k_sem_reset(&g_uart_tx_done_sem);
+
+    if (0 != uart_tx(G_UART_DEV, data, data_length, SYS_FOREVER_US))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    // data buffer has to stay valid until the transfer is finished, so transfer stalled e.g. by flow control is aborted
+    if (0 != k_sem_take(&g_uart_tx_done_sem, K_MSEC(UART_ASYNC_TX_TIMEOUT_MS(g_uart_baudrate, data_length))))
+    {
+        LOG_ERR("UART TX timeout");
+        if (0 == uart_tx_abort(G_UART_DEV))
+        {
+            k_sem_take(&g_uart_tx_done_sem, K_MSEC((int32_t)(UART_TIMEOUT_S * 1000)));
+        }
+        return PROTOCOL_STATUS_TIMEOUT;
+    }
+
+    if (0 != g_uart_tx_result)
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    return STATUS_OK;
+}
+
+static status_t uart_async_transport_read(uint8_t *data, size_t data_length)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    LOG_DBG("Reading %zu bytes from UART", data_length);
+
+    size_t data_read = 0;
+
+    while (data_read < data_length)
+    {
+        if (g_uart_rx_overflow)
+        {
+            g_uart_rx_overflow = false;
+            LOG_ERR("UART RX ring buffer overflow");
+            return PROTOCOL_STATUS_RECV_ERROR;
+        }
+
+        uint32_t chunk_size = ring_buf_get(&g_uart_rx_ring_buf, IS_VALID_POINTER(data) ? data + data_read : NULL,
+                                           data_length - data_read);
+        if (chunk_size > 0)
+        {
+            data_read += chunk_size;
+            continue;
+        }
+        // the timeout is measured between consecutive chunks of data, same as in the polling mode
+        if (0 != k_sem_take(&g_uart_rx_sem, K_MSEC((int32_t)(UART_TIMEOUT_S * 1000))))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Leases contiguous data from the ring buffer, waits for data if the ring buffer is empty
+ *
+ * @param data leased data
+ * @param max_length maximum number of bytes to lease
+ * @param data_length number of leased bytes
+ *
+ * @returns status of the lease
+ */
+static status_t uart_async_transport_lease(const uint8_t **data, size_t max_length, size_t *data_length)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    while (true)
+    {
+        if (g_uart_rx_overflow)
+        {
+            g_uart_rx_overflow = false;
+            LOG_ERR("UART RX ring buffer overflow");
+            return PROTOCOL_STATUS_RECV_ERROR;
+        }
+
+        uint32_t chunk_size = ring_buf_get_claim(&g_uart_rx_ring_buf, (uint8_t **)data, max_length);
+        if (chunk_size > 0)
+        {
+            *data_length = chunk_size;
+            return STATUS_OK;
+        }
+        if (0 != k_sem_take(&g_uart_rx_sem, K_MSEC((int32_t)(UART_TIMEOUT_S * 1000))))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+}
+
+/**
+ * Frees leased data in the ring buffer
+ *
+ * @param data_length number of bytes consumed
+ *
+ * @returns status of the release
+ */
+static status_t uart_async_transport_release(size_t data_length)
+{
+    if (0 != ring_buf_get_finish(&g_uart_rx_ring_buf, data_length))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    return STATUS_OK;
+}
+
+static status_t uart_async_transport_set_baudrate(uint32_t baudrate)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    struct uart_config config;
+    status_t status = STATUS_OK;
+
+    if (0 != uart_config_get(G_UART_DEV, &config))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    if (config.baudrate == baudrate)
+    {
+        return STATUS_OK;
+    }
+
+    // TX_DONE may be reported before the last characters leave the shift register
+    k_busy_wait(2 * UART_CHAR_TIME_US(config.baudrate));
+
+    LOG_DBG("Changing UART baudrate from %u to %u", config.baudrate, baudrate);
+
+    // most drivers do not allow reconfiguration while reception is active
+    g_uart_rx_paused = true;
+    k_sem_reset(&g_uart_rx_disabled_sem);
+    if (0 == uart_rx_disable(G_UART_DEV))
+    {
+        k_sem_take(&g_uart_rx_disabled_sem, K_MSEC((int32_t)(UART_TIMEOUT_S * 1000)));
+    }
+
+    config.baudrate = baudrate;
+    if (0 != uart_configure(G_UART_DEV, &config))
+    {
+        LOG_ERR("UART baudrate %u not supported", baudrate);
+        status = PROTOCOL_STATUS_INV_ARG_BAUDRATE;
+    }
+    else
+    {
+        g_uart_baudrate = baudrate;
+    }
+
+    g_uart_rx_paused = false;
+    RETURN_ON_ERROR(uart_async_rx_start(), PROTOCOL_STATUS_RECV_ERROR);
+
+    return status;
+}
+
+static status_t uart_async_transport_get_baudrate(uint32_t *baudrate)
+{
+    if (!g_uart_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    RETURN_ERROR_IF_POINTER_INVALID(baudrate, PROTOCOL_STATUS_INV_PTR);
+
+    struct uart_config config;
+
+    if (0 != uart_config_get(G_UART_DEV, &config))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    *baudrate = config.baudrate;
+    return STATUS_OK;
+}
+
+const struct protocol_transport g_uart_async_transport = {
+    .name = "uart_async",
+    .init = uart_async_transport_init,
+    .write = uart_async_transport_write,
+    .read = uart_async_transport_read,
+    .lease = uart_async_transport_lease,
+    .release = uart_async_transport_release,
+    .set_baudrate = uart_async_transport_set_baudrate,
+    .get_baudrate = uart_async_transport_get_baudrate,
+};
@@ -9,5 +9,10 @@
 
 #define UART_DEVICE_NODE DT_ALIAS(kcomms)
 #define UART_TIMEOUT_S (0.5F) /* UART read timeout (500 ms) */
+#define UART_CHAR_TIME_US(baudrate) (10 * 1000000 / (baudrate)) /* duration of 8N1 character transmission */
+#define UART_ASYNC_RX_TIMEOUT_US (100) /* inactivity time after which received data is reported by the driver */
+#define UART_ASYNC_TX_DEFAULT_BAUDRATE (9600) /* baudrate assumed for TX timeout if it cannot be read from the driver */
+#define UART_ASYNC_TX_TIMEOUT_MS(baudrate, length) /* transmission time of the data increased by the read timeout */ \
+    ((int32_t)(UART_TIMEOUT_S * 1000) + (int32_t)((length) * UART_CHAR_TIME_US(baudrate) / 1000))
 
 #endif // KENNING_INFERENCE_LIB_PROTOCOLS_UART_CONFIG_H_
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kenning_inference_lib/core/protocol.h"
+#include <stdbool.h>
+
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/ring_buffer.h>
+
+LOG_MODULE_REGISTER(kenning_usb, CONFIG_KENNING_USB_LOG_LEVEL);
+
+#define USB_TIMEOUT_MS (500)  /* timeout between consecutive chunks of data, same as in UART */
+#define USB_PACKET_SIZE (64) /* size of full-speed bulk endpoint packet */
+
+static const struct device *const G_USB_DEV = DEVICE_DT_GET_ONE(zephyr_cdc_acm_uart);
+
+static bool g_usb_initialized = false;
+
+RING_BUF_DECLARE(g_usb_rx_ring_buf, CONFIG_KENNING_USB_RX_RING_BUFFER_SIZE);
+RING_BUF_DECLARE(g_usb_tx_ring_buf, CONFIG_KENNING_USB_TX_RING_BUFFER_SIZE);
+K_SEM_DEFINE(g_usb_rx_sem, 0, 1);
+K_SEM_DEFINE(g_usb_tx_sem, 0, 1);
+
+// set by the ISR when there is no space for a whole packet in the RX ring buffer, the host is NAKed until data is read
+static volatile bool g_usb_rx_paused = false;
+
+/**
+ * CDC-ACM interrupt handler, moves received packets to the RX ring buffer and data to be sent from the TX ring buffer
+ *
+ * ISR is the only producer of RX data and the only consumer of TX data, so no locking is needed.
+ *
+ * @param dev CDC-ACM UART device
+ * @param user_data unused
+ */
+static void usb_isr(const struct device *dev, void *user_data)
+{
+    ARG_UNUSED(user_data);
+
+    bool data_received = false;
+
+    if (!uart_irq_update(dev))
+    {
+        return;
+    }
+
+    while (uart_irq_rx_ready(dev))
+    {
+        if (ring_buf_space_get(&g_usb_rx_ring_buf) < USB_PACKET_SIZE)
+        {
+            uart_irq_rx_disable(dev);
+            g_usb_rx_paused = true;
+            break;
+        }
+
+        uint8_t *rx_data = NULL;
+        uint32_t free_space = ring_buf_put_claim(&g_usb_rx_ring_buf, &rx_data, UINT32_MAX);
+        int rx_count = uart_fifo_read(dev, rx_data, free_space);
+
+        ring_buf_put_finish(&g_usb_rx_ring_buf, rx_count > 0 ? rx_count : 0);
+        if (rx_count <= 0)
+        {
+            break;
+        }
+        data_received = true;
+    }
+
+    if (uart_irq_tx_ready(dev))
+    {
+        uint8_t *tx_data = NULL;
+        uint32_t tx_size = ring_buf_get_claim(&g_usb_tx_ring_buf, &tx_data, UINT32_MAX);
+
+        if (0 == tx_size)
+        {
+            uart_irq_tx_disable(dev);
+        }
+        else
+        {
+            int tx_count = uart_fifo_fill(dev, tx_data, tx_size);
+            ring_buf_get_finish(&g_usb_tx_ring_buf, tx_count > 0 ? tx_count : 0);
+        }
+        k_sem_give(&g_usb_tx_sem);
+    }
+
+    if (data_received)
+    {
+        k_sem_give(&g_usb_rx_sem);
+    }
+}
+
+/**
+ * Resumes reception paused by the ISR if there is space for a whole packet in the RX ring buffer
+ */
+static void usb_rx_resume_if_drained()
+{
+    if (g_usb_rx_paused && ring_buf_space_get(&g_usb_rx_ring_buf) >= USB_PACKET_SIZE)
+    {
+        g_usb_rx_paused = false;
+        uart_irq_rx_enable(G_USB_DEV);
+    }
+}
+
+static status_t usb_transport_init()
+{
+    if (g_usb_initialized)
+    {
+        return STATUS_OK;
+    }
+
+    if (!device_is_ready(G_USB_DEV))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+
+    ring_buf_reset(&g_usb_rx_ring_buf);
+    ring_buf_reset(&g_usb_tx_ring_buf);
+    k_sem_reset(&g_usb_rx_sem);
+    k_sem_reset(&g_usb_tx_sem);
+    g_usb_rx_paused = false;
+
+    if (0 != uart_irq_callback_user_data_set(G_USB_DEV, usb_isr, NULL))
+    {
+        LOG_ERR("CDC-ACM interrupt-driven API not supported");
+        return PROTOCOL_STATUS_ERROR;
+    }
+    uart_irq_rx_enable(G_USB_DEV);
+
+    g_usb_initialized = true;
+
+    return STATUS_OK;
+}
+
+static status_t usb_transport_write(const uint8_t *data, size_t data_length)
+{
+    size_t data_written = 0;
+
+    if (!g_usb_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    RETURN_ERROR_IF_POINTER_INVALID(data, PROTOCOL_STATUS_INV_PTR);
+
+    LOG_DBG("Writing %zu bytes to USB", data_length);
+
+    while (data_written < data_length)
+    {
+        data_written += ring_buf_put(&g_usb_tx_ring_buf, data + data_written, data_length - data_written);
+        uart_irq_tx_enable(G_USB_DEV);
+
+        // data is sent by the ISR, wait for space in the ring buffer only if the rest of the data does not fit
+        if (data_written < data_length && 0 != k_sem_take(&g_usb_tx_sem, K_MSEC(USB_TIMEOUT_MS)))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+static status_t usb_transport_flush()
+{
+    if (!g_usb_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    while (!ring_buf_is_empty(&g_usb_tx_ring_buf))
+    {
+        if (0 != k_sem_take(&g_usb_tx_sem, K_MSEC(USB_TIMEOUT_MS)))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+static status_t usb_transport_read(uint8_t *data, size_t data_length)
+{
+    size_t data_read = 0;
+
+    if (!g_usb_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    LOG_DBG("Reading %zu bytes from USB", data_length);
+
+    while (data_read < data_length)
+    {
+        uint32_t chunk_size = ring_buf_get(&g_usb_rx_ring_buf, IS_VALID_POINTER(data) ? data + data_read : NULL,
+                                           data_length - data_read);
+        if (chunk_size > 0)
+        {
+            data_read += chunk_size;
+            usb_rx_resume_if_drained();
+            continue;
+        }
+        if (0 != k_sem_take(&g_usb_rx_sem, K_MSEC(USB_TIMEOUT_MS)))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+/**
+ * Leases contiguous data from the RX ring buffer, waits for data if the ring buffer is empty
+ *
+ * @param data leased data
+ * @param max_length maximum number of bytes to lease
+ * @param data_length number of leased bytes
+ *
+ * @returns status of the lease
+ */
+static status_t usb_transport_lease(const uint8_t **data, size_t max_length, size_t *data_length)
+{
+    if (!g_usb_initialized)
+    {
+        return PROTOCOL_STATUS_UNINIT;
+    }
+
+    while (true)
+    {
+        uint32_t chunk_size = ring_buf_get_claim(&g_usb_rx_ring_buf, (uint8_t **)data, max_length);
+        if (chunk_size > 0)
+        {
+            *data_length = chunk_size;
+            return STATUS_OK;
+        }
+        if (0 != k_sem_take(&g_usb_rx_sem, K_MSEC(USB_TIMEOUT_MS)))
+        {
+            return PROTOCOL_STATUS_TIMEOUT;
+        }
+    }
+}
+
+/**
+ * Frees leased data in the RX ring buffer
+ *
+ * @param data_length number of bytes consumed
+ *
+ * @returns status of the release
+ */
+static status_t usb_transport_release(size_t data_length)
+{
+    if (0 != ring_buf_get_finish(&g_usb_rx_ring_buf, data_length))
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    usb_rx_resume_if_drained();
+    return STATUS_OK;
+}
+
+const struct protocol_transport g_usb_cdc_acm_transport = {
+    .name = "usb_cdc_acm",
+    .init = usb_transport_init,
+    .write = usb_transport_write,
+    .read = usb_transport_read,
+    .flush = usb_transport_flush,
+    .lease = usb_transport_lease,
+    .release = usb_transport_release,
+};
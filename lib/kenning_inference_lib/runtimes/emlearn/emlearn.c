@@ -69,6 +69,20 @@ status_t runtime_get_model_output(uint8_t *model_output)
     return STATUS_OK;
 }
 
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    RETURN_ERROR_IF_POINTER_INVALID(views, RUNTIME_WRAPPER_STATUS_INV_PTR);
+    RETURN_ERROR_IF_POINTER_INVALID(num_views, RUNTIME_WRAPPER_STATUS_INV_PTR);
+    if (max_views < 1)
+    {
+        return RUNTIME_WRAPPER_STATUS_INV_ARG;
+    }
+    views[0].data = gp_emlearn_output_buffer;
+    model_get_output_size(&views[0].size);
+    *num_views = 1;
+    return STATUS_OK;
+}
+
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size)
 {
@@ -340,6 +340,26 @@ status_t runtime_get_model_output(uint8_t *model_output)
     return STATUS_OK;
 }
 
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    RETURN_ERROR_IF_POINTER_INVALID(views, RUNTIME_WRAPPER_STATUS_INV_PTR);
+    RETURN_ERROR_IF_POINTER_INVALID(num_views, RUNTIME_WRAPPER_STATUS_INV_PTR);
+    if (max_views < g_model_spec.num_output)
+    {
+        return RUNTIME_WRAPPER_STATUS_INV_ARG;
+    }
+    for (unsigned int i = 0; i < g_model_spec.num_output; i++)
+    {
+        EValue output = gp_method->get_output(i);
+        RETURN_IF_FALSE_LOG(output.isTensor(), RUNTIME_WRAPPER_STATUS_ERROR, "Error retrieving output %d.", i);
+        views[i].data = output.toTensor().const_data_ptr<uint8_t>();
+        views[i].size = model_spec_output_length(&g_model_spec, i) *
+                        ((g_model_spec.output_data_type[i].bits - 1) / KENNING_BITS_PER_BYTE + 1);
+    }
+    *num_views = g_model_spec.num_output;
+    return STATUS_OK;
+}
+
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size)
 {
@@ -302,6 +302,37 @@ status_t prepare_input_buffer(const uint8_t *model_input)
     return STATUS_OK;
 }
 
+/**
+ * Writes model input to the buffers prepared for the previous input, so they do not have to be allocated again
+ *
+ * @param model_input model input
+ *
+ * @returns status of the runtime
+ */
+static status_t update_input_buffer(const uint8_t *model_input)
+{
+    iree_status_t iree_status = iree_ok_status();
+    size_t offset = 0;
+
+    for (int i = 0; i < g_model_spec.num_input; ++i)
+    {
+        iree_hal_buffer_view_t *arg_buffer_view = iree_vm_list_get_buffer_view_assign(gp_model_inputs, i);
+        size_t size =
+            compute_structure_size_bytes(model_spec_input_length(&g_model_spec, i), g_model_spec.input_data_type[i]);
+
+        if (NULL == arg_buffer_view)
+        {
+            return RUNTIME_WRAPPER_STATUS_INV_PTR;
+        }
+        iree_status = iree_hal_buffer_map_write(iree_hal_buffer_view_buffer(arg_buffer_view), 0, model_input + offset,
+                                                size);
+        CHECK_IREE_STATUS(iree_status);
+        offset += size;
+    }
+
+    return STATUS_OK;
+}
+
 status_t prepare_output_buffer()
 {
     iree_status_t iree_status = iree_ok_status();
@@ -408,12 +439,20 @@ status_t runtime_init_input()
 {
     status_t status = STATUS_OK;
 
-    // free resources
-    release_input_buffer();
+    // buffers are released when the model changes, otherwise only their contents have to be updated
+    if (NULL != gp_model_inputs)
+    {
+        return update_input_buffer(gp_iree_input_buffer);
+    }
 
     // setup buffers for inputs
     status = prepare_input_buffer(gp_iree_input_buffer);
-    RETURN_ON_ERROR(status, status);
+    if (STATUS_OK != status)
+    {
+        // partially prepared buffers cannot be updated
+        release_input_buffer();
+        return status;
+    }
 
     return STATUS_OK;
 }
@@ -492,6 +531,12 @@ status_t runtime_get_model_output(uint8_t *model_output)
     return STATUS_OK;
 }
 
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    // output buffers are mapped only for the duration of the copy, so their memory cannot be exposed
+    return RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED;
+}
+
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size)
 {
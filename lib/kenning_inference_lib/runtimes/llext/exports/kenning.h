@@ -23,5 +23,10 @@ EXPORT_SYMBOL(g_ldr_tables);
 EXPORT_SYMBOL(buf_save);
 EXPORT_SYMBOL(buf_save_one);
 EXPORT_SYMBOL(buf_reset);
+EXPORT_SYMBOL(buf_rewind);
+EXPORT_SYMBOL(buf_lease_window);
+EXPORT_SYMBOL(buf_commit_window);
+
+EXPORT_SYMBOL(runtime_cancel_requested);
 
 #endif // KENNING_INFERENCE_LIB_RUNTIMES_LLEXT_EXPORTS_KENNING_H_
@@ -73,6 +73,19 @@ status_t runtime_get_model_output(uint8_t *model_output)
     return p_func(model_output);
 }
 
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    CHECK_RUNTIME_LLEXT_LOADED_RET(gp_llext_runtime);
+    runtime_get_output_view_ptr_t p_func = llext_find_sym(&gp_llext_runtime->exp_tab, "runtime_get_output_view");
+    // runtimes built without output views fall back to copying the output
+    if (!IS_VALID_POINTER(p_func))
+    {
+        return RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED;
+    }
+
+    return p_func(max_views, views, num_views);
+}
+
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size)
 {
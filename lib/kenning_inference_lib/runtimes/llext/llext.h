@@ -7,6 +7,7 @@
 #ifndef KENNING_INFERENCE_LIB_RUNTIMES_LLEXT_H_
 #define KENNING_INFERENCE_LIB_RUNTIMES_LLEXT_H_
 
+#include <kenning_inference_lib/core/runtime_wrapper.h>
 #include <kenning_inference_lib/core/utils.h>
 
 #define CHECK_RUNTIME_LLEXT_LOADED_RET(p_llext) \
@@ -35,6 +36,8 @@ typedef status_t (*runtime_init_input_ptr_t)(void);
 typedef status_t (*runtime_run_model_ptr_t)(void);
 typedef status_t (*runtime_run_model_bench_ptr_t)(void);
 typedef status_t (*runtime_get_model_output_ptr_t)(uint8_t *model_output);
+typedef status_t (*runtime_get_output_view_ptr_t)(const size_t max_views, runtime_output_view_t *views,
+                                                  size_t *num_views);
 typedef status_t (*runtime_get_statistics_ptr_t)(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                                  size_t *statistics_size);
 
@@ -20,6 +20,11 @@ status_t runtime_run_model() { return STATUS_OK; }
 
 status_t runtime_get_model_output(uint8_t *model_output) { return STATUS_OK; }
 
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    return RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED;
+}
+
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size)
 {
@@ -10,15 +10,25 @@ extern "C"
 #include "kenning_inference_lib/core/runtime_wrapper.h"
 }
 
+#include <array>
+#include <utility>
+
+#ifndef __UNIT_TEST__
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
+#include <tensorflow/lite/micro/micro_op_resolver.h>
 #include <tensorflow/lite/micro/system_setup.h>
 #include <tensorflow/lite/schema/schema_generated.h>
 
 #include "generated/ops_resolver.h"
+#else // __UNIT_TEST__
+#include "mocks/kernel.h"
+#include "mocks/log.h"
+#include "mocks/tflite.h"
+#endif
 
 LOG_MODULE_REGISTER(tflite_runtime, CONFIG_RUNTIME_WRAPPER_LOG_LEVEL);
 
@@ -28,19 +38,140 @@ static runtime_statistics_execution_time_t gp_tflite_time_stats;
 static uint64_t g_peak_allocation;
 
 extern tflite::MicroMutableOpResolver<TFLITE_RESOLVER_SIZE> g_tflite_resolver;
-static tflite::MicroInterpreter *gp_tflite_interpreter = nullptr;
+ut_static tflite::MicroInterpreter *gp_tflite_interpreter = nullptr;
+
+#ifdef CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
+#define TFLITE_MODEL_SLOTS 2
+#else  // CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
+#define TFLITE_MODEL_SLOTS 1
+#endif // CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
+#define TFLITE_BUFFER_SIZE (CONFIG_KENNING_TFLITE_BUFFER_SIZE * 1024)
+
+// each slot holds a model followed by its tensor arena and the interpreter created for it
+ut_static uint8_t __attribute__((aligned(8))) g_tflite_buffer[TFLITE_MODEL_SLOTS][TFLITE_BUFFER_SIZE];
+alignas(tflite::MicroInterpreter) static uint8_t
+    g_tflite_interpreters[TFLITE_MODEL_SLOTS][sizeof(tflite::MicroInterpreter)];
+// slot of the interpreter serving inferences
+ut_static size_t g_active_slot = 0;
+// size of the model in the active slot
+ut_static size_t g_active_model_size = 0;
+
+typedef TfLiteStatus (*tflite_invoke_t)(TfLiteContext *, TfLiteNode *);
+
+// registrations of g_tflite_resolver with invoke functions replaced by cancellable_invoke
+static TFLMRegistration g_cancellable_registrations[TFLITE_RESOLVER_SIZE];
+static const TFLMRegistration *gp_wrapped_registrations[TFLITE_RESOLVER_SIZE];
+static size_t g_cancellable_registrations_count = 0;
+
+/**
+ * Invokes operator of the I-th cancellable registration unless cancellation of the inference was requested, in which
+ * case the interpreter aborts the inference
+ */
+template <size_t I> static TfLiteStatus cancellable_invoke(TfLiteContext *context, TfLiteNode *node)
+{
+    if (runtime_cancel_requested())
+    {
+        return kTfLiteError;
+    }
+    return gp_wrapped_registrations[I]->invoke(context, node);
+}
+
+template <size_t... I>
+static constexpr std::array<tflite_invoke_t, sizeof...(I)> make_cancellable_invokes(std::index_sequence<I...>)
+{
+    return {cancellable_invoke<I>...};
+}
 
-static uint8_t __attribute__((aligned(8))) g_tflite_buffer[CONFIG_KENNING_TFLITE_BUFFER_SIZE * 1024];
+static const std::array<tflite_invoke_t, TFLITE_RESOLVER_SIZE> g_cancellable_invokes =
+    make_cancellable_invokes(std::make_index_sequence<TFLITE_RESOLVER_SIZE>());
 
-status_t tflite_reset_buf(struct msg_loader *ldr)
+/**
+ * Op resolver passing registrations of g_tflite_resolver to the interpreter with invoke functions wrapped, so that
+ * the inference can be cancelled between operators
+ */
+class CancellableOpResolver : public tflite::MicroOpResolver
 {
-    ldr->written = 0;
+  public:
+    const TFLMRegistration *FindOp(tflite::BuiltinOperator op) const override
+    {
+        return wrap(g_tflite_resolver.FindOp(op));
+    }
+
+    const TFLMRegistration *FindOp(const char *op) const override { return wrap(g_tflite_resolver.FindOp(op)); }
 
+    tflite::TfLiteBridgeBuiltinParseFunction GetOpDataParser(tflite::BuiltinOperator op) const override
+    {
+        return g_tflite_resolver.GetOpDataParser(op);
+    }
+
+  private:
+    static const TFLMRegistration *wrap(const TFLMRegistration *registration)
+    {
+        if (nullptr == registration || nullptr == registration->invoke)
+        {
+            return registration;
+        }
+        for (size_t i = 0; i < g_cancellable_registrations_count; i++)
+        {
+            if (gp_wrapped_registrations[i] == registration)
+            {
+                return &g_cancellable_registrations[i];
+            }
+        }
+        if (g_cancellable_registrations_count >= TFLITE_RESOLVER_SIZE)
+        {
+            return registration;
+        }
+        size_t idx = g_cancellable_registrations_count++;
+        gp_wrapped_registrations[idx] = registration;
+        g_cancellable_registrations[idx] = *registration;
+        g_cancellable_registrations[idx].invoke = g_cancellable_invokes[idx];
+        return &g_cancellable_registrations[idx];
+    }
+};
+
+static CancellableOpResolver g_cancellable_resolver;
+
+/**
+ * Destroys interpreter serving inferences
+ */
+static void tflite_destroy_interpreter()
+{
     if (gp_tflite_interpreter != NULL)
     {
         gp_tflite_interpreter->~MicroInterpreter();
         gp_tflite_interpreter = NULL;
     }
+}
+
+/**
+ * Points model loader back at the model serving inferences, so that data left in the shadow slot by a model that
+ * failed to load is neither patched nor swapped in
+ *
+ * @param ldr model loader
+ */
+static void tflite_restore_active_model(struct msg_loader *ldr)
+{
+#ifdef CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
+    if (ldr->addr != g_tflite_buffer[g_active_slot])
+    {
+        ldr->addr = g_tflite_buffer[g_active_slot];
+        ldr->written = g_active_model_size;
+        LOG_WRN("Model in slot %zu discarded", 1 - g_active_slot);
+    }
+#endif // CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
+}
+
+status_t tflite_reset_buf(struct msg_loader *ldr)
+{
+    ldr->written = 0;
+
+#ifdef CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
+    // new model is received to the other slot, so the current one keeps serving until it is swapped
+    ldr->addr = g_tflite_buffer[1 - g_active_slot];
+#else  // CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
+    tflite_destroy_interpreter();
+#endif // CONFIG_KENNING_TFLITE_SHADOW_MODEL_SLOT
 
     return STATUS_OK;
 }
@@ -48,7 +179,7 @@ status_t tflite_reset_buf(struct msg_loader *ldr)
 status_t prepare_tflite_ldr_table()
 {
     static struct msg_loader msg_loader_model =
-        MSG_LOADER_BUF_RESET(g_tflite_buffer, CONFIG_KENNING_TFLITE_BUFFER_SIZE * 1024, tflite_reset_buf);
+        MSG_LOADER_BUF_RESET(g_tflite_buffer[0], TFLITE_BUFFER_SIZE, tflite_reset_buf);
 
     static struct msg_loader msg_loader_input = MSG_LOADER_BUF(NULL, 0);
     memset(&g_ldr_tables[1], 0, NUM_LOADER_TYPES * sizeof(struct msg_loader *));
@@ -63,6 +194,7 @@ status_t runtime_init()
 {
     prepare_tflite_ldr_table();
     tflite_initialize_resolver();
+    g_cancellable_registrations_count = 0;
     g_peak_allocation = 0;
     return STATUS_OK;
 }
@@ -75,10 +207,13 @@ status_t runtime_init_weights()
     struct msg_loader *msg_loader_model = g_ldr_tables[1][LOADER_TYPE_MODEL];
     struct msg_loader *msg_loader_input = g_ldr_tables[1][LOADER_TYPE_DATA];
 
+    // model is initialized in the slot it was received to
+    size_t slot = ((uint8_t *)msg_loader_model->addr - g_tflite_buffer[0]) / TFLITE_BUFFER_SIZE;
     size_t model_size = msg_loader_model->written;
-    uint8_t *modelWeights = g_tflite_buffer;
-    uint8_t *tensorArena = g_tflite_buffer + model_size;
-    size_t tensorArenaSize = CONFIG_KENNING_TFLITE_BUFFER_SIZE * 1024 - model_size;
+    uint8_t *modelWeights = g_tflite_buffer[slot];
+    uint8_t *tensorArena = g_tflite_buffer[slot] + model_size;
+    size_t tensorArenaSize = TFLITE_BUFFER_SIZE - model_size;
+    tflite::MicroInterpreter *interpreter = (tflite::MicroInterpreter *)g_tflite_interpreters[slot];
 
     const tflite::Model *model = NULL;
     ZPL_MARK_CODE_SCOPE(tflm_create_model) { model = tflite::GetModel(modelWeights); }
@@ -87,33 +222,42 @@ status_t runtime_init_weights()
     {
         LOG_ERR("Model provided is schema version %d not equal to supported version %d.\n", model->version(),
                 TFLITE_SCHEMA_VERSION);
+        tflite_restore_active_model(msg_loader_model);
         return RUNTIME_WRAPPER_STATUS_ERROR;
     }
 
-    static bool firstStart = true;
-    static tflite::MicroInterpreter interpreter(model, g_tflite_resolver, tensorArena, tensorArenaSize);
-
-    // this hack is used for reloading the interpreter on model change
-    if (firstStart)
+    // model patched in place or loaded without resetting the loader replaces the serving interpreter
+    if (slot == g_active_slot)
     {
-        interpreter.~MicroInterpreter();
-        firstStart = false;
+        tflite_destroy_interpreter();
     }
 
     ZPL_MARK_CODE_SCOPE(tflm_create_interpreter)
     {
-        new (&interpreter) tflite::MicroInterpreter(model, g_tflite_resolver, tensorArena, tensorArenaSize);
+        new (interpreter) tflite::MicroInterpreter(model, g_cancellable_resolver, tensorArena, tensorArenaSize);
     }
-    gp_tflite_interpreter = &interpreter;
 
     TfLiteStatus allocate_status = kTfLiteOk;
-    ZPL_MARK_CODE_SCOPE(tflm_allocate_tensors) { allocate_status = interpreter.AllocateTensors(); }
+    ZPL_MARK_CODE_SCOPE(tflm_allocate_tensors) { allocate_status = interpreter->AllocateTensors(); }
 
     if (allocate_status != kTfLiteOk)
     {
         LOG_ERR("AllocateTensors() failed\n");
+        interpreter->~MicroInterpreter();
+        tflite_restore_active_model(msg_loader_model);
         return RUNTIME_WRAPPER_STATUS_ERROR;
     }
+
+    // model initialized in the shadow slot is swapped in only now, so the previous one served until this point
+    if (slot != g_active_slot)
+    {
+        tflite_destroy_interpreter();
+        g_active_slot = slot;
+        LOG_INF("Swapped in model from slot %zu", slot);
+    }
+    g_active_model_size = model_size;
+    gp_tflite_interpreter = interpreter;
+
     TfLiteTensor *input = gp_tflite_interpreter->input(0);
     msg_loader_input->addr = input->data.data;
     msg_loader_input->max_size = input->bytes;
@@ -127,19 +271,27 @@ status_t runtime_run_model_bench()
 {
     status_t status = STATUS_OK;
     MEASURE_TIME(gp_tflite_time_stats, status = runtime_run_model())
-    return STATUS_OK;
+    return status;
 }
 
 ZPL_CODE_SCOPE_DEFINE(tflm_run, TRACE_FRAMEWORK);
 status_t runtime_run_model()
 {
     TfLiteStatus status = kTfLiteOk;
+    if (gp_tflite_interpreter == NULL)
+    {
+        return RUNTIME_WRAPPER_STATUS_ERROR;
+    }
     ZPL_MARK_CODE_SCOPE(tflm_run) { status = gp_tflite_interpreter->Invoke(); }
     g_peak_allocation = MAX(g_peak_allocation, gp_tflite_interpreter->arena_used_bytes());
     if (status == kTfLiteOk)
     {
         return STATUS_OK;
     }
+    if (runtime_cancel_requested())
+    {
+        return RUNTIME_WRAPPER_STATUS_CANCELLED;
+    }
 
     return RUNTIME_WRAPPER_STATUS_ERROR;
 }
@@ -153,6 +305,25 @@ status_t runtime_get_model_output(uint8_t *model_output)
     return STATUS_OK;
 }
 
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    TfLiteTensor *output = NULL;
+
+    RETURN_ERROR_IF_POINTER_INVALID(views, RUNTIME_WRAPPER_STATUS_INV_PTR);
+    RETURN_ERROR_IF_POINTER_INVALID(num_views, RUNTIME_WRAPPER_STATUS_INV_PTR);
+
+    if (max_views < 1)
+    {
+        return RUNTIME_WRAPPER_STATUS_INV_ARG;
+    }
+
+    ZPL_MARK_CODE_SCOPE(tflm_get_output) { output = gp_tflite_interpreter->output(0); }
+    views[0].data = output->data.uint8;
+    views[0].size = output->bytes;
+    *num_views = 1;
+    return STATUS_OK;
+}
+
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size)
 {
@@ -194,6 +365,7 @@ extern "C"
         runtime_run_model_bench();
         runtime_run_model();
         runtime_get_model_output(NULL);
+        runtime_get_output_view(0, NULL, NULL);
         runtime_get_statistics(0, NULL, NULL);
         prepare_tflite_ldr_table();
     }
@@ -200,7 +200,7 @@ status_t runtime_run_model_bench()
 {
     status_t status = STATUS_OK;
     MEASURE_TIME(gp_tvm_time_stats, status = runtime_run_model())
-    return STATUS_OK;
+    return status;
 }
 
 ZPL_CODE_SCOPE_DEFINE(tvm_run, TRACE_FRAMEWORK);
@@ -208,7 +208,24 @@ status_t runtime_run_model()
 {
     status_t status = STATUS_OK;
 
-    ZPL_MARK_CODE_SCOPE(tvm_run) { TVMGraphExecutor_Run(gp_tvm_graph_executor); }
+    // graph nodes are run one by one, as in TVMGraphExecutor_Run, so that the inference can be cancelled between them
+    ZPL_MARK_CODE_SCOPE(tvm_run)
+    {
+        for (uint32_t i = 0; i < gp_tvm_graph_executor->op_execs_count; i++)
+        {
+            TVMPackedFunc *op_exec = &gp_tvm_graph_executor->op_execs[i];
+
+            if (runtime_cancel_requested())
+            {
+                status = RUNTIME_WRAPPER_STATUS_CANCELLED;
+                break;
+            }
+            if (NULL != op_exec->fexec)
+            {
+                op_exec->Call(op_exec);
+            }
+        }
+    }
 
     return status;
 }
@@ -254,6 +271,12 @@ status_t runtime_get_model_output(uint8_t *model_output)
     return status;
 }
 
+status_t runtime_get_output_view(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    // CRT graph executor exposes outputs only by copying them to a caller tensor
+    return RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED;
+}
+
 ZPL_CODE_SCOPE_DEFINE(tvm_allocation_stats, TRACE_FRAMEWORK);
 status_t runtime_get_statistics(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                 size_t *statistics_size)
@@ -33,9 +33,10 @@ static void tracing_backend_kenning_protocol_output(const struct tracing_backend
         {
             protocol_event_t transmission;
             transmission.message_type = MESSAGE_TYPE_TRACE_DATA;
+            transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
             transmission.payload.raw_bytes = g_trace_buffer;
             transmission.payload.size = g_trace_buffer_size;
-            // We record the status, because the transmission might fail if the protocol is busy,
+            // We record the status, because the transmission might fail if the protocol queue of traces is full,
             // in such case we will attempt the transmission again.
             status = protocol_transmit(&transmission);
         }
@@ -8,6 +8,7 @@
 #include <zephyr/fff.h>
 #include <zephyr/ztest.h>
 
+#include <kenning_inference_lib/core/artifact_cache.h>
 #include <kenning_inference_lib/core/callbacks.h>
 #include <kenning_inference_lib/core/kenning_protocol.h>
 #include <kenning_inference_lib/core/loaders.h>
@@ -23,7 +24,9 @@ GENERATE_MODULE_STATUSES_STR(KENNING_PROTOCOL);
 const char *const MESSAGE_TYPE_STR[] = {MESSAGE_TYPES(GENERATE_STR)};
 
 struct msg_loader *g_ldr_tables[LDR_TABLE_COUNT][NUM_LOADER_TYPES];
+extern bool g_client_connected;
 
+#define MODEL_INPUT_SIZE 4
 #define MODEL_OUTPUT_SIZE 10
 #define STATISTICS_SIZE 10
 
@@ -40,18 +43,39 @@ DEFINE_FFF_GLOBALS;
     MOCK(status_t, model_run)                                                                              \
     MOCK(status_t, model_run_bench)                                                                        \
     MOCK(status_t, model_get_output, const size_t, uint8_t *, size_t *)                                    \
+    MOCK(status_t, model_get_output_view, const size_t, runtime_output_view_t *, size_t *)                 \
+    MOCK(status_t, model_get_input_size, size_t *)                                                         \
+    MOCK(status_t, model_get_output_size, size_t *)                                                        \
+    MOCK(status_t, model_load_input, const uint8_t *, const size_t)                                        \
     MOCK(status_t, model_get_statistics, const size_t, uint8_t *, size_t *)                                \
     MOCK(status_t, runtime_deinit)                                                                         \
     MOCK(status_t, model_init)                                                                             \
+    MOCK(MODEL_STATE, model_get_state)                                                                     \
     MOCK(struct llext *, llext_by_name, char *)                                                            \
     MOCK(int, llext_unload, struct llext **)                                                               \
     MOCK(int, llext_load, struct llext_loader *, const char *, struct llext **, struct llext_load_param *) \
     MOCK(int, llext_bringup, struct llext *)                                                               \
-    MOCK(int, llext_teardown, struct llext *)
+    MOCK(int, llext_teardown, struct llext *)                                                              \
+    MOCK(status_t, artifact_cache_find, ARTIFACT_CACHE_SLOT, const uint8_t *, size_t *)                    \
+    MOCK(status_t, artifact_cache_read, ARTIFACT_CACHE_SLOT, struct msg_loader *)                          \
+    MOCK(status_t, artifact_cache_store, ARTIFACT_CACHE_SLOT, const uint8_t *, const uint8_t *, size_t)    \
+    MOCK(status_t, artifact_cache_invalidate, ARTIFACT_CACHE_SLOT)                                         \
+    MOCK(bool, protocol_get_interrupted_upload, message_type_t *, bool *, bool *, size_t *)                \
+    MOCK(status_t, protocol_get_baudrate, uint32_t *)
+#define VOID_MOCKS(MOCK)       \
+    MOCK(model_request_cancel) \
+    MOCK(request_baudrate_change, uint32_t)
+
+VOID_MOCKS(DECLARE_VOID_MOCK);
 MOCKS(DECLARE_MOCK);
 
 const char *get_status_str_mock(status_t);
 status_t model_get_output_mock(const size_t buffer_size, uint8_t *model_output, size_t *model_output_size);
+status_t model_get_output_view_mock(const size_t max_views, runtime_output_view_t *views, size_t *num_views);
+status_t model_get_input_size_mock(size_t *model_input_size);
+status_t model_get_output_size_mock(size_t *model_output_size);
+status_t model_get_small_output_size_mock(size_t *model_output_size);
+status_t protocol_get_baudrate_mock(uint32_t *baudrate);
 
 status_t model_get_statistics_mock(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                    size_t *statistics_size);
@@ -59,12 +83,29 @@ status_t model_get_statistics_mock(const size_t statistics_buffer_size, uint8_t
 int llext_load_success_mock(struct llext_loader *ldr, const char *name, struct llext **p_llext,
                             struct llext_load_param *ldr_param);
 
+int model_loader_reset_mock(struct msg_loader *ldr);
+
+bool protocol_get_interrupted_upload_mock(message_type_t *message_type, bool *compressed, bool *patch, size_t *offset);
+bool protocol_get_interrupted_upload_offset_too_big_mock(message_type_t *message_type, bool *compressed, bool *patch,
+                                                         size_t *offset);
+
 // ========================================================
 // helper functions declarations
 // ========================================================
 
 protocol_event_t prepare_request(message_type_t msg_type, size_t payload_size);
 
+/**
+ * Prepares CACHE_QUERY request for an artifact uploaded in messages of given type
+ *
+ * @param msg_type type of the messages used to upload the artifact
+ * @param query buffer for the request payload
+ * @param ldr loader for the request payload
+ *
+ * @returns prepared request
+ */
+protocol_event_t prepare_cache_query(message_type_t msg_type, cache_query_t *query, struct msg_loader *ldr);
+
 /**
  * Prepares message of given type and payload
  *
@@ -84,10 +125,24 @@ struct llext *prepare_llext_replacement();
 
 static void callbacks_tests_setup_f()
 {
+    VOID_MOCKS(RESET_VOID_MOCK);
     MOCKS(RESET_MOCK);
+    model_get_output_view_fake.return_val = RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED;
 
     static struct msg_loader msg_loader_llext = {0};
     g_ldr_tables[0][LOADER_TYPE_RUNTIME] = &msg_loader_llext;
+
+    static struct msg_loader msg_loader_model = {.reset = model_loader_reset_mock};
+    g_ldr_tables[1][LOADER_TYPE_MODEL] = &msg_loader_model;
+    artifact_cache_find_fake.return_val = ARTIFACT_CACHE_STATUS_MISS;
+
+    static uint8_t batch_buffer[8 * MODEL_INPUT_SIZE];
+    static struct msg_loader msg_loader_batch = {.addr = batch_buffer, .max_size = sizeof(batch_buffer)};
+    g_ldr_tables[0][LOADER_TYPE_BATCH] = &msg_loader_batch;
+    model_get_input_size_fake.custom_fake = model_get_input_size_mock;
+    model_get_output_size_fake.custom_fake = model_get_output_size_mock;
+    protocol_get_baudrate_fake.custom_fake = protocol_get_baudrate_mock;
+    g_client_connected = false;
 }
 
 ZTEST_SUITE(kenning_inference_lib_test_callbacks, NULL, NULL, callbacks_tests_setup_f, NULL, NULL);
@@ -125,6 +180,118 @@ ZTEST(kenning_inference_lib_test_callbacks, test_unsupported_callback)
 #undef TEST_UNSUPPORTED_CALLBACK
 }
 
+// ========================================================
+// ping_callback
+// ========================================================
+
+/**
+ * Tests if baudrate proposed when starting the session is limited and sent back
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_ping_callback_negotiate_baudrate)
+{
+    status_t status = STATUS_OK;
+    uint32_t proposed = 2 * CONFIG_KENNING_BAUDRATE_MAX;
+    struct msg_loader proposal_ldr = {.addr = &proposed, .written = sizeof(proposed)};
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_PING, sizeof(proposed));
+    uint32_t accepted = 0;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&accepted, .size = 0};
+
+    request.flags.general_purpose_flags.success = 1;
+    request.flags.general_purpose_flags.has_payload = 1;
+    request.payload.loader = &proposal_ldr;
+
+    status = ping_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(sizeof(accepted), resp_payload.size);
+    zassert_equal(CONFIG_KENNING_BAUDRATE_MAX, accepted);
+    zassert_equal(1, request_baudrate_change_fake.call_count);
+    zassert_equal(CONFIG_KENNING_BAUDRATE_MAX, request_baudrate_change_fake.arg0_val);
+}
+
+/**
+ * Tests if baudrate proposal is ignored when the transport has no baudrate
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_ping_callback_negotiate_baudrate_not_supported)
+{
+    status_t status = STATUS_OK;
+    uint32_t proposed = 115200;
+    struct msg_loader proposal_ldr = {.addr = &proposed, .written = sizeof(proposed)};
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_PING, sizeof(proposed));
+    uint32_t accepted = 0;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&accepted, .size = 0};
+
+    request.flags.general_purpose_flags.success = 1;
+    request.flags.general_purpose_flags.has_payload = 1;
+    request.payload.loader = &proposal_ldr;
+    protocol_get_baudrate_fake.custom_fake = NULL;
+    protocol_get_baudrate_fake.return_val = PROTOCOL_STATUS_NOT_SUPPORTED;
+
+    status = ping_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(0, resp_payload.size);
+    zassert_equal(0, request_baudrate_change_fake.call_count);
+}
+
+// ========================================================
+// status_callback
+// ========================================================
+
+/**
+ * Tests if status callback sends back device capabilities
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_status_callback)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_STATUS, 0);
+    static uint8_t resp_buffer[CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE];
+    protocol_payload_t resp_payload = {.raw_bytes = resp_buffer, .type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+    static struct msg_loader msg_loader_data = {.max_size = 64};
+    static struct msg_loader msg_loader_model = {.max_size = 4096};
+    device_status_t device_status;
+
+    g_ldr_tables[1][LOADER_TYPE_DATA] = &msg_loader_data;
+    g_ldr_tables[1][LOADER_TYPE_MODEL] = &msg_loader_model;
+    model_get_state_fake.return_val = MODEL_STATE_WEIGHTS_LOADED;
+
+    status = status_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(sizeof(device_status_t), resp_payload.size);
+    memcpy(&device_status, resp_buffer, sizeof(device_status));
+    zassert_equal(0, strcmp(CONFIG_KENNING_ML_RUNTIME_NAME, (char *)device_status.runtime_name));
+    zassert_equal(MODEL_STATE_WEIGHTS_LOADED, device_status.model_state);
+    zassert_equal(NUM_LOADER_TYPES, device_status.num_loader_types);
+    zassert_equal(0, device_status.loader_max_size[LOADER_TYPE_NONE]);
+    zassert_equal(64, device_status.loader_max_size[LOADER_TYPE_DATA]);
+    zassert_equal(4096, device_status.loader_max_size[LOADER_TYPE_MODEL]);
+    zassert_equal(8 * MODEL_INPUT_SIZE, device_status.loader_max_size[LOADER_TYPE_BATCH]);
+    zassert_equal(CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE, device_status.response_payload_size);
+    zassert_equal(CONFIG_KENNING_PROTOCOL_MAX_OUTGOING_MESSAGE_SIZE, device_status.max_outgoing_message_size);
+    zassert_equal(CONFIG_KENNING_MESSAGE_RECV_BUFFER_SIZE, device_status.recv_buffer_size);
+    zassert_true(device_status.supported_message_types & (1 << MESSAGE_TYPE_STATUS));
+    zassert_true(device_status.supported_message_types & (1 << MESSAGE_TYPE_INFER));
+    zassert_false(device_status.supported_message_types & (1 << MESSAGE_TYPE_OPTIMIZERS));
+
+    g_ldr_tables[1][LOADER_TYPE_DATA] = NULL;
+    g_ldr_tables[1][LOADER_TYPE_MODEL] = NULL;
+}
+
+/**
+ * Tests if status callback fails for invalid request message type
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_status_callback_invalid_message_type)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_PING, 0);
+    protocol_payload_t resp_payload;
+
+    status = status_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_MSG_TYPE, status);
+}
+
 // ========================================================
 // data_callback
 // ========================================================
@@ -408,6 +575,50 @@ ZTEST(kenning_inference_lib_test_callbacks, test_output_callback_model_error)
     zassert_equal(model_get_output_fake.call_count, 1);
 }
 
+/**
+ * Tests if output callback sends model output directly from the runtime memory
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_output_callback_view)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_OUTPUT, 0);
+    protocol_payload_t resp_payload = {.type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+
+    model_get_output_view_fake.custom_fake = model_get_output_view_mock;
+
+    status = output_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_get_output_view_fake.call_count, 1);
+    zassert_equal(model_get_output_fake.call_count, 0);
+    zassert_equal(resp_payload.type, PROTOCOL_PAYLOAD_TYPE_SEGMENTS);
+    zassert_equal(resp_payload.segment_count, 2);
+    zassert_equal(resp_payload.size, MODEL_OUTPUT_SIZE);
+    zassert_equal(resp_payload.segments[0].data, (const uint8_t *)0x1000);
+    zassert_equal(resp_payload.segments[0].size, MODEL_OUTPUT_SIZE - 4);
+    zassert_equal(resp_payload.segments[1].data, (const uint8_t *)0x2000);
+    zassert_equal(resp_payload.segments[1].size, 4);
+}
+
+/**
+ * Tests if output callback does not copy model output when retrieving its view fails
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_output_callback_view_error)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_OUTPUT, 0);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345, .type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+
+    model_get_output_view_fake.return_val = MODEL_STATUS_INV_STATE;
+
+    status = output_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_get_output_fake.call_count, 0);
+    zassert_equal(resp_payload.type, PROTOCOL_PAYLOAD_TYPE_BYTES);
+    zassert_equal(resp_payload.size, 0);
+}
+
 /**
  * Tests if output callback fails for invalid pointer
  */
@@ -615,6 +826,742 @@ ZTEST(kenning_inference_lib_test_callbacks, test_iospec_callback_invalid_message
 #undef TEST_IOSPEC_CALLBACK
 }
 
+// ========================================================
+// infer_callback
+// ========================================================
+
+/**
+ * Tests if infer callback loads input, runs model and copies its output
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_callback)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER, 0);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345, .type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+
+    request.flags.raw_bytes = 0;
+    model_get_output_fake.custom_fake = model_get_output_mock;
+
+    status = infer_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_load_input_from_loader_fake.call_count, 1);
+    zassert_equal(model_run_bench_fake.call_count, 1);
+    zassert_equal(model_get_output_fake.call_count, 1);
+    zassert_equal(model_get_statistics_fake.call_count, 0);
+    zassert_equal(resp_payload.type, PROTOCOL_PAYLOAD_TYPE_BYTES);
+    zassert_equal(resp_payload.size, MODEL_OUTPUT_SIZE);
+}
+
+/**
+ * Tests if infer callback appends statistics to the copied output
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_callback_stats)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER, 0);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345, .type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+
+    request.flags.raw_bytes = 0;
+    request.flags.flags_infer.stats = 1;
+    model_get_output_fake.custom_fake = model_get_output_mock;
+    model_get_statistics_fake.custom_fake = model_get_statistics_mock;
+
+    status = infer_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_get_statistics_fake.call_count, 1);
+    zassert_equal(model_get_statistics_fake.arg0_val, CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE - MODEL_OUTPUT_SIZE);
+    zassert_equal(model_get_statistics_fake.arg1_val, resp_payload.raw_bytes + MODEL_OUTPUT_SIZE);
+    zassert_equal(resp_payload.size, MODEL_OUTPUT_SIZE + STATISTICS_SIZE);
+}
+
+/**
+ * Tests if infer callback sends statistics after the output sent directly from the runtime memory
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_callback_view_stats)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER, 0);
+    uint8_t *resp_buffer = (uint8_t *)0x12345;
+    protocol_payload_t resp_payload = {.raw_bytes = resp_buffer, .type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+
+    request.flags.raw_bytes = 0;
+    request.flags.flags_infer.stats = 1;
+    model_get_output_view_fake.custom_fake = model_get_output_view_mock;
+    model_get_statistics_fake.custom_fake = model_get_statistics_mock;
+
+    status = infer_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_get_output_fake.call_count, 0);
+    zassert_equal(model_get_statistics_fake.arg1_val, resp_buffer);
+    zassert_equal(resp_payload.type, PROTOCOL_PAYLOAD_TYPE_SEGMENTS);
+    zassert_equal(resp_payload.segment_count, 3);
+    zassert_equal(resp_payload.segments[2].data, resp_buffer);
+    zassert_equal(resp_payload.segments[2].size, STATISTICS_SIZE);
+    zassert_equal(resp_payload.size, MODEL_OUTPUT_SIZE + STATISTICS_SIZE);
+}
+
+/**
+ * Tests if infer callback fails and does not run the model when input loading fails
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_callback_input_error)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER, 0);
+    protocol_payload_t resp_payload;
+
+    request.flags.raw_bytes = 0;
+    model_load_input_from_loader_fake.return_val = MODEL_STATUS_INV_STATE;
+
+    status = infer_callback(&request, &resp_payload);
+
+    zassert_equal(MODEL_STATUS_INV_STATE, status);
+    zassert_equal(model_run_bench_fake.call_count, 0);
+    zassert_equal(model_get_output_fake.call_count, 0);
+}
+
+/**
+ * Tests if infer callback fails and does not retrieve output when model run fails
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_callback_model_error)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER, 0);
+    protocol_payload_t resp_payload;
+
+    request.flags.raw_bytes = 0;
+    model_run_bench_fake.return_val = MODEL_STATUS_ERROR;
+
+    status = infer_callback(&request, &resp_payload);
+
+    zassert_equal(MODEL_STATUS_ERROR, status);
+    zassert_equal(model_run_bench_fake.call_count, 1);
+    zassert_equal(model_get_output_fake.call_count, 0);
+}
+
+/**
+ * Tests if infer callback fails for invalid request message type
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_callback_invalid_message_type)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request;
+    protocol_payload_t resp_payload;
+
+#define TEST_INFER_CALLBACK(_message_type)                \
+    request = prepare_request(_message_type, 0);          \
+    status = infer_callback(&request, &resp_payload);     \
+    zassert_equal(CALLBACKS_STATUS_INV_MSG_TYPE, status); \
+    zassert_equal(model_load_input_from_loader_fake.call_count, 0);
+
+    TEST_INFER_CALLBACK(MESSAGE_TYPE_PING);
+    TEST_INFER_CALLBACK(MESSAGE_TYPE_DATA);
+    TEST_INFER_CALLBACK(MESSAGE_TYPE_PROCESS);
+    TEST_INFER_CALLBACK(MESSAGE_TYPE_OUTPUT);
+    TEST_INFER_CALLBACK(MESSAGE_TYPE_STATS);
+
+#undef TEST_INFER_CALLBACK
+}
+
+// ========================================================
+// stream_callback
+// ========================================================
+
+/**
+ * Tests if stream callback opens and closes stream session
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_stream_callback)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_STREAM, 0);
+    protocol_payload_t resp_payload;
+
+    request.flags.raw_bytes = 0;
+    request.flags.general_purpose_flags.success = 1;
+
+    status = stream_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_true(stream_session_active());
+
+    request.flags.raw_bytes = 0;
+    request.flags.general_purpose_flags.fail = 1;
+
+    status = stream_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_false(stream_session_active());
+}
+
+/**
+ * Tests if stream callback fails when stream session is already open
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_stream_callback_already_open)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_STREAM, 0);
+    protocol_payload_t resp_payload;
+
+    request.flags.raw_bytes = 0;
+    request.flags.general_purpose_flags.success = 1;
+
+    status = stream_callback(&request, &resp_payload);
+    zassert_equal(STATUS_OK, status);
+
+    status = stream_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_ERROR, status);
+    zassert_true(stream_session_active());
+
+    request.flags.raw_bytes = 0;
+    request.flags.general_purpose_flags.fail = 1;
+    stream_callback(&request, &resp_payload);
+}
+
+/**
+ * Tests if cancel callback requests cancellation of the inference
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cancel_callback)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_CANCEL, 0);
+    protocol_payload_t resp_payload;
+
+    status = cancel_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_request_cancel_fake.call_count, 1);
+}
+
+/**
+ * Tests if cancel callback fails for invalid message type
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cancel_callback_invalid_message_type)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_PING, 0);
+    protocol_payload_t resp_payload;
+
+    status = cancel_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_MSG_TYPE, status);
+    zassert_equal(model_request_cancel_fake.call_count, 0);
+}
+
+/**
+ * Tests if upload offset callback sends back the interrupted transmission
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_upload_offset_callback)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_UPLOAD_OFFSET, 0);
+    upload_offset_resp_t resp;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&resp};
+
+    protocol_get_interrupted_upload_fake.custom_fake = protocol_get_interrupted_upload_mock;
+
+    status = upload_offset_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(sizeof(resp), resp_payload.size);
+    zassert_equal(1, resp.interrupted);
+    zassert_equal(MESSAGE_TYPE_MODEL, resp.message_type);
+    zassert_equal(1, resp.compressed);
+    zassert_equal(1, resp.patch);
+    zassert_equal(1234, resp.offset);
+}
+
+/**
+ * Tests if upload offset callback reports that there is no interrupted transmission
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_upload_offset_callback_not_interrupted)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_UPLOAD_OFFSET, 0);
+    upload_offset_resp_t resp;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&resp};
+
+    protocol_get_interrupted_upload_fake.return_val = false;
+
+    status = upload_offset_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(sizeof(resp), resp_payload.size);
+    zassert_equal(0, resp.interrupted);
+}
+
+#if SIZE_MAX > UINT32_MAX
+/**
+ * Tests if upload offset callback does not report transmission with offset that does not fit in the response
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_upload_offset_callback_offset_too_big)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_UPLOAD_OFFSET, 0);
+    upload_offset_resp_t resp;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&resp};
+
+    protocol_get_interrupted_upload_fake.custom_fake = protocol_get_interrupted_upload_offset_too_big_mock;
+
+    status = upload_offset_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(sizeof(resp), resp_payload.size);
+    zassert_equal(0, resp.interrupted);
+}
+#endif // SIZE_MAX > UINT32_MAX
+
+/**
+ * Tests if upload offset callback fails for invalid message type
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_upload_offset_callback_invalid_message_type)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_PING, 0);
+    protocol_payload_t resp_payload;
+
+    status = upload_offset_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_MSG_TYPE, status);
+    zassert_equal(0, protocol_get_interrupted_upload_fake.call_count);
+}
+
+// ========================================================
+// cache_query_callback
+// ========================================================
+
+/**
+ * Tests if cache query callback loads cached model
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cache_query_callback_hit)
+{
+    status_t status = STATUS_OK;
+    cache_query_t query;
+    struct msg_loader query_ldr;
+    protocol_event_t request = prepare_cache_query(MESSAGE_TYPE_MODEL, &query, &query_ldr);
+    cache_query_resp_t resp;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&resp};
+
+    artifact_cache_find_fake.return_val = STATUS_OK;
+    model_load_weights_from_loader_fake.return_val = STATUS_OK;
+
+    status = cache_query_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(sizeof(resp), resp_payload.size);
+    zassert_equal(1, resp.hit);
+    zassert_equal(ARTIFACT_CACHE_SLOT_MODEL, artifact_cache_find_fake.arg0_val);
+    zassert_equal(1, artifact_cache_read_fake.call_count);
+    zassert_equal(g_ldr_tables[1][LOADER_TYPE_MODEL], artifact_cache_read_fake.arg1_val);
+    zassert_equal(1, model_load_weights_from_loader_fake.call_count);
+}
+
+/**
+ * Tests if model missing in the cache is cached after its upload
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cache_query_callback_miss)
+{
+    status_t status = STATUS_OK;
+    cache_query_t query;
+    struct msg_loader query_ldr;
+    protocol_event_t request = prepare_cache_query(MESSAGE_TYPE_MODEL, &query, &query_ldr);
+    cache_query_resp_t resp;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&resp};
+    uint8_t model[8];
+    struct msg_loader model_ldr = {.addr = model, .written = sizeof(model)};
+    protocol_event_t upload = prepare_request(MESSAGE_TYPE_MODEL, sizeof(model));
+
+    upload.payload.loader = &model_ldr;
+    model_load_weights_from_loader_fake.return_val = STATUS_OK;
+
+    status = cache_query_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(0, resp.hit);
+    zassert_equal(0, artifact_cache_read_fake.call_count);
+    zassert_equal(0, model_load_weights_from_loader_fake.call_count);
+
+    status = model_callback(&upload, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, artifact_cache_store_fake.call_count);
+    zassert_equal(ARTIFACT_CACHE_SLOT_MODEL, artifact_cache_store_fake.arg0_val);
+    zassert_mem_equal(query.hash, artifact_cache_store_fake.arg1_val, sizeof(query.hash));
+    zassert_equal(model, artifact_cache_store_fake.arg2_val);
+    zassert_equal(sizeof(model), artifact_cache_store_fake.arg3_val);
+
+    // model is cached only once
+    status = model_callback(&upload, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, artifact_cache_store_fake.call_count);
+}
+
+/**
+ * Tests if model patch uploaded after the cache query is not cached and drops the queried hash
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cache_query_callback_miss_patch)
+{
+    status_t status = STATUS_OK;
+    cache_query_t query;
+    struct msg_loader query_ldr;
+    protocol_event_t request = prepare_cache_query(MESSAGE_TYPE_MODEL, &query, &query_ldr);
+    cache_query_resp_t resp;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&resp};
+    uint8_t model[8];
+    struct msg_loader model_ldr = {.addr = model, .written = sizeof(model)};
+    protocol_event_t upload = prepare_request(MESSAGE_TYPE_MODEL, sizeof(model));
+
+    upload.payload.loader = &model_ldr;
+    upload.flags.flags_upload.patch = 1;
+    model_load_weights_from_loader_fake.return_val = STATUS_OK;
+
+    status = cache_query_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(0, resp.hit);
+
+    status = model_callback(&upload, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, model_load_weights_from_loader_fake.call_count);
+    zassert_equal(0, artifact_cache_store_fake.call_count);
+
+    // queried hash is dropped, so the next upload is not cached under it either
+    upload.flags.flags_upload.patch = 0;
+    status = model_callback(&upload, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(0, artifact_cache_store_fake.call_count);
+}
+
+/**
+ * Tests if cached model that fails to load is removed from the cache and reported as missing
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cache_query_callback_load_error)
+{
+    status_t status = STATUS_OK;
+    cache_query_t query;
+    struct msg_loader query_ldr;
+    protocol_event_t request = prepare_cache_query(MESSAGE_TYPE_MODEL, &query, &query_ldr);
+    cache_query_resp_t resp;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)&resp};
+    uint8_t model[8];
+    struct msg_loader model_ldr = {.addr = model, .written = sizeof(model)};
+    protocol_event_t upload = prepare_request(MESSAGE_TYPE_MODEL, sizeof(model));
+
+    upload.payload.loader = &model_ldr;
+    artifact_cache_find_fake.return_val = STATUS_OK;
+    model_load_weights_from_loader_fake.return_val = MODEL_STATUS_ERROR;
+
+    status = cache_query_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(0, resp.hit);
+    zassert_equal(1, artifact_cache_invalidate_fake.call_count);
+
+    model_load_weights_from_loader_fake.return_val = STATUS_OK;
+    status = model_callback(&upload, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, artifact_cache_store_fake.call_count);
+}
+
+/**
+ * Tests if cache query callback fails for artifacts that cannot be cached
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cache_query_callback_invalid_artifact)
+{
+    status_t status = STATUS_OK;
+    cache_query_t query;
+    struct msg_loader query_ldr;
+    protocol_event_t request = prepare_cache_query(MESSAGE_TYPE_DATA, &query, &query_ldr);
+    protocol_payload_t resp_payload;
+
+    status = cache_query_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_ARG, status);
+    zassert_equal(0, artifact_cache_find_fake.call_count);
+}
+
+/**
+ * Tests if cache query callback fails for payload of invalid size
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cache_query_callback_invalid_size)
+{
+    status_t status = STATUS_OK;
+    cache_query_t query;
+    struct msg_loader query_ldr;
+    protocol_event_t request = prepare_cache_query(MESSAGE_TYPE_MODEL, &query, &query_ldr);
+    protocol_payload_t resp_payload;
+
+    request.payload.size = sizeof(query) - 1;
+
+    status = cache_query_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_ARG, status);
+    zassert_equal(0, artifact_cache_find_fake.call_count);
+}
+
+/**
+ * Tests if cache query callback fails for invalid message type
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_cache_query_callback_invalid_message_type)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_PING, 0);
+    protocol_payload_t resp_payload;
+
+    status = cache_query_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_MSG_TYPE, status);
+    zassert_equal(0, artifact_cache_find_fake.call_count);
+}
+
+/**
+ * Tests if data callback runs model and prepares its output for input pushed in stream session
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_data_callback_stream)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t stream_request = prepare_request(MESSAGE_TYPE_STREAM, 0);
+    protocol_event_t transmission = prepare_request(MESSAGE_TYPE_DATA, MODEL_INPUT_SIZE);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345, .type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+
+    stream_request.flags.raw_bytes = 0;
+    stream_request.flags.general_purpose_flags.success = 1;
+    stream_request.flags.flags_infer.stats = 1;
+    transmission.is_request = false;
+    model_get_output_fake.custom_fake = model_get_output_mock;
+    model_get_statistics_fake.custom_fake = model_get_statistics_mock;
+
+    status = stream_callback(&stream_request, &resp_payload);
+    zassert_equal(STATUS_OK, status);
+
+    status = data_callback(&transmission, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_load_input_from_loader_fake.call_count, 1);
+    zassert_equal(model_load_input_from_loader_fake.arg0_val, MODEL_INPUT_SIZE);
+    zassert_equal(model_run_bench_fake.call_count, 1);
+    zassert_equal(model_get_output_fake.call_count, 1);
+    zassert_equal(model_get_statistics_fake.call_count, 1);
+    zassert_equal(resp_payload.size, MODEL_OUTPUT_SIZE + STATISTICS_SIZE);
+
+    stream_request.flags.raw_bytes = 0;
+    stream_request.flags.general_purpose_flags.fail = 1;
+    stream_callback(&stream_request, &resp_payload);
+}
+
+/**
+ * Tests if data callback only loads input sent in a request in stream session
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_data_callback_stream_request)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t stream_request = prepare_request(MESSAGE_TYPE_STREAM, 0);
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_DATA, MODEL_INPUT_SIZE);
+    protocol_payload_t resp_payload;
+
+    stream_request.flags.raw_bytes = 0;
+    stream_request.flags.general_purpose_flags.success = 1;
+    request.is_request = true;
+
+    status = stream_callback(&stream_request, &resp_payload);
+    zassert_equal(STATUS_OK, status);
+
+    status = data_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_load_input_from_loader_fake.call_count, 1);
+    zassert_equal(model_run_bench_fake.call_count, 0);
+
+    stream_request.flags.raw_bytes = 0;
+    stream_request.flags.general_purpose_flags.fail = 1;
+    stream_callback(&stream_request, &resp_payload);
+}
+
+// ========================================================
+// infer_batch_callback
+// ========================================================
+
+/**
+ * Tests if infer batch callback runs model on each sample and concatenates outputs
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_batch_callback)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER_BATCH, 3 * MODEL_INPUT_SIZE);
+    uint8_t *batch = g_ldr_tables[0][LOADER_TYPE_BATCH]->addr;
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345};
+
+    request.flags.raw_bytes = 0;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_load_input_fake.call_count, 3);
+    zassert_equal(model_run_bench_fake.call_count, 3);
+    zassert_equal(model_get_output_fake.call_count, 3);
+    zassert_equal(model_get_statistics_fake.call_count, 0);
+    for (int i = 0; i < 3; ++i)
+    {
+        zassert_equal(model_load_input_fake.arg0_history[i], batch + i * MODEL_INPUT_SIZE);
+        zassert_equal(model_load_input_fake.arg1_history[i], MODEL_INPUT_SIZE);
+        zassert_equal(model_get_output_fake.arg1_history[i], (uint8_t *)0x12345 + i * MODEL_OUTPUT_SIZE);
+    }
+    zassert_equal(resp_payload.size, 3 * MODEL_OUTPUT_SIZE);
+    zassert_equal(resp_payload.type, PROTOCOL_PAYLOAD_TYPE_SEGMENTS);
+    zassert_equal(resp_payload.segment_count, 1);
+    zassert_equal(resp_payload.segments[0].data, (uint8_t *)0x12345);
+    zassert_equal(resp_payload.segments[0].size, 3 * MODEL_OUTPUT_SIZE);
+}
+
+/**
+ * Tests if infer batch callback stores outputs not larger than inputs in place of the inputs and sends them from there
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_batch_callback_outputs_in_batch_buffer)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER_BATCH, 3 * MODEL_INPUT_SIZE);
+    uint8_t *batch = g_ldr_tables[0][LOADER_TYPE_BATCH]->addr;
+    uint8_t *resp_buffer = (uint8_t *)0x12345;
+    protocol_payload_t resp_payload = {.raw_bytes = resp_buffer};
+
+    request.flags.raw_bytes = 0;
+    request.flags.flags_infer.stats = 1;
+    model_get_output_size_fake.custom_fake = model_get_small_output_size_mock;
+    model_get_statistics_fake.custom_fake = model_get_statistics_mock;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(model_get_output_fake.call_count, 3);
+    for (int i = 0; i < 3; ++i)
+    {
+        zassert_equal(model_get_output_fake.arg1_history[i], batch + i * MODEL_INPUT_SIZE / 2);
+        zassert_equal(model_get_statistics_fake.arg1_history[i + 1], resp_buffer + i * STATISTICS_SIZE);
+    }
+    zassert_equal(resp_payload.type, PROTOCOL_PAYLOAD_TYPE_SEGMENTS);
+    zassert_equal(resp_payload.segment_count, 2);
+    zassert_equal(resp_payload.segments[0].data, batch);
+    zassert_equal(resp_payload.segments[0].size, 3 * MODEL_INPUT_SIZE / 2);
+    zassert_equal(resp_payload.segments[1].data, resp_buffer);
+    zassert_equal(resp_payload.segments[1].size, 3 * STATISTICS_SIZE);
+    zassert_equal(resp_payload.size, 3 * (MODEL_INPUT_SIZE / 2 + STATISTICS_SIZE));
+}
+
+/**
+ * Tests if infer batch callback stores statistics of each inference after all outputs
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_batch_callback_stats)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER_BATCH, 3 * MODEL_INPUT_SIZE);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345};
+
+    request.flags.raw_bytes = 0;
+    request.flags.flags_infer.stats = 1;
+    model_get_statistics_fake.custom_fake = model_get_statistics_mock;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(STATUS_OK, status);
+    // size of the statistics is retrieved before the batch is run
+    zassert_equal(model_get_statistics_fake.call_count, 4);
+    for (int i = 0; i < 3; ++i)
+    {
+        zassert_equal(model_get_statistics_fake.arg1_history[i + 1],
+                      (uint8_t *)0x12345 + 3 * MODEL_OUTPUT_SIZE + i * STATISTICS_SIZE);
+    }
+    zassert_equal(resp_payload.size, 3 * (MODEL_OUTPUT_SIZE + STATISTICS_SIZE));
+    zassert_equal(resp_payload.segment_count, 2);
+}
+
+/**
+ * Tests if infer batch callback fails when batch size is not a multiple of model input size
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_batch_callback_invalid_size)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER_BATCH, 3 * MODEL_INPUT_SIZE - 1);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345};
+
+    request.flags.raw_bytes = 0;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_ARG, status);
+    zassert_equal(model_load_input_fake.call_count, 0);
+
+    request.payload.size = 0;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_ARG, status);
+    zassert_equal(model_load_input_fake.call_count, 0);
+}
+
+/**
+ * Tests if infer batch callback fails when outputs of the batch do not fit in the response
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_batch_callback_response_too_small)
+{
+    status_t status = STATUS_OK;
+    size_t num_samples = CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE / MODEL_OUTPUT_SIZE + 1;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER_BATCH, num_samples * MODEL_INPUT_SIZE);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345};
+
+    request.flags.raw_bytes = 0;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_ARG, status);
+    zassert_equal(model_load_input_fake.call_count, 0);
+}
+
+/**
+ * Tests if infer batch callback fails before running the batch when statistics of the batch do not fit in the response
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_batch_callback_statistics_too_big)
+{
+    status_t status = STATUS_OK;
+    size_t num_samples = CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE / (MODEL_OUTPUT_SIZE + STATISTICS_SIZE) + 1;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER_BATCH, num_samples * MODEL_INPUT_SIZE);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345};
+
+    request.flags.raw_bytes = 0;
+    request.flags.flags_infer.stats = 1;
+    model_get_statistics_fake.custom_fake = model_get_statistics_mock;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(CALLBACKS_STATUS_INV_ARG, status);
+    zassert_equal(model_get_statistics_fake.call_count, 1);
+    zassert_equal(model_load_input_fake.call_count, 0);
+}
+
+/**
+ * Tests if infer batch callback stops processing the batch when model run fails
+ */
+ZTEST(kenning_inference_lib_test_callbacks, test_infer_batch_callback_model_error)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t request = prepare_request(MESSAGE_TYPE_INFER_BATCH, 3 * MODEL_INPUT_SIZE);
+    protocol_payload_t resp_payload = {.raw_bytes = (uint8_t *)0x12345};
+
+    request.flags.raw_bytes = 0;
+    model_run_bench_fake.return_val = MODEL_STATUS_ERROR;
+
+    status = infer_batch_callback(&request, &resp_payload);
+
+    zassert_equal(MODEL_STATUS_ERROR, status);
+    zassert_equal(model_load_input_fake.call_count, 1);
+    zassert_equal(model_get_output_fake.call_count, 0);
+}
+
 // ========================================================
 // runtime_callback
 // ========================================================
@@ -686,6 +1633,23 @@ protocol_event_t prepare_request(message_type_t msg_type, size_t payload_size)
     protocol_event_t event;
     event.payload.size = payload_size;
     event.message_type = msg_type;
+    event.flags.raw_bytes = 0;
+    event.is_request = true;
+    return event;
+}
+
+protocol_event_t prepare_cache_query(message_type_t msg_type, cache_query_t *query, struct msg_loader *ldr)
+{
+    protocol_event_t event = prepare_request(MESSAGE_TYPE_CACHE_QUERY, sizeof(*query));
+
+    query->message_type = msg_type;
+    for (int i = 0; i < sizeof(query->hash); i++)
+    {
+        query->hash[i] = i;
+    }
+    ldr->addr = query;
+    ldr->written = sizeof(*query);
+    event.payload.loader = ldr;
     return event;
 }
 
@@ -737,6 +1701,40 @@ status_t model_get_output_mock(const size_t buffer_size, uint8_t *model_output,
     return STATUS_OK;
 }
 
+status_t model_get_output_view_mock(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    views[0].data = (const uint8_t *)0x1000;
+    views[0].size = MODEL_OUTPUT_SIZE - 4;
+    views[1].data = (const uint8_t *)0x2000;
+    views[1].size = 4;
+    *num_views = 2;
+    return STATUS_OK;
+}
+
+status_t model_get_input_size_mock(size_t *model_input_size)
+{
+    *model_input_size = MODEL_INPUT_SIZE;
+    return STATUS_OK;
+}
+
+status_t model_get_output_size_mock(size_t *model_output_size)
+{
+    *model_output_size = MODEL_OUTPUT_SIZE;
+    return STATUS_OK;
+}
+
+status_t model_get_small_output_size_mock(size_t *model_output_size)
+{
+    *model_output_size = MODEL_INPUT_SIZE / 2;
+    return STATUS_OK;
+}
+
+status_t protocol_get_baudrate_mock(uint32_t *baudrate)
+{
+    *baudrate = 115200;
+    return STATUS_OK;
+}
+
 status_t model_get_statistics_mock(const size_t statistics_buffer_size, uint8_t *statistics_buffer,
                                    size_t *statistics_size)
 {
@@ -750,3 +1748,22 @@ int llext_load_success_mock(struct llext_loader *ldr, const char *name, struct l
     *p_llext = prepare_llext();
     return 0;
 }
+
+int model_loader_reset_mock(struct msg_loader *ldr) { return STATUS_OK; }
+
+bool protocol_get_interrupted_upload_mock(message_type_t *message_type, bool *compressed, bool *patch, size_t *offset)
+{
+    *message_type = MESSAGE_TYPE_MODEL;
+    *compressed = true;
+    *patch = true;
+    *offset = 1234;
+    return true;
+}
+
+bool protocol_get_interrupted_upload_offset_too_big_mock(message_type_t *message_type, bool *compressed, bool *patch,
+                                                         size_t *offset)
+{
+    protocol_get_interrupted_upload_mock(message_type, compressed, patch, offset);
+    *offset = (size_t)UINT32_MAX + 1;
+    return true;
+}
@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <zephyr/fff.h>
 #include <zephyr/ztest.h>
 
@@ -13,6 +14,7 @@
 #include <kenning_inference_lib/core/kenning_protocol.h>
 #include <kenning_inference_lib/core/model.h>
 
+#include "mocks/kernel.h"
 #include "utils.h"
 
 static protocol_event_t gp_event_to_recv;
@@ -31,7 +33,7 @@ struct msg_loader *g_ldr_tables[LDR_TABLE_COUNT][NUM_LOADER_TYPES];
 // mocks
 // ========================================================
 
-typedef struct msg_loader *(*loader_callback_t)(message_type_t);
+typedef struct msg_loader *(*loader_callback_t)(message_type_t, payload_size_t);
 
 DEFINE_FFF_GLOBALS;
 
@@ -41,6 +43,7 @@ DEFINE_FFF_GLOBALS;
     MOCK(status_t, model_init)                                                     \
     MOCK(status_t, unsupported_callback, protocol_event_t *, protocol_payload_t *) \
     MOCK(status_t, ping_callback, protocol_event_t *, protocol_payload_t *)        \
+    MOCK(status_t, status_callback, protocol_event_t *, protocol_payload_t *)      \
     MOCK(status_t, ok_callback, protocol_event_t *, protocol_payload_t *)          \
     MOCK(status_t, error_callback, protocol_event_t *, protocol_payload_t *)       \
     MOCK(status_t, data_callback, protocol_event_t *, protocol_payload_t *)        \
@@ -50,11 +53,49 @@ DEFINE_FFF_GLOBALS;
     MOCK(status_t, stats_callback, protocol_event_t *, protocol_payload_t *)       \
     MOCK(status_t, iospec_callback, protocol_event_t *, protocol_payload_t *)      \
     MOCK(status_t, runtime_callback, protocol_event_t *, protocol_payload_t *)     \
+    MOCK(status_t, infer_callback, protocol_event_t *, protocol_payload_t *)       \
+    MOCK(status_t, infer_batch_callback, protocol_event_t *, protocol_payload_t *) \
+    MOCK(status_t, stream_callback, protocol_event_t *, protocol_payload_t *)      \
+    MOCK(status_t, cancel_callback, protocol_event_t *, protocol_payload_t *)      \
+    MOCK(status_t, cache_query_callback, protocol_event_t *, protocol_payload_t *) \
+    MOCK(status_t, upload_offset_callback, protocol_event_t *, protocol_payload_t *) \
+    MOCK(bool, stream_session_active)                                              \
     MOCK(status_t, protocol_transmit, const protocol_event_t *)                    \
-    MOCK(status_t, protocol_listen, protocol_event_t *, loader_callback_t)
+    MOCK(status_t, protocol_listen, protocol_event_t *, loader_callback_t)         \
+    MOCK(int, buf_save, struct msg_loader *, const uint8_t *, size_t)              \
+    MOCK(int, buf_save_one, struct msg_loader *, void *)                           \
+    MOCK(int, buf_reset, struct msg_loader *)                                      \
+    MOCK(int, buf_rewind, struct msg_loader *, size_t)                             \
+    MOCK(int, buf_lease_window, struct msg_loader *, uint8_t **, size_t *)         \
+    MOCK(int, buf_commit_window, struct msg_loader *, size_t)
 
 MOCKS(DECLARE_MOCK);
 
+#ifdef CONFIG_KENNING_SERVER_PIPELINE
+#define PIPELINE_VOID_MOCKS(MOCK) MOCK(k_sem_give, struct k_sem *)
+
+#define PIPELINE_MOCKS(MOCK)                                                                                      \
+    MOCK(int, k_sem_take, struct k_sem *, k_timeout_t)                                                            \
+    MOCK(int, k_msgq_put, struct k_msgq *, const void *, k_timeout_t)                                             \
+    MOCK(int, k_msgq_get, struct k_msgq *, void *, k_timeout_t)                                                   \
+    MOCK(int, k_mutex_lock, struct k_mutex *, k_timeout_t)                                                        \
+    MOCK(int, k_mutex_unlock, struct k_mutex *)                                                                   \
+    MOCK(int, k_condvar_wait, struct k_condvar *, struct k_mutex *, k_timeout_t)                                  \
+    MOCK(int, k_condvar_broadcast, struct k_condvar *)                                                            \
+    MOCK(k_tid_t, k_thread_create, struct k_thread *, uint8_t *, size_t, k_thread_entry_t, void *, void *, void *, \
+         int, uint32_t, k_timeout_t)                                                                              \
+    MOCK(int, k_thread_name_set, k_tid_t, const char *)
+
+PIPELINE_VOID_MOCKS(DECLARE_VOID_MOCK);
+PIPELINE_MOCKS(DECLARE_MOCK);
+
+extern size_t g_pending_events;
+
+bool detach_response_payload(protocol_payload_t *payload, uint8_t *buffer);
+struct msg_loader *pipeline_loader_picker(message_type_t message_type, payload_size_t payload_size);
+status_t load_staged_payload(protocol_event_t *event);
+#endif // CONFIG_KENNING_SERVER_PIPELINE
+
 const char *get_status_str_mock(status_t);
 
 status_t protocol_listen_mock(protocol_event_t *event, loader_callback_t callback);
@@ -104,7 +145,14 @@ protocol_event_t prepare_event_to_recv(message_type_t msg_type, size_t payload_s
 // setup
 // ========================================================
 
-static void inference_server_tests_setup_f() { MOCKS(RESET_MOCK); }
+static void inference_server_tests_setup_f()
+{
+    MOCKS(RESET_MOCK);
+#ifdef CONFIG_KENNING_SERVER_PIPELINE
+    PIPELINE_VOID_MOCKS(RESET_VOID_MOCK);
+    PIPELINE_MOCKS(RESET_MOCK);
+#endif // CONFIG_KENNING_SERVER_PIPELINE
+}
 
 static void inference_server_tests_teardown_f() {}
 
@@ -130,6 +178,7 @@ ZTEST(kenning_inference_lib_test_inference_server, test_init_server)
     zassert_equal(STATUS_OK, status);
     zassert_equal(protocol_init_fake.call_count, 1);
     zassert_equal(model_init_fake.call_count, 1);
+    zassert_not_null(g_ldr_tables[0][LOADER_TYPE_CONTROL]);
 }
 
 /**
@@ -355,6 +404,28 @@ ZTEST(kenning_inference_lib_test_inference_server, test_handle_message_callback_
 #undef TEST_HANDLE_MESSAGE
 }
 
+/**
+ * Tests if handle message sends model output for input pushed in stream session
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_handle_message_stream_input)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t transmission = prepare_event_to_recv(MESSAGE_TYPE_DATA, 0);
+
+    protocol_transmit_fake.custom_fake = protocol_transmit_mock;
+    stream_session_active_fake.return_val = true;
+    transmission.is_request = 0;
+    g_msg_callback[MESSAGE_TYPE_DATA] = callback_with_ok_response_with_payload_mock;
+
+    status = handle_protocol_event(&transmission);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(protocol_transmit_fake.call_count, 1);
+    zassert_equal(MESSAGE_TYPE_OUTPUT, gp_resp_message_to_send.hdr.message_type);
+    zassert_equal(128, gp_resp_message_to_send.hdr.payload_size);
+    zassert_equal(gp_resp_message_to_send.hdr.flags.general_purpose_flags.success, 1);
+}
+
 /**
  * Tests if handle message does nothing when message pointer is invalid
  */
@@ -368,6 +439,227 @@ ZTEST(kenning_inference_lib_test_inference_server, test_handle_message_inv_ptr)
     zassert_equal(protocol_transmit_fake.call_count, 0);
 }
 
+#ifdef CONFIG_KENNING_SERVER_PIPELINE
+
+// ========================================================
+// pipeline_loader_picker
+// ========================================================
+
+/**
+ * Tests if payload received while the pipeline is idle is received directly to its loader
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_pipeline_loader_picker_idle)
+{
+    struct msg_loader data_ldr = MSG_LOADER_BUF(NULL, 0);
+    struct msg_loader model_ldr = MSG_LOADER_BUF(NULL, 0);
+
+    memset(g_ldr_tables, 0, sizeof(g_ldr_tables));
+    g_ldr_tables[1][LOADER_TYPE_DATA] = &data_ldr;
+    g_ldr_tables[1][LOADER_TYPE_MODEL] = &model_ldr;
+    g_pending_events = 0;
+
+    zassert_equal(&data_ldr, pipeline_loader_picker(MESSAGE_TYPE_DATA, 16));
+    zassert_equal(&model_ldr, pipeline_loader_picker(MESSAGE_TYPE_MODEL, 2 * CONFIG_KENNING_SERVER_PIPELINE_INPUT_BUFFER_SIZE));
+    zassert_equal(0, k_sem_take_fake.call_count);
+    zassert_equal(0, k_condvar_wait_fake.call_count);
+}
+
+/**
+ * Tests if payload received while previous events are handled is received to the staging buffer without waiting
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_pipeline_loader_picker_busy)
+{
+    struct msg_loader data_ldr = MSG_LOADER_BUF(NULL, 0);
+    struct msg_loader control_ldr = MSG_LOADER_BUF(NULL, 0);
+    struct msg_loader *staging_ldr = NULL;
+
+    memset(g_ldr_tables, 0, sizeof(g_ldr_tables));
+    g_ldr_tables[1][LOADER_TYPE_DATA] = &data_ldr;
+    g_ldr_tables[0][LOADER_TYPE_CONTROL] = &control_ldr;
+    g_pending_events = 1;
+
+    staging_ldr = pipeline_loader_picker(MESSAGE_TYPE_DATA, 16);
+
+    zassert_not_null(staging_ldr);
+    zassert_not_equal(&data_ldr, staging_ldr);
+    zassert_equal(CONFIG_KENNING_SERVER_PIPELINE_INPUT_BUFFER_SIZE, staging_ldr->max_size);
+    zassert_equal(staging_ldr, pipeline_loader_picker(MESSAGE_TYPE_PING, 0));
+    zassert_equal(0, k_sem_take_fake.call_count);
+    zassert_equal(0, k_condvar_wait_fake.call_count);
+    g_pending_events = 0;
+}
+
+/**
+ * Tests if model and runtime uploads received while previous events are handled are rejected without waiting
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_pipeline_loader_picker_busy_upload)
+{
+    struct msg_loader model_ldr = MSG_LOADER_BUF(NULL, 0);
+    struct msg_loader runtime_ldr = MSG_LOADER_BUF(NULL, 0);
+
+    memset(g_ldr_tables, 0, sizeof(g_ldr_tables));
+    g_ldr_tables[1][LOADER_TYPE_MODEL] = &model_ldr;
+    g_ldr_tables[0][LOADER_TYPE_RUNTIME] = &runtime_ldr;
+    g_pending_events = 1;
+
+    zassert_is_null(pipeline_loader_picker(MESSAGE_TYPE_MODEL, 16));
+    zassert_is_null(pipeline_loader_picker(MESSAGE_TYPE_RUNTIME, 16));
+    zassert_equal(0, k_condvar_wait_fake.call_count);
+    g_pending_events = 0;
+}
+
+/**
+ * Tests if payload not fitting in the staging buffer received while previous events are handled is rejected without
+ * waiting
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_pipeline_loader_picker_busy_too_big)
+{
+    struct msg_loader data_ldr = MSG_LOADER_BUF(NULL, 0);
+
+    memset(g_ldr_tables, 0, sizeof(g_ldr_tables));
+    g_ldr_tables[1][LOADER_TYPE_DATA] = &data_ldr;
+    g_pending_events = 1;
+
+    zassert_is_null(pipeline_loader_picker(MESSAGE_TYPE_DATA, CONFIG_KENNING_SERVER_PIPELINE_INPUT_BUFFER_SIZE + 1));
+    zassert_not_null(pipeline_loader_picker(MESSAGE_TYPE_DATA, CONFIG_KENNING_SERVER_PIPELINE_INPUT_BUFFER_SIZE));
+    zassert_equal(0, k_sem_take_fake.call_count);
+    zassert_equal(0, k_condvar_wait_fake.call_count);
+    g_pending_events = 0;
+}
+
+// ========================================================
+// load_staged_payload
+// ========================================================
+
+/**
+ * Tests if payload received to the staging buffer is copied to its loader and the staging buffer is released
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_load_staged_payload)
+{
+    status_t status = STATUS_OK;
+    struct msg_loader data_ldr = MSG_LOADER_BUF(NULL, 0);
+    protocol_event_t event = prepare_event_to_recv(MESSAGE_TYPE_DATA, 16);
+
+    memset(g_ldr_tables, 0, sizeof(g_ldr_tables));
+    g_ldr_tables[1][LOADER_TYPE_DATA] = &data_ldr;
+    g_pending_events = 1;
+    event.payload.loader = pipeline_loader_picker(MESSAGE_TYPE_DATA, 16);
+    g_pending_events = 0;
+    buf_reset_fake.return_val = STATUS_OK;
+    buf_save_fake.return_val = STATUS_OK;
+
+    status = load_staged_payload(&event);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(&data_ldr, event.payload.loader);
+    zassert_equal(1, buf_reset_fake.call_count);
+    zassert_equal(1, buf_save_fake.call_count);
+    zassert_equal(&data_ldr, buf_save_fake.arg0_val);
+    zassert_equal(16, buf_save_fake.arg2_val);
+    zassert_equal(1, k_sem_give_fake.call_count);
+}
+
+/**
+ * Tests if payload received directly to its loader is left in place
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_load_staged_payload_not_staged)
+{
+    status_t status = STATUS_OK;
+    struct msg_loader data_ldr = MSG_LOADER_BUF(NULL, 0);
+    protocol_event_t event = prepare_event_to_recv(MESSAGE_TYPE_DATA, 16);
+
+    event.payload.loader = &data_ldr;
+
+    status = load_staged_payload(&event);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(&data_ldr, event.payload.loader);
+    zassert_equal(0, buf_save_fake.call_count);
+    zassert_equal(0, k_sem_give_fake.call_count);
+}
+
+// ========================================================
+// detach_response_payload
+// ========================================================
+
+/**
+ * Tests if model output sent from the runtime memory is copied to the response buffer together with statistics
+ * written to the beginning of the response buffer
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_detach_response_payload_output_view_with_stats)
+{
+    static uint8_t resp_buffer[CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE];
+    uint8_t runtime_output[12];
+    uint8_t expected[sizeof(runtime_output) + 8];
+    protocol_segment_t segments[2];
+    protocol_payload_t payload;
+
+    for (size_t i = 0; i < sizeof(runtime_output); i++)
+    {
+        runtime_output[i] = i;
+    }
+    // statistics are written to the beginning of the response buffer, as the output is not copied to it
+    for (size_t i = 0; i < 8; i++)
+    {
+        resp_buffer[i] = 0xA0 + i;
+    }
+    memcpy(expected, runtime_output, sizeof(runtime_output));
+    memcpy(expected + sizeof(runtime_output), resp_buffer, 8);
+    segments[0].data = runtime_output;
+    segments[0].size = sizeof(runtime_output);
+    segments[1].data = resp_buffer;
+    segments[1].size = 8;
+    payload.type = PROTOCOL_PAYLOAD_TYPE_SEGMENTS;
+    payload.segments = segments;
+    payload.segment_count = 2;
+    payload.size = sizeof(expected);
+
+    bool borrowed = detach_response_payload(&payload, resp_buffer);
+
+    zassert_false(borrowed);
+    zassert_equal(PROTOCOL_PAYLOAD_TYPE_BYTES, payload.type);
+    zassert_equal(resp_buffer, payload.raw_bytes);
+    zassert_equal(sizeof(expected), payload.size);
+    zassert_mem_equal(expected, resp_buffer, sizeof(expected));
+}
+
+/**
+ * Tests if model output copied to the response buffer is left in place
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_detach_response_payload_in_buffer)
+{
+    static uint8_t resp_buffer[CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE];
+    protocol_payload_t payload = {.raw_bytes = resp_buffer, .size = 16, .type = PROTOCOL_PAYLOAD_TYPE_BYTES};
+
+    bool borrowed = detach_response_payload(&payload, resp_buffer);
+
+    zassert_false(borrowed);
+    zassert_equal(resp_buffer, payload.raw_bytes);
+    zassert_equal(16, payload.size);
+}
+
+/**
+ * Tests if payload that does not fit in the response buffer is sent from the memory of the callback
+ */
+ZTEST(kenning_inference_lib_test_inference_server, test_detach_response_payload_too_big)
+{
+    static uint8_t resp_buffer[CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE];
+    static uint8_t runtime_output[CONFIG_KENNING_RESPONSE_PAYLOAD_SIZE + 1];
+    protocol_segment_t segment = {.data = runtime_output, .size = sizeof(runtime_output)};
+    protocol_payload_t payload = {.segments = &segment,
+                                  .segment_count = 1,
+                                  .size = sizeof(runtime_output),
+                                  .type = PROTOCOL_PAYLOAD_TYPE_SEGMENTS};
+
+    bool borrowed = detach_response_payload(&payload, resp_buffer);
+
+    zassert_true(borrowed);
+    zassert_equal(PROTOCOL_PAYLOAD_TYPE_SEGMENTS, payload.type);
+    zassert_equal(&segment, payload.segments);
+}
+
+#endif // CONFIG_KENNING_SERVER_PIPELINE
+
 // ========================================================
 // mocks
 // ========================================================
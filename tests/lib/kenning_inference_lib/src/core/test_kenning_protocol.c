@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 #include <zephyr/fff.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/ztest.h>
 
 #include <kenning_inference_lib/core/kenning_protocol.h>
@@ -17,28 +18,39 @@
 
 #define MOCK_BUFFER_SIZE 8192
 #define MOCK_LOADER_RESET_ERROR 37
+#define MOCK_LEASE_SIZE 32
 static uint8_t mock_write_buffer[MOCK_BUFFER_SIZE];
-static uint8_t mock_read_buffer[MOCK_BUFFER_SIZE];
+static uint8_t __attribute__((aligned(4))) mock_read_buffer[MOCK_BUFFER_SIZE];
 static uint8_t mock_loader_buffer[MOCK_BUFFER_SIZE];
 static int mock_write_buffer_idx;
 static int mock_read_buffer_idx;
 static int mock_loader_buffer_idx;
+static int mock_read_limit;
 
 // ========================================================
 // mocks
 // ========================================================
 DEFINE_FFF_GLOBALS;
 
-#define MOCKS(MOCK)                                        \
-    MOCK(const char *, get_status_str, status_t);          \
-    MOCK(status_t, protocol_read_data, uint8_t *, size_t); \
-    MOCK(status_t, protocol_write_data, const uint8_t *, size_t);
+#define MOCKS(MOCK)                                                     \
+    MOCK(const char *, get_status_str, status_t);                       \
+    MOCK(status_t, protocol_read_data, uint8_t *, size_t);              \
+    MOCK(status_t, protocol_write_data, const uint8_t *, size_t);       \
+    MOCK(status_t, protocol_lease, const uint8_t **, size_t, size_t *); \
+    MOCK(status_t, protocol_release, size_t);                           \
+    MOCK(struct msg_loader *, patching_loader, struct msg_loader *);
 
 MOCKS(DECLARE_MOCK);
 
 const char *get_status_str_mock(status_t);
 status_t protocol_read_data_mock(uint8_t *data, size_t data_length);
 status_t protocol_write_data_mock(const uint8_t *data, size_t data_length);
+status_t protocol_lease_mock(const uint8_t **data, size_t max_length, size_t *data_length);
+status_t protocol_lease_unaligned_mock(const uint8_t **data, size_t max_length, size_t *data_length);
+status_t protocol_release_mock(size_t data_length);
+status_t protocol_write_data_log_mock(const uint8_t *data, size_t data_length);
+status_t protocol_read_data_interrupted_mock(uint8_t *data, size_t data_length);
+struct msg_loader *patching_loader_mock(struct msg_loader *ldr);
 
 // ========================================================
 // helper functions declarations
@@ -60,6 +72,7 @@ void prepare_message_in_buffer(message_type_t message_type, flags_t flags, flow_
 static void kenning_protocol_tests_setup_f()
 {
     MOCKS(RESET_MOCK);
+    protocol_lease_fake.return_val = PROTOCOL_STATUS_NOT_SUPPORTED;
     memset(mock_write_buffer, 0, MOCK_BUFFER_SIZE);
     memset(mock_read_buffer, 0, MOCK_BUFFER_SIZE);
     memset(mock_loader_buffer, 0, MOCK_BUFFER_SIZE);
@@ -92,6 +105,18 @@ status_t protocol_read_data_mock(uint8_t *data, size_t data_length)
     return STATUS_OK;
 }
 
+/**
+ * Reads data like protocol_read_data_mock, timing out when mock_read_limit bytes are read
+ */
+status_t protocol_read_data_interrupted_mock(uint8_t *data, size_t data_length)
+{
+    if (mock_read_buffer_idx + data_length > mock_read_limit)
+    {
+        return PROTOCOL_STATUS_TIMEOUT;
+    }
+    return protocol_read_data_mock(data, data_length);
+}
+
 status_t protocol_write_data_mock(const uint8_t *data, size_t data_length)
 {
     RETURN_ERROR_IF_POINTER_INVALID(data, PROTOCOL_STATUS_INV_PTR);
@@ -106,6 +131,49 @@ status_t protocol_write_data_mock(const uint8_t *data, size_t data_length)
     return STATUS_OK;
 }
 
+#define MOCK_LOG_SIZE 4
+static uint8_t mock_log_buffer[CONFIG_KENNING_PROTOCOL_TX_QUEUE_SIZE + MOCK_LOG_SIZE];
+static payload_size_t mock_log_size;
+static status_t mock_log_status;
+
+/**
+ * Writes data like protocol_write_data_mock, transmitting logs of size mock_log_size while writing the first data
+ */
+status_t protocol_write_data_log_mock(const uint8_t *data, size_t data_length)
+{
+    if (1 == protocol_write_data_fake.call_count)
+    {
+        protocol_event_t log;
+        log.message_type = MESSAGE_TYPE_LOGS;
+        log.flags.raw_bytes = 0;
+        log.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
+        log.payload.raw_bytes = mock_log_buffer;
+        log.payload.size = mock_log_size;
+        mock_log_status = protocol_transmit(&log);
+    }
+    return protocol_write_data_mock(data, data_length);
+}
+
+status_t protocol_lease_mock(const uint8_t **data, size_t max_length, size_t *data_length)
+{
+    *data = mock_read_buffer + mock_read_buffer_idx;
+    *data_length = max_length > MOCK_LEASE_SIZE ? MOCK_LEASE_SIZE : max_length;
+    return STATUS_OK;
+}
+
+status_t protocol_lease_unaligned_mock(const uint8_t **data, size_t max_length, size_t *data_length)
+{
+    *data = mock_read_buffer + 1;
+    *data_length = 1;
+    return STATUS_OK;
+}
+
+status_t protocol_release_mock(size_t data_length)
+{
+    mock_read_buffer_idx += data_length;
+    return STATUS_OK;
+}
+
 int loader_reset_mock(struct msg_loader *ldr)
 {
     mock_loader_buffer_idx = 0;
@@ -121,11 +189,31 @@ int loader_save_mock(struct msg_loader *ldr, const uint8_t *src, size_t n)
     return 0;
 }
 
+int loader_lease_window_mock(struct msg_loader *ldr, uint8_t **dst, size_t *size)
+{
+    if (ldr->written >= ldr->max_size)
+    {
+        return 1;
+    }
+    *dst = mock_loader_buffer + ldr->written;
+    *size = ldr->max_size - ldr->written;
+    return 0;
+}
+
+int loader_commit_window_mock(struct msg_loader *ldr, size_t n)
+{
+    mock_loader_buffer_idx += n;
+    ldr->written += n;
+    return 0;
+}
+
+struct msg_loader *patching_loader_mock(struct msg_loader *ldr) { return ldr; }
+
 int loader_reset_failure_mock(struct msg_loader *ldr) { return MOCK_LOADER_RESET_ERROR; }
 
 int loader_save_failure_mock(struct msg_loader *ldr, const uint8_t *src, size_t n) { return 1; }
 
-struct msg_loader *get_loader(message_type_t message_type)
+struct msg_loader *get_loader(message_type_t message_type, payload_size_t payload_size)
 {
     static struct msg_loader ldr = {
         .save = loader_save_mock,
@@ -134,7 +222,7 @@ struct msg_loader *get_loader(message_type_t message_type)
     return &ldr;
 }
 
-struct msg_loader *get_loader_reset_fail(message_type_t message_type)
+struct msg_loader *get_loader_reset_fail(message_type_t message_type, payload_size_t payload_size)
 {
     static struct msg_loader ldr = {
         .save = loader_save_mock,
@@ -143,7 +231,7 @@ struct msg_loader *get_loader_reset_fail(message_type_t message_type)
     return &ldr;
 }
 
-struct msg_loader *get_loader_save_fail(message_type_t message_type)
+struct msg_loader *get_loader_save_fail(message_type_t message_type, payload_size_t payload_size)
 {
     static struct msg_loader ldr = {
         .save = loader_save_failure_mock,
@@ -152,6 +240,20 @@ struct msg_loader *get_loader_save_fail(message_type_t message_type)
     return &ldr;
 }
 
+struct msg_loader *get_loader_window(message_type_t message_type, payload_size_t payload_size)
+{
+    static struct msg_loader ldr = {
+        .save = loader_save_failure_mock,
+        .reset = loader_reset_mock,
+        .lease_window = loader_lease_window_mock,
+        .commit_window = loader_commit_window_mock,
+        .max_size = 200,
+    };
+    return &ldr;
+}
+
+struct msg_loader *get_no_loader(message_type_t message_type, payload_size_t payload_size) { return NULL; }
+
 // ========================================================
 // listen
 // ========================================================
@@ -273,6 +375,137 @@ ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_empty_me
 #undef TEST_PROTOCOL_LISTEN
 }
 
+/**
+ * Tests if payload leased from the transport is passed to the loader.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_leased_payload)
+{
+    status_t status = STATUS_OK;
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    protocol_lease_fake.custom_fake = protocol_lease_mock;
+    protocol_release_fake.custom_fake = protocol_release_mock;
+    flags_t test_flags;
+    protocol_event_t event;
+    uint8_t expected_payload[100];
+    memset(expected_payload, 'x', sizeof(expected_payload));
+    test_flags.raw_bytes = 0b0001000000111100;
+    prepare_message_in_buffer(MESSAGE_TYPE_IOSPEC, test_flags, FLOW_CONTROL_REQUEST, sizeof(expected_payload));
+    int expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+    status = protocol_listen(&event, get_loader);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, sizeof(expected_payload));
+    zassert_equal(mock_read_buffer_idx, expected_size);
+    zassert_equal(protocol_read_data_fake.call_count, 1);
+    zassert_equal(protocol_release_fake.call_count, 4);
+    zassert_mem_equal(mock_loader_buffer, expected_payload, sizeof(expected_payload));
+}
+
+/**
+ * Tests if payload is read into the buffer when data leased from the transport is not word aligned.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_unaligned_lease)
+{
+    status_t status = STATUS_OK;
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    protocol_lease_fake.custom_fake = protocol_lease_unaligned_mock;
+    protocol_release_fake.custom_fake = protocol_release_mock;
+    flags_t test_flags;
+    protocol_event_t event;
+    test_flags.raw_bytes = 0b0001000000111100;
+    prepare_message_in_buffer(MESSAGE_TYPE_IOSPEC, test_flags, FLOW_CONTROL_REQUEST, 100);
+    int expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+    status = protocol_listen(&event, get_loader);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, 100);
+    zassert_equal(mock_read_buffer_idx, expected_size);
+    zassert_equal(protocol_release_fake.arg0_val, 0);
+}
+
+/**
+ * Tests if payload is read directly into the write window of the loader.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_loader_window)
+{
+    status_t status = STATUS_OK;
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    protocol_lease_fake.custom_fake = protocol_lease_mock;
+    protocol_release_fake.custom_fake = protocol_release_mock;
+    flags_t test_flags;
+    protocol_event_t event;
+    uint8_t expected_payload[150];
+    memset(expected_payload, 'x', sizeof(expected_payload));
+    test_flags.raw_bytes = 0b0001000000111100;
+    prepare_message_in_buffer(MESSAGE_TYPE_IOSPEC, test_flags, FLOW_CONTROL_REQUEST, sizeof(expected_payload));
+    int expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+    status = protocol_listen(&event, get_loader_window);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, sizeof(expected_payload));
+    zassert_equal(mock_read_buffer_idx, expected_size);
+    zassert_equal(protocol_read_data_fake.call_count, 2);
+    zassert_equal(protocol_lease_fake.call_count, 0);
+    zassert_mem_equal(mock_loader_buffer, expected_payload, sizeof(expected_payload));
+}
+
+/**
+ * Tests if payload that does not fit in the write window of the loader is discarded.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_loader_window_too_small)
+{
+    status_t status = STATUS_OK;
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    flags_t test_flags;
+    protocol_event_t event;
+    test_flags.raw_bytes = 0b0001000000111100;
+    prepare_message_in_buffer(MESSAGE_TYPE_IOSPEC, test_flags, FLOW_CONTROL_REQUEST, 300);
+    int expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+    status = protocol_listen(&event, get_loader_window);
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_MSG_TOO_BIG);
+    zassert_equal(mock_read_buffer_idx, expected_size);
+    zassert_equal(mock_loader_buffer_idx, 200);
+}
+
+/**
+ * Tests if payload is discarded and proper error is returned if the message type has no loader.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_no_loader)
+{
+    status_t status = STATUS_OK;
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    flags_t test_flags;
+    protocol_event_t event;
+    test_flags.raw_bytes = 0b0001000000111100;
+    prepare_message_in_buffer(MESSAGE_TYPE_PROCESS, test_flags, FLOW_CONTROL_REQUEST, 100);
+    int expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+    status = protocol_listen(&event, get_no_loader);
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_UNEXPECTED_PAYLOAD);
+    zassert_equal(mock_read_buffer_idx, expected_size);
+}
+
+/**
+ * Tests if a message without payload is received properly if the message type has no loader.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_no_loader_empty_message)
+{
+    status_t status = STATUS_OK;
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    flags_t test_flags;
+    protocol_event_t event;
+    test_flags.raw_bytes = 0b0001000000110100;
+    prepare_message_in_buffer(MESSAGE_TYPE_PROCESS, test_flags, FLOW_CONTROL_REQUEST, 0);
+    int expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+    status = protocol_listen(&event, get_no_loader);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, 0);
+    zassert_equal(event.message_type, MESSAGE_TYPE_PROCESS);
+    zassert_equal(mock_read_buffer_idx, expected_size);
+}
+
 /**
  * Tests if proper error is returned if an the first message has not 'first' flag set.
  */
@@ -406,7 +639,7 @@ ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_invalid_
     zassert_equal(mock_read_buffer_idx, expected_size);
 
     TEST_PROTOCOL_LISTEN(34);
-    TEST_PROTOCOL_LISTEN(17);
+    TEST_PROTOCOL_LISTEN(NUM_MESSAGE_TYPES);
 #undef TEST_PROTOCOL_LISTEN
 }
 
@@ -454,6 +687,194 @@ ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_null_eve
     zassert_equal(status, KENNING_PROTOCOL_STATUS_INV_PTR);
 }
 
+/**
+ * Tests if a MODEL transmission interrupted by a receive error can be resumed without resetting the loader.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_resume_upload)
+{
+    status_t status = STATUS_OK;
+    flags_t test_flags;
+    protocol_event_t event;
+    message_type_t message_type;
+    bool compressed;
+    bool patch;
+    size_t offset;
+
+    protocol_read_data_fake.custom_fake = protocol_read_data_interrupted_mock;
+    test_flags.raw_bytes = 0;
+    test_flags.general_purpose_flags.has_payload = 1;
+    test_flags.general_purpose_flags.first = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    test_flags.general_purpose_flags.first = 0;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    mock_read_limit = mock_read_buffer_idx - 50;
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(KENNING_PROTOCOL_STATUS_TIMEOUT, status);
+    zassert_true(protocol_get_interrupted_upload(&message_type, &compressed, &patch, &offset));
+    zassert_equal(MESSAGE_TYPE_MODEL, message_type);
+    zassert_false(compressed);
+    zassert_false(patch);
+    zassert_equal(mock_loader_buffer_idx, offset);
+
+    mock_read_buffer_idx = 0;
+    test_flags.general_purpose_flags.first = 1;
+    test_flags.general_purpose_flags.last = 1;
+    test_flags.flags_upload.resume = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 200 - offset);
+    mock_read_limit = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(200, event.payload.size);
+    zassert_equal(200, mock_loader_buffer_idx);
+    zassert_false(protocol_get_interrupted_upload(&message_type, &compressed, &patch, &offset));
+}
+
+/**
+ * Tests if a transmission with the resume flag is rejected when there is no interrupted transmission.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_resume_not_interrupted)
+{
+    status_t status = STATUS_OK;
+    flags_t test_flags;
+    protocol_event_t event;
+    int expected_size;
+
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    test_flags.raw_bytes = 0;
+    test_flags.general_purpose_flags.has_payload = 1;
+    test_flags.general_purpose_flags.first = 1;
+    test_flags.general_purpose_flags.last = 1;
+    test_flags.flags_upload.resume = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_RUNTIME, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(KENNING_PROTOCOL_STATUS_INV_ARG, status);
+    zassert_equal(expected_size, mock_read_buffer_idx);
+    zassert_equal(0, mock_loader_buffer_idx);
+}
+
+/**
+ * Tests if a MODEL transmission with the patch flag is saved through the patching loader.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_patch_model)
+{
+    status_t status = STATUS_OK;
+    flags_t test_flags;
+    protocol_event_t event;
+
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    patching_loader_fake.custom_fake = patching_loader_mock;
+    test_flags.raw_bytes = 0;
+    test_flags.general_purpose_flags.has_payload = 1;
+    test_flags.general_purpose_flags.first = 1;
+    test_flags.general_purpose_flags.last = 1;
+    test_flags.flags_upload.patch = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, patching_loader_fake.call_count);
+    zassert_equal(get_loader(MESSAGE_TYPE_MODEL, 0), patching_loader_fake.arg0_val);
+    zassert_equal(100, mock_loader_buffer_idx);
+}
+
+/**
+ * Tests if a MODEL transmission with the patch flag is rejected until the interrupted MODEL transmission is replaced
+ * with a complete one.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_patch_incomplete_model)
+{
+    status_t status = STATUS_OK;
+    flags_t test_flags;
+    protocol_event_t event;
+    int expected_size;
+
+    protocol_read_data_fake.custom_fake = protocol_read_data_interrupted_mock;
+    patching_loader_fake.custom_fake = patching_loader_mock;
+    test_flags.raw_bytes = 0;
+    test_flags.general_purpose_flags.has_payload = 1;
+    test_flags.general_purpose_flags.first = 1;
+    test_flags.general_purpose_flags.last = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    mock_read_limit = mock_read_buffer_idx - 50;
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(KENNING_PROTOCOL_STATUS_TIMEOUT, status);
+
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    mock_read_buffer_idx = 0;
+    mock_loader_buffer_idx = 0;
+    test_flags.flags_upload.patch = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(KENNING_PROTOCOL_STATUS_INV_ARG, status);
+    zassert_equal(0, patching_loader_fake.call_count);
+    zassert_equal(expected_size, mock_read_buffer_idx);
+    zassert_equal(0, mock_loader_buffer_idx);
+
+    mock_read_buffer_idx = 0;
+    test_flags.flags_upload.patch = 0;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    test_flags.flags_upload.patch = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_MODEL, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(STATUS_OK, status);
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, patching_loader_fake.call_count);
+}
+
+/**
+ * Tests if a transmission with the patch flag is rejected for message types other than MODEL.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_listen_patch_runtime)
+{
+    status_t status = STATUS_OK;
+    flags_t test_flags;
+    protocol_event_t event;
+    int expected_size;
+
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    patching_loader_fake.custom_fake = patching_loader_mock;
+    test_flags.raw_bytes = 0;
+    test_flags.general_purpose_flags.has_payload = 1;
+    test_flags.general_purpose_flags.first = 1;
+    test_flags.general_purpose_flags.last = 1;
+    test_flags.flags_upload.patch = 1;
+    prepare_message_in_buffer(MESSAGE_TYPE_RUNTIME, test_flags, FLOW_CONTROL_TRANSMISSION, 100);
+    expected_size = mock_read_buffer_idx;
+    mock_read_buffer_idx = 0;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(KENNING_PROTOCOL_STATUS_INV_ARG, status);
+    zassert_equal(0, patching_loader_fake.call_count);
+    zassert_equal(expected_size, mock_read_buffer_idx);
+    zassert_equal(0, mock_loader_buffer_idx);
+}
+
 // ========================================================
 // transmit
 // ========================================================
@@ -521,6 +942,7 @@ ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit)
     protocol_event_t transmission;
     transmission.message_type = MESSAGE_TYPE_IOSPEC;
     transmission.flags = test_flags;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
     transmission.payload.raw_bytes = test_payload_buffer;
 
     // In prj.conf file for the tests we override the meximum message size (setting it to 8).
@@ -568,6 +990,67 @@ ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit_null_p
     zassert_equal(status, KENNING_PROTOCOL_STATUS_INV_PTR);
 }
 
+/**
+ * Tests if logs transmitted while another transmission is being sent are queued and sent after it
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit_queued_log)
+{
+    status_t status;
+    uint8_t test_payload_buffer[4] = {1, 2, 3, 4};
+    const message_hdr_t *hdr = NULL;
+
+    protocol_event_t transmission;
+    transmission.message_type = MESSAGE_TYPE_IOSPEC;
+    transmission.flags.raw_bytes = 0;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
+    transmission.payload.raw_bytes = test_payload_buffer;
+    transmission.payload.size = sizeof(test_payload_buffer);
+    memset(mock_log_buffer, 'l', MOCK_LOG_SIZE);
+    mock_log_size = MOCK_LOG_SIZE;
+    mock_log_status = KENNING_PROTOCOL_STATUS_ERROR;
+    protocol_write_data_fake.custom_fake = protocol_write_data_log_mock;
+
+    status = protocol_transmit(&transmission);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(mock_log_status, STATUS_OK);
+    zassert_equal(protocol_write_data_fake.call_count, 4);
+    hdr = (message_hdr_t *)mock_write_buffer;
+    zassert_equal(hdr->message_type, MESSAGE_TYPE_IOSPEC);
+    zassert_mem_equal(mock_write_buffer + sizeof(message_hdr_t), test_payload_buffer, sizeof(test_payload_buffer));
+    hdr = (message_hdr_t *)(mock_write_buffer + sizeof(message_hdr_t) + sizeof(test_payload_buffer));
+    zassert_equal(hdr->message_type, MESSAGE_TYPE_LOGS);
+    zassert_equal(hdr->payload_size, MOCK_LOG_SIZE);
+    zassert_equal(hdr->flags.general_purpose_flags.first, 1);
+    zassert_equal(hdr->flags.general_purpose_flags.last, 1);
+    zassert_mem_equal((uint8_t *)hdr + sizeof(message_hdr_t), mock_log_buffer, MOCK_LOG_SIZE);
+}
+
+/**
+ * Tests if logs that do not fit in the queue are rejected while another transmission is being sent
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit_queue_full)
+{
+    status_t status;
+    uint8_t test_payload_buffer[4] = {0};
+
+    protocol_event_t transmission;
+    transmission.message_type = MESSAGE_TYPE_IOSPEC;
+    transmission.flags.raw_bytes = 0;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
+    transmission.payload.raw_bytes = test_payload_buffer;
+    transmission.payload.size = sizeof(test_payload_buffer);
+    mock_log_size = sizeof(mock_log_buffer);
+    mock_log_status = STATUS_OK;
+    protocol_write_data_fake.custom_fake = protocol_write_data_log_mock;
+
+    status = protocol_transmit(&transmission);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(mock_log_status, KENNING_PROTOCOL_STATUS_BUSY);
+    zassert_equal(protocol_write_data_fake.call_count, 2);
+}
+
 /**
  * Tests if protocol_transmit returns proper error message when given an invalid pointer;
  */
@@ -578,6 +1061,7 @@ ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit_lower_
 
     protocol_event_t transmission;
     transmission.message_type = MESSAGE_TYPE_IOSPEC;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
     transmission.payload.raw_bytes = test_payload_buffer;
     transmission.payload.size = 14;
 #define TEST_PROTOCOL_TRANSMIT(error, expected_error) \
@@ -592,6 +1076,73 @@ ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit_lower_
 #undef TEST_PROTOCOL_TRANSMIT
 }
 
+/**
+ * Tests if payload given as a list of segments is sent without copying, with messages not spanning segments.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit_segments)
+{
+    status_t status;
+    uint8_t test_payload_buffer[100];
+    const protocol_segment_t segments[] = {
+        {.data = test_payload_buffer, .size = 5},
+        {.data = test_payload_buffer + 20, .size = 0},
+        {.data = test_payload_buffer + 40, .size = 12},
+    };
+    const uint8_t *expected_payloads[] = {test_payload_buffer, test_payload_buffer + 40, test_payload_buffer + 48};
+    const payload_size_t expected_sizes[] = {5, 8, 4};
+    size_t offset = 0;
+
+    protocol_write_data_fake.custom_fake = protocol_write_data_mock;
+    protocol_event_t transmission;
+    transmission.message_type = MESSAGE_TYPE_OUTPUT;
+    transmission.flags.raw_bytes = 0;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_SEGMENTS;
+    transmission.payload.segments = segments;
+    transmission.payload.segment_count = ARRAY_SIZE(segments);
+    transmission.payload.size = 17;
+
+    status = protocol_transmit(&transmission);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(protocol_write_data_fake.call_count, 6);
+    for (int i = 0; i < 3; i++)
+    {
+        const message_hdr_t *hdr = (const message_hdr_t *)(mock_write_buffer + offset);
+        zassert_equal(hdr->payload_size, expected_sizes[i]);
+        zassert_equal(hdr->flags.general_purpose_flags.first, i == 0);
+        zassert_equal(hdr->flags.general_purpose_flags.last, i == 2);
+        zassert_equal(protocol_write_data_fake.arg0_history[2 * i + 1], expected_payloads[i]);
+        offset += sizeof(message_hdr_t) + hdr->payload_size;
+    }
+}
+
+/**
+ * Tests if transmission fails when payload segments are smaller than the declared payload size.
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol, test_protocol_transmit_segments_too_small)
+{
+    status_t status;
+    uint8_t test_payload_buffer[100];
+    const protocol_segment_t segments[] = {
+        {.data = test_payload_buffer, .size = 4},
+        {.data = test_payload_buffer + 50, .size = 4},
+    };
+
+    protocol_write_data_fake.custom_fake = protocol_write_data_mock;
+    protocol_event_t transmission;
+    transmission.message_type = MESSAGE_TYPE_OUTPUT;
+    transmission.flags.raw_bytes = 0;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_SEGMENTS;
+    transmission.payload.segments = segments;
+    transmission.payload.segment_count = ARRAY_SIZE(segments);
+    transmission.payload.size = 10;
+
+    status = protocol_transmit(&transmission);
+
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_INV_ARG);
+    zassert_equal(protocol_write_data_fake.call_count, 4);
+}
+
 // ========================================================
 // helper functions
 // ========================================================
@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+
+#include <kenning_inference_lib/core/kenning_protocol.h>
+#include <kenning_inference_lib/core/loaders.h>
+
+#include "kenning_inference_lib/core/protocol.h"
+#include "kenning_inference_lib/core/utils.h"
+#include "utils.h"
+
+#define MOCK_BUFFER_SIZE 4096
+#define TEST_MESSAGE_PAYLOAD_SIZE 100
+static uint8_t mock_write_buffer[MOCK_BUFFER_SIZE];
+static uint8_t mock_read_buffer[MOCK_BUFFER_SIZE];
+static uint8_t mock_loader_buffer[MOCK_BUFFER_SIZE];
+static size_t mock_write_buffer_idx;
+static size_t mock_read_buffer_idx;
+static size_t mock_read_buffer_length;
+static size_t mock_loader_buffer_idx;
+static int g_loader_picks;
+static message_type_t g_picked_message_type;
+
+// ========================================================
+// mocks
+// ========================================================
+DEFINE_FFF_GLOBALS;
+
+#define MOCKS(MOCK)                                                     \
+    MOCK(const char *, get_status_str, status_t);                       \
+    MOCK(status_t, protocol_read_data, uint8_t *, size_t);              \
+    MOCK(status_t, protocol_write_data, const uint8_t *, size_t);       \
+    MOCK(status_t, protocol_lease, const uint8_t **, size_t, size_t *); \
+    MOCK(status_t, protocol_release, size_t);                           \
+    MOCK(struct msg_loader *, patching_loader, struct msg_loader *);
+
+MOCKS(DECLARE_MOCK);
+
+status_t protocol_read_data_mock(uint8_t *data, size_t data_length);
+status_t protocol_write_data_mock(const uint8_t *data, size_t data_length);
+
+// ========================================================
+// helper functions declarations
+// ========================================================
+
+/**
+ * Computes checksum of the message in the same way as the Kenning client
+ *
+ * @param header message header
+ * @param payload message payload
+ *
+ * @returns checksum of the message
+ */
+checksum_t compute_checksum(const message_hdr_t *header, const uint8_t *payload);
+
+/**
+ * Adds message with payload filled with consecutive numbers starting from offset to read buffer
+ *
+ * @param flags flags of the message
+ * @param offset value of the first payload byte
+ * @param payload_size size of the payload
+ * @param corrupted whether payload should be altered after computing checksum
+ */
+void prepare_message_in_buffer(flags_t flags, size_t offset, size_t payload_size, bool corrupted);
+
+/**
+ * Checks if the message written at given index is a confirmation with given flow control value
+ *
+ * @param idx index of the confirmation in the write buffer
+ * @param flow_control_flags expected flow control value
+ *
+ * @returns true if the confirmation is valid
+ */
+bool is_confirmation(size_t idx, flow_control_flags_t flow_control_flags);
+
+// ========================================================
+// setup
+// ========================================================
+
+static void kenning_protocol_checksum_tests_setup_f()
+{
+    MOCKS(RESET_MOCK);
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    protocol_write_data_fake.custom_fake = protocol_write_data_mock;
+    protocol_lease_fake.return_val = PROTOCOL_STATUS_NOT_SUPPORTED;
+    memset(mock_write_buffer, 0, MOCK_BUFFER_SIZE);
+    memset(mock_read_buffer, 0, MOCK_BUFFER_SIZE);
+    memset(mock_loader_buffer, 0, MOCK_BUFFER_SIZE);
+    mock_write_buffer_idx = 0;
+    mock_read_buffer_idx = 0;
+    mock_read_buffer_length = 0;
+    mock_loader_buffer_idx = 0;
+    g_loader_picks = 0;
+    g_picked_message_type = NUM_MESSAGE_TYPES;
+}
+
+ZTEST_SUITE(kenning_inference_lib_test_kenning_protocol_checksum, NULL, NULL, kenning_protocol_checksum_tests_setup_f,
+            NULL, NULL);
+
+// ========================================================
+// mocks definitions
+// ========================================================
+
+uint8_t crc8_ccitt(uint8_t val, const void *buf, size_t cnt)
+{
+    const uint8_t *data = buf;
+
+    for (size_t i = 0; i < cnt; ++i)
+    {
+        val ^= data[i];
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            val = (val & 0x80) ? (val << 1) ^ 0x07 : val << 1;
+        }
+    }
+    return val;
+}
+
+status_t protocol_read_data_mock(uint8_t *data, size_t data_length)
+{
+    if (mock_read_buffer_idx + data_length > mock_read_buffer_length)
+    {
+        return PROTOCOL_STATUS_TIMEOUT;
+    }
+    if (data != NULL)
+    {
+        memcpy(data, mock_read_buffer + mock_read_buffer_idx, data_length);
+    }
+    mock_read_buffer_idx += data_length;
+    return STATUS_OK;
+}
+
+status_t protocol_write_data_mock(const uint8_t *data, size_t data_length)
+{
+    if (mock_write_buffer_idx + data_length > MOCK_BUFFER_SIZE)
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    memcpy(mock_write_buffer + mock_write_buffer_idx, data, data_length);
+    mock_write_buffer_idx += data_length;
+    return STATUS_OK;
+}
+
+int loader_reset_mock(struct msg_loader *ldr)
+{
+    mock_loader_buffer_idx = 0;
+    ldr->written = 0;
+    return 0;
+}
+
+int loader_save_mock(struct msg_loader *ldr, const uint8_t *src, size_t n)
+{
+    memcpy(mock_loader_buffer + mock_loader_buffer_idx, src, n);
+    mock_loader_buffer_idx += n;
+    ldr->written += n;
+    return 0;
+}
+
+int loader_rewind_mock(struct msg_loader *ldr, size_t written)
+{
+    mock_loader_buffer_idx = written;
+    ldr->written = written;
+    return 0;
+}
+
+struct msg_loader *get_loader(message_type_t message_type, payload_size_t payload_size)
+{
+    static struct msg_loader ldr = {
+        .save = loader_save_mock,
+        .reset = loader_reset_mock,
+        .rewind = loader_rewind_mock,
+    };
+    return &ldr;
+}
+
+struct msg_loader *get_loader_counted(message_type_t message_type, payload_size_t payload_size)
+{
+    g_loader_picks++;
+    g_picked_message_type = message_type;
+    return get_loader(message_type, payload_size);
+}
+
+struct msg_loader *get_loader_without_rewind(message_type_t message_type, payload_size_t payload_size)
+{
+    static struct msg_loader ldr = {
+        .save = loader_save_mock,
+        .reset = loader_reset_mock,
+    };
+    return &ldr;
+}
+
+// ========================================================
+// listen
+// ========================================================
+
+/**
+ * Tests if each received message is acknowledged
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_acknowledges_messages)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    prepare_message_in_buffer(flags, 0, TEST_MESSAGE_PAYLOAD_SIZE, false);
+    flags.general_purpose_flags.first = 0;
+    flags.general_purpose_flags.last = 1;
+    prepare_message_in_buffer(flags, TEST_MESSAGE_PAYLOAD_SIZE, TEST_MESSAGE_PAYLOAD_SIZE, false);
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, 2 * TEST_MESSAGE_PAYLOAD_SIZE);
+    zassert_equal(mock_write_buffer_idx, 2 * sizeof(message_hdr_t));
+    zassert_true(is_confirmation(0, FLOW_CONTROL_ACKNOWLEDGE));
+    zassert_true(is_confirmation(1, FLOW_CONTROL_ACKNOWLEDGE));
+}
+
+/**
+ * Tests if only the corrupted message is received again
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_retransmission)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    prepare_message_in_buffer(flags, 0, TEST_MESSAGE_PAYLOAD_SIZE, false);
+    flags.general_purpose_flags.first = 0;
+    prepare_message_in_buffer(flags, TEST_MESSAGE_PAYLOAD_SIZE, TEST_MESSAGE_PAYLOAD_SIZE, true);
+    prepare_message_in_buffer(flags, TEST_MESSAGE_PAYLOAD_SIZE, TEST_MESSAGE_PAYLOAD_SIZE, false);
+    flags.general_purpose_flags.last = 1;
+    prepare_message_in_buffer(flags, 2 * TEST_MESSAGE_PAYLOAD_SIZE, TEST_MESSAGE_PAYLOAD_SIZE, false);
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, 3 * TEST_MESSAGE_PAYLOAD_SIZE);
+    for (size_t i = 0; i < 3 * TEST_MESSAGE_PAYLOAD_SIZE; ++i)
+    {
+        zassert_equal(mock_loader_buffer[i], (uint8_t)i);
+    }
+    zassert_equal(mock_write_buffer_idx, 4 * sizeof(message_hdr_t));
+    zassert_true(is_confirmation(0, FLOW_CONTROL_ACKNOWLEDGE));
+    zassert_true(is_confirmation(1, FLOW_CONTROL_REQUEST_RETRANSMIT));
+    zassert_true(is_confirmation(2, FLOW_CONTROL_ACKNOWLEDGE));
+    zassert_true(is_confirmation(3, FLOW_CONTROL_ACKNOWLEDGE));
+}
+
+/**
+ * Tests if loader is picked only after the first message with corrupted header is received again
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_first_header_corrupted)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    prepare_message_in_buffer(flags, 0, TEST_MESSAGE_PAYLOAD_SIZE, false);
+    ((message_hdr_t *)mock_read_buffer)->message_type = MESSAGE_TYPE_RUNTIME;
+    prepare_message_in_buffer(flags, 0, TEST_MESSAGE_PAYLOAD_SIZE, false);
+
+    status = protocol_listen(&event, get_loader_counted);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.message_type, MESSAGE_TYPE_MODEL);
+    zassert_equal(g_loader_picks, 1);
+    zassert_equal(g_picked_message_type, MESSAGE_TYPE_MODEL);
+    for (size_t i = 0; i < TEST_MESSAGE_PAYLOAD_SIZE; ++i)
+    {
+        zassert_equal(mock_loader_buffer[i], (uint8_t)i);
+    }
+    zassert_equal(mock_write_buffer_idx, 2 * sizeof(message_hdr_t));
+    zassert_equal(((message_hdr_t *)mock_write_buffer)->flow_control_flags, FLOW_CONTROL_REQUEST_RETRANSMIT);
+    zassert_true(is_confirmation(1, FLOW_CONTROL_ACKNOWLEDGE));
+}
+
+/**
+ * Tests if the first message that does not fit in the staging buffer is received again after it is verified
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_first_message_not_staged)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+    size_t payload_size = CONFIG_KENNING_MESSAGE_RECV_BUFFER_SIZE + 1;
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    prepare_message_in_buffer(flags, 0, payload_size, false);
+    prepare_message_in_buffer(flags, 0, payload_size, false);
+
+    status = protocol_listen(&event, get_loader_counted);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, payload_size);
+    zassert_equal(g_loader_picks, 1);
+    for (size_t i = 0; i < payload_size; ++i)
+    {
+        zassert_equal(mock_loader_buffer[i], (uint8_t)i);
+    }
+    zassert_equal(mock_write_buffer_idx, 2 * sizeof(message_hdr_t));
+    zassert_true(is_confirmation(0, FLOW_CONTROL_REQUEST_RETRANSMIT));
+    zassert_true(is_confirmation(1, FLOW_CONTROL_ACKNOWLEDGE));
+}
+
+/**
+ * Tests if reception fails when message is corrupted more times than allowed
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_retransmission_limit)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    for (int i = 0; i <= CONFIG_KENNING_PROTOCOL_MAX_RETRANSMISSIONS; ++i)
+    {
+        prepare_message_in_buffer(flags, 0, TEST_MESSAGE_PAYLOAD_SIZE, true);
+    }
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR);
+    zassert_equal(mock_write_buffer_idx, CONFIG_KENNING_PROTOCOL_MAX_RETRANSMISSIONS * sizeof(message_hdr_t));
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+/**
+ * Tests if retransmission is not requested when loader cannot drop data saved from the previous messages
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_loader_without_rewind)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    prepare_message_in_buffer(flags, 0, TEST_MESSAGE_PAYLOAD_SIZE, false);
+    flags.general_purpose_flags.first = 0;
+    flags.general_purpose_flags.last = 1;
+    prepare_message_in_buffer(flags, TEST_MESSAGE_PAYLOAD_SIZE, TEST_MESSAGE_PAYLOAD_SIZE, true);
+
+    status = protocol_listen(&event, get_loader_without_rewind);
+
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR);
+    zassert_equal(mock_write_buffer_idx, sizeof(message_hdr_t));
+    zassert_true(is_confirmation(0, FLOW_CONTROL_ACKNOWLEDGE));
+}
+
+/**
+ * Tests if model patch is rejected, as its records cannot be dropped when a message is corrupted
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_patch_not_supported)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    flags.flags_upload.patch = 1;
+    prepare_message_in_buffer(flags, 0, TEST_MESSAGE_PAYLOAD_SIZE, false);
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_INV_ARG);
+    zassert_equal(patching_loader_fake.call_count, 0);
+    zassert_equal(mock_loader_buffer_idx, 0);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+/**
+ * Tests if message without payload with invalid checksum is rejected
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_listen_invalid_checksum_no_payload)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    prepare_message_in_buffer(flags, 0, 0, false);
+    ((message_hdr_t *)mock_read_buffer)->checksum ^= 0xFF;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_CHECKSUM_ERROR);
+    zassert_equal(mock_write_buffer_idx, 0);
+}
+
+// ========================================================
+// transmit
+// ========================================================
+
+/**
+ * Tests if checksums of transmitted messages are filled
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_checksum, test_protocol_transmit_checksum)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t transmission;
+    uint8_t test_payload_buffer[14];
+    size_t offset = 0;
+
+    for (size_t i = 0; i < sizeof(test_payload_buffer); ++i)
+    {
+        test_payload_buffer[i] = i;
+    }
+    transmission.message_type = MESSAGE_TYPE_OUTPUT;
+    transmission.flags.raw_bytes = 0;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
+    transmission.payload.raw_bytes = test_payload_buffer;
+    transmission.payload.size = sizeof(test_payload_buffer);
+
+    status = protocol_transmit(&transmission);
+
+    // payload is split into 8-byte messages, as set in prj.conf
+    zassert_equal(status, STATUS_OK);
+    for (int i = 0; i < 2; ++i)
+    {
+        const message_hdr_t *hdr = (const message_hdr_t *)(mock_write_buffer + offset);
+        const uint8_t *payload = mock_write_buffer + offset + sizeof(message_hdr_t);
+
+        zassert_equal(hdr->checksum, compute_checksum(hdr, payload));
+        offset += sizeof(message_hdr_t) + hdr->payload_size;
+    }
+    zassert_equal(offset, mock_write_buffer_idx);
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+checksum_t compute_checksum(const message_hdr_t *header, const uint8_t *payload)
+{
+    message_hdr_t hdr = *header;
+    checksum_t checksum = 0;
+
+    hdr.checksum = 0;
+    checksum = crc8_ccitt(0xFF, &hdr, sizeof(message_hdr_t));
+    if (hdr.flags.general_purpose_flags.has_payload)
+    {
+        checksum = crc8_ccitt(checksum, payload, hdr.payload_size);
+    }
+    return checksum;
+}
+
+void prepare_message_in_buffer(flags_t flags, size_t offset, size_t payload_size, bool corrupted)
+{
+    message_hdr_t *hdr = (message_hdr_t *)(mock_read_buffer + mock_read_buffer_length);
+    uint8_t *payload = mock_read_buffer + mock_read_buffer_length + sizeof(message_hdr_t);
+
+    memset(hdr, 0, sizeof(message_hdr_t));
+    hdr->message_type = MESSAGE_TYPE_MODEL;
+    hdr->flow_control_flags = FLOW_CONTROL_TRANSMISSION;
+    hdr->flags = flags;
+    hdr->payload_size = payload_size;
+    for (size_t i = 0; i < payload_size; ++i)
+    {
+        payload[i] = offset + i;
+    }
+    hdr->checksum = compute_checksum(hdr, payload);
+    if (corrupted)
+    {
+        payload[payload_size / 2] ^= 0x10;
+    }
+    mock_read_buffer_length += sizeof(message_hdr_t) + payload_size;
+}
+
+bool is_confirmation(size_t idx, flow_control_flags_t flow_control_flags)
+{
+    const message_hdr_t *hdr = (const message_hdr_t *)(mock_write_buffer + idx * sizeof(message_hdr_t));
+
+    return hdr->message_type == MESSAGE_TYPE_MODEL && hdr->flow_control_flags == flow_control_flags &&
+           hdr->payload_size == 0 && hdr->checksum == compute_checksum(hdr, NULL);
+}
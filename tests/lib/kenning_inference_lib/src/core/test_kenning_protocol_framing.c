@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+
+#include <kenning_inference_lib/core/kenning_protocol.h>
+#include <kenning_inference_lib/core/loaders.h>
+
+#include "kenning_inference_lib/core/protocol.h"
+#include "kenning_inference_lib/core/utils.h"
+#include "utils.h"
+
+#define MOCK_BUFFER_SIZE 8192
+#define TEST_PAYLOAD_SIZE 600
+static uint8_t mock_write_buffer[MOCK_BUFFER_SIZE];
+static uint8_t mock_read_buffer[MOCK_BUFFER_SIZE];
+static uint8_t mock_loader_buffer[MOCK_BUFFER_SIZE];
+static size_t mock_write_buffer_idx;
+static size_t mock_read_buffer_idx;
+static size_t mock_read_buffer_length;
+static size_t mock_loader_buffer_idx;
+
+// ========================================================
+// mocks
+// ========================================================
+DEFINE_FFF_GLOBALS;
+
+#define MOCKS(MOCK)                                                     \
+    MOCK(const char *, get_status_str, status_t);                       \
+    MOCK(status_t, protocol_read_data, uint8_t *, size_t);              \
+    MOCK(status_t, protocol_write_data, const uint8_t *, size_t);       \
+    MOCK(status_t, protocol_lease, const uint8_t **, size_t, size_t *); \
+    MOCK(status_t, protocol_release, size_t);                           \
+    MOCK(struct msg_loader *, patching_loader, struct msg_loader *);
+
+MOCKS(DECLARE_MOCK);
+
+status_t protocol_read_data_mock(uint8_t *data, size_t data_length);
+status_t protocol_write_data_mock(const uint8_t *data, size_t data_length);
+
+status_t send_message(const outgoing_message_t *msg);
+
+// ========================================================
+// helper functions declarations
+// ========================================================
+
+/**
+ * Encodes data with COBS and adds frame delimiter
+ *
+ * @param data data to be encoded
+ * @param data_length size of the data
+ * @param frame buffer for the encoded frame
+ *
+ * @returns size of the encoded frame
+ */
+size_t encode_frame(const uint8_t *data, size_t data_length, uint8_t *frame);
+
+/**
+ * Decodes a single COBS frame
+ *
+ * @param frame encoded frame, terminated with delimiter
+ * @param frame_length size of the encoded frame including delimiter, set by the function
+ * @param data buffer for decoded data
+ *
+ * @returns size of the decoded data
+ */
+size_t decode_frame(const uint8_t *frame, size_t *frame_length, uint8_t *data);
+
+/**
+ * Prepares framed message of given type with payload filled with test pattern and adds it to read buffer
+ *
+ * @param message_type type of the message
+ * @param flags flags of the message
+ * @param payload_size size of the payload
+ */
+void prepare_framed_message_in_buffer(message_type_t message_type, flags_t flags, size_t payload_size);
+
+/**
+ * Fills buffer with test pattern containing both zero bytes and runs of non-zero bytes longer than COBS block
+ *
+ * @param buffer buffer to be filled
+ * @param size size of the buffer
+ */
+void fill_test_pattern(uint8_t *buffer, size_t size);
+
+// ========================================================
+// setup
+// ========================================================
+
+static void kenning_protocol_framing_tests_setup_f()
+{
+    MOCKS(RESET_MOCK);
+    protocol_read_data_fake.custom_fake = protocol_read_data_mock;
+    protocol_write_data_fake.custom_fake = protocol_write_data_mock;
+    memset(mock_write_buffer, 0, MOCK_BUFFER_SIZE);
+    memset(mock_read_buffer, 0, MOCK_BUFFER_SIZE);
+    memset(mock_loader_buffer, 0, MOCK_BUFFER_SIZE);
+    mock_write_buffer_idx = 0;
+    mock_read_buffer_idx = 0;
+    mock_read_buffer_length = 0;
+    mock_loader_buffer_idx = 0;
+}
+
+ZTEST_SUITE(kenning_inference_lib_test_kenning_protocol_framing, NULL, NULL, kenning_protocol_framing_tests_setup_f,
+            NULL, NULL);
+
+// ========================================================
+// mocks definitions
+// ========================================================
+
+status_t protocol_read_data_mock(uint8_t *data, size_t data_length)
+{
+    if (mock_read_buffer_idx + data_length > mock_read_buffer_length)
+    {
+        return PROTOCOL_STATUS_TIMEOUT;
+    }
+    memcpy(data, mock_read_buffer + mock_read_buffer_idx, data_length);
+    mock_read_buffer_idx += data_length;
+    return STATUS_OK;
+}
+
+status_t protocol_write_data_mock(const uint8_t *data, size_t data_length)
+{
+    if (mock_write_buffer_idx + data_length > MOCK_BUFFER_SIZE)
+    {
+        return PROTOCOL_STATUS_ERROR;
+    }
+    memcpy(mock_write_buffer + mock_write_buffer_idx, data, data_length);
+    mock_write_buffer_idx += data_length;
+    return STATUS_OK;
+}
+
+int loader_reset_mock(struct msg_loader *ldr)
+{
+    mock_loader_buffer_idx = 0;
+    ldr->written = 0;
+    return 0;
+}
+
+int loader_save_mock(struct msg_loader *ldr, const uint8_t *src, size_t n)
+{
+    memcpy(mock_loader_buffer + mock_loader_buffer_idx, src, n);
+    mock_loader_buffer_idx += n;
+    ldr->written += n;
+    return 0;
+}
+
+struct msg_loader *get_loader(message_type_t message_type, payload_size_t payload_size)
+{
+    static struct msg_loader ldr = {
+        .save = loader_save_mock,
+        .reset = loader_reset_mock,
+    };
+    return &ldr;
+}
+
+// ========================================================
+// listen
+// ========================================================
+
+/**
+ * Tests if framed message with payload is received properly
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_listen_framed_message)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+    uint8_t expected_payload[TEST_PAYLOAD_SIZE];
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    fill_test_pattern(expected_payload, sizeof(expected_payload));
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_DATA, flags, TEST_PAYLOAD_SIZE);
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.message_type, MESSAGE_TYPE_DATA);
+    zassert_equal(event.payload.size, TEST_PAYLOAD_SIZE);
+    zassert_mem_equal(mock_loader_buffer, expected_payload, TEST_PAYLOAD_SIZE);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+/**
+ * Tests if transmission split into multiple frames is received properly
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_listen_framed_multiple_messages)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_MODEL, flags, 100);
+    flags.general_purpose_flags.first = 0;
+    flags.general_purpose_flags.last = 1;
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_MODEL, flags, 100);
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, 200);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+/**
+ * Tests if message following a truncated frame is received, when the delimiter is in the middle of expected data
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_listen_resync_after_truncated_frame)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+    uint8_t expected_payload[TEST_PAYLOAD_SIZE];
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    flags.general_purpose_flags.has_payload = 1;
+    fill_test_pattern(expected_payload, sizeof(expected_payload));
+
+    // frame that lost its second half
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_DATA, flags, TEST_PAYLOAD_SIZE);
+    mock_read_buffer_length /= 2;
+    mock_read_buffer[mock_read_buffer_length++] = 0x00;
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_DATA, flags, TEST_PAYLOAD_SIZE);
+
+    status = protocol_listen(&event, get_loader);
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_FRAMING_ERROR);
+
+    status = protocol_listen(&event, get_loader);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, TEST_PAYLOAD_SIZE);
+    zassert_mem_equal(mock_loader_buffer, expected_payload, TEST_PAYLOAD_SIZE);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+/**
+ * Tests if message following corrupted data is received
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_listen_resync_after_corrupted_frame)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    flags.general_purpose_flags.has_payload = 1;
+
+    // header with corrupted message type and payload size, the frame is longer than the header
+    memset(mock_read_buffer, 0xAA, 40);
+    mock_read_buffer[0] = 0xFF;
+    mock_read_buffer_length = 40;
+    mock_read_buffer[mock_read_buffer_length++] = 0x00;
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_PROCESS, flags, 16);
+
+    status = protocol_listen(&event, get_loader);
+    zassert_not_equal(status, STATUS_OK);
+
+    status = protocol_listen(&event, get_loader);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.message_type, MESSAGE_TYPE_PROCESS);
+    zassert_equal(event.payload.size, 16);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+/**
+ * Tests if frame with more data than declared in the header is rejected
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_listen_frame_too_long)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+    uint8_t message[sizeof(message_hdr_t) + 8];
+    message_hdr_t header = {
+        .message_type = MESSAGE_TYPE_PING,
+        .flow_control_flags = FLOW_CONTROL_REQUEST,
+        .payload_size = 0,
+    };
+
+    header.flags.general_purpose_flags.first = 1;
+    header.flags.general_purpose_flags.last = 1;
+    memcpy(message, &header, sizeof(header));
+    memset(message + sizeof(header), 'x', sizeof(message) - sizeof(header));
+    mock_read_buffer_length = encode_frame(message, sizeof(message), mock_read_buffer);
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_PING, flags, 0);
+
+    status = protocol_listen(&event, get_loader);
+    zassert_equal(status, KENNING_PROTOCOL_STATUS_FRAMING_ERROR);
+
+    status = protocol_listen(&event, get_loader);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.message_type, MESSAGE_TYPE_PING);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+/**
+ * Tests if empty frames, e.g. delimiters sent by the client to flush the line, are skipped
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_listen_empty_frames)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    flags_t flags = {.raw_bytes = 0};
+
+    flags.general_purpose_flags.first = 1;
+    flags.general_purpose_flags.last = 1;
+    mock_read_buffer_length = 3;
+    prepare_framed_message_in_buffer(MESSAGE_TYPE_STATUS, flags, 0);
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.message_type, MESSAGE_TYPE_STATUS);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+// ========================================================
+// transmit
+// ========================================================
+
+/**
+ * Tests if transmitted messages are framed and contain no zero bytes apart from delimiters
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_transmit_framed)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t transmission;
+    uint8_t test_payload_buffer[20];
+    uint8_t decoded[MOCK_BUFFER_SIZE];
+    size_t offset = 0;
+
+    // payload is split into 8-byte messages, as set in prj.conf
+    memset(test_payload_buffer, 0, sizeof(test_payload_buffer));
+    transmission.message_type = MESSAGE_TYPE_OUTPUT;
+    transmission.flags.raw_bytes = 0;
+    transmission.payload.type = PROTOCOL_PAYLOAD_TYPE_BYTES;
+    transmission.payload.raw_bytes = test_payload_buffer;
+    transmission.payload.size = sizeof(test_payload_buffer);
+
+    status = protocol_transmit(&transmission);
+
+    zassert_equal(status, STATUS_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        size_t frame_length = 0;
+        size_t decoded_length = decode_frame(mock_write_buffer + offset, &frame_length, decoded);
+        const message_hdr_t *hdr = (const message_hdr_t *)decoded;
+
+        zassert_equal(decoded_length, sizeof(message_hdr_t) + hdr->payload_size);
+        zassert_equal(hdr->message_type, MESSAGE_TYPE_OUTPUT);
+        zassert_equal(hdr->payload_size, i < 2 ? 8 : 4);
+        zassert_mem_equal(decoded + sizeof(message_hdr_t), test_payload_buffer, hdr->payload_size);
+        zassert_is_null(memchr(mock_write_buffer + offset, 0x00, frame_length - 1));
+        offset += frame_length;
+    }
+    zassert_equal(offset, mock_write_buffer_idx);
+}
+
+/**
+ * Tests if sent frame is received properly, including runs of non-zero bytes longer than COBS block
+ */
+ZTEST(kenning_inference_lib_test_kenning_protocol_framing, test_protocol_framed_round_trip)
+{
+    status_t status = STATUS_OK;
+    protocol_event_t event;
+    outgoing_message_t message;
+    uint8_t test_payload_buffer[TEST_PAYLOAD_SIZE];
+
+    fill_test_pattern(test_payload_buffer, sizeof(test_payload_buffer));
+    memset(&message.hdr, 0, sizeof(message.hdr));
+    message.hdr.message_type = MESSAGE_TYPE_OUTPUT;
+    message.hdr.flow_control_flags = FLOW_CONTROL_TRANSMISSION;
+    message.hdr.payload_size = sizeof(test_payload_buffer);
+    message.hdr.flags.general_purpose_flags.first = 1;
+    message.hdr.flags.general_purpose_flags.last = 1;
+    message.hdr.flags.general_purpose_flags.has_payload = 1;
+    message.payload = test_payload_buffer;
+
+    status = send_message(&message);
+    zassert_equal(status, STATUS_OK);
+
+    // sent frame is received back through the mocked transport
+    memcpy(mock_read_buffer, mock_write_buffer, mock_write_buffer_idx);
+    mock_read_buffer_length = mock_write_buffer_idx;
+
+    status = protocol_listen(&event, get_loader);
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(event.payload.size, TEST_PAYLOAD_SIZE);
+    zassert_mem_equal(mock_loader_buffer, test_payload_buffer, TEST_PAYLOAD_SIZE);
+    zassert_equal(mock_read_buffer_idx, mock_read_buffer_length);
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+size_t encode_frame(const uint8_t *data, size_t data_length, uint8_t *frame)
+{
+    size_t code_idx = 0;
+    size_t frame_idx = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < data_length; ++i)
+    {
+        if (0x00 == data[i])
+        {
+            frame[code_idx] = code;
+            code = 1;
+            code_idx = frame_idx++;
+            continue;
+        }
+        frame[frame_idx++] = data[i];
+        if (0xFF == ++code)
+        {
+            frame[code_idx] = code;
+            code = 1;
+            code_idx = frame_idx++;
+        }
+    }
+    frame[code_idx] = code;
+    frame[frame_idx++] = 0x00;
+    return frame_idx;
+}
+
+size_t decode_frame(const uint8_t *frame, size_t *frame_length, uint8_t *data)
+{
+    size_t frame_idx = 0;
+    size_t data_idx = 0;
+
+    while (0x00 != frame[frame_idx])
+    {
+        uint8_t code = frame[frame_idx++];
+
+        for (uint8_t i = 1; i < code; ++i)
+        {
+            data[data_idx++] = frame[frame_idx++];
+        }
+        if (code < 0xFF && 0x00 != frame[frame_idx])
+        {
+            data[data_idx++] = 0x00;
+        }
+    }
+    *frame_length = frame_idx + 1;
+    return data_idx;
+}
+
+void prepare_framed_message_in_buffer(message_type_t message_type, flags_t flags, size_t payload_size)
+{
+    static uint8_t message[sizeof(message_hdr_t) + MOCK_BUFFER_SIZE / 2];
+    message_hdr_t hdr_to_read = {
+        .message_type = message_type,
+        .flags = flags,
+        .payload_size = payload_size,
+        .flow_control_flags = FLOW_CONTROL_TRANSMISSION,
+    };
+
+    memcpy(message, &hdr_to_read, sizeof(message_hdr_t));
+    fill_test_pattern(message + sizeof(message_hdr_t), payload_size);
+    mock_read_buffer_length +=
+        encode_frame(message, sizeof(message_hdr_t) + payload_size, mock_read_buffer + mock_read_buffer_length);
+}
+
+void fill_test_pattern(uint8_t *buffer, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        buffer[i] = i % 300 < 256 ? i % 300 : 0x5A;
+    }
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include <kenning_inference_lib/core/loaders.h>
+
+#define OUTPUT_BUFFER_SIZE 1024
+#define REPEATED_DATA_SIZE 410
+
+// "abcabcabc" - three literals followed by back-reference with offset 3 and length 6
+static const uint8_t COMPRESSED_SHORT[] = {0xb0, 0xd8, 0xac, 0x60, 0x25};
+static const char DECOMPRESSED_SHORT[] = "abcabcabc";
+
+// data returned by get_repeated_data, longer than both the window and the output buffer of the decompressor
+static const uint8_t COMPRESSED_REPEATED[] = {
+    0x80, 0x41, 0xe0, 0x30, 0x88, 0x14, 0x26, 0x07, 0x0a, 0x82, 0x42, 0xe0, 0xb0, 0xc8, 0x30, 0x33,
+    0xc1, 0x9e, 0x0c, 0xf0, 0x67, 0x83, 0x3c, 0x19, 0xe0, 0xcf, 0x06, 0x78, 0x33, 0xc1, 0x9e, 0x0c,
+    0xf0, 0x65, 0x5a, 0xec, 0xb6, 0xeb, 0x75, 0xa6, 0xdd, 0x67, 0x03, 0x78, 0x1b, 0xc0, 0xde, 0x06,
+    0xf0, 0x37, 0x81, 0xbc, 0x0d, 0xe0, 0x6f, 0x03, 0x78, 0x1b, 0xc0, 0xde, 0x06, 0xf0, 0x35, 0x00};
+
+static uint8_t g_output_buffer[OUTPUT_BUFFER_SIZE];
+static struct msg_loader g_output_ldr = MSG_LOADER_BUF(g_output_buffer, OUTPUT_BUFFER_SIZE);
+
+static void get_repeated_data(uint8_t *data);
+
+static void loaders_tests_setup_f()
+{
+    memset(g_output_buffer, 0, sizeof(g_output_buffer));
+    g_output_ldr.max_size = OUTPUT_BUFFER_SIZE;
+    g_output_ldr.reset(&g_output_ldr);
+}
+
+ZTEST_SUITE(kenning_inference_lib_test_loaders, NULL, NULL, loaders_tests_setup_f, NULL, NULL);
+
+// ========================================================
+// decompressing_loader
+// ========================================================
+
+/**
+ * Tests if decompressing loader passes decompressed data to the wrapped loader
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_decompressing_loader_save)
+{
+    struct msg_loader *ldr = decompressing_loader(&g_output_ldr);
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(STATUS_OK, ldr->save(ldr, COMPRESSED_SHORT, sizeof(COMPRESSED_SHORT)));
+
+    zassert_equal(sizeof(COMPRESSED_SHORT), ldr->written);
+    zassert_equal(strlen(DECOMPRESSED_SHORT), g_output_ldr.written);
+    zassert_mem_equal(DECOMPRESSED_SHORT, g_output_buffer, strlen(DECOMPRESSED_SHORT));
+}
+
+/**
+ * Tests if decompressing loader handles data saved byte by byte
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_decompressing_loader_save_one)
+{
+    struct msg_loader *ldr = decompressing_loader(&g_output_ldr);
+    uint8_t expected[REPEATED_DATA_SIZE];
+
+    get_repeated_data(expected);
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    for (size_t i = 0; i < sizeof(COMPRESSED_REPEATED); i++)
+    {
+        uint8_t c = COMPRESSED_REPEATED[i];
+        zassert_equal(STATUS_OK, ldr->save_one(ldr, &c));
+    }
+
+    zassert_equal(sizeof(COMPRESSED_REPEATED), ldr->written);
+    zassert_equal(REPEATED_DATA_SIZE, g_output_ldr.written);
+    zassert_mem_equal(expected, g_output_buffer, REPEATED_DATA_SIZE);
+}
+
+/**
+ * Tests if decompressing loader handles data split into chunks at arbitrary positions
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_decompressing_loader_save_chunks)
+{
+    struct msg_loader *ldr = decompressing_loader(&g_output_ldr);
+    uint8_t expected[REPEATED_DATA_SIZE];
+    size_t chunk_size = 7;
+
+    get_repeated_data(expected);
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    for (size_t i = 0; i < sizeof(COMPRESSED_REPEATED); i += chunk_size)
+    {
+        zassert_equal(STATUS_OK,
+                      ldr->save(ldr, COMPRESSED_REPEATED + i, MIN(chunk_size, sizeof(COMPRESSED_REPEATED) - i)));
+    }
+
+    zassert_equal(REPEATED_DATA_SIZE, g_output_ldr.written);
+    zassert_mem_equal(expected, g_output_buffer, REPEATED_DATA_SIZE);
+}
+
+/**
+ * Tests if decompressing loader returns error when decompressed data does not fit in the wrapped loader
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_decompressing_loader_save_not_enough_memory)
+{
+    struct msg_loader *ldr = decompressing_loader(&g_output_ldr);
+
+    g_output_ldr.max_size = strlen(DECOMPRESSED_SHORT) - 1;
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(LOADERS_STATUS_NOT_ENOUGH_MEMORY, ldr->save(ldr, COMPRESSED_SHORT, sizeof(COMPRESSED_SHORT)));
+}
+
+/**
+ * Tests if decompressing loader can be rewound to the start of the payload
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_decompressing_loader_rewind_to_start)
+{
+    struct msg_loader *ldr = decompressing_loader(&g_output_ldr);
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(STATUS_OK, ldr->save(ldr, COMPRESSED_SHORT, 3));
+    zassert_equal(STATUS_OK, ldr->rewind(ldr, 0));
+    zassert_equal(0, ldr->written);
+    zassert_equal(0, g_output_ldr.written);
+
+    zassert_equal(STATUS_OK, ldr->save(ldr, COMPRESSED_SHORT, sizeof(COMPRESSED_SHORT)));
+    zassert_equal(strlen(DECOMPRESSED_SHORT), g_output_ldr.written);
+    zassert_mem_equal(DECOMPRESSED_SHORT, g_output_buffer, strlen(DECOMPRESSED_SHORT));
+}
+
+/**
+ * Tests if decompressing loader can be rewound to the current position only
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_decompressing_loader_rewind_inside_payload)
+{
+    struct msg_loader *ldr = decompressing_loader(&g_output_ldr);
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(STATUS_OK, ldr->save(ldr, COMPRESSED_SHORT, 3));
+
+    zassert_equal(STATUS_OK, ldr->rewind(ldr, 3));
+    zassert_equal(LOADERS_STATUS_INV_ARG, ldr->rewind(ldr, 1));
+}
+
+// ========================================================
+// patching_loader
+// ========================================================
+
+/**
+ * Tests if patching loader replaces data at offsets given in the records
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_patching_loader_save)
+{
+    struct msg_loader *ldr = patching_loader(&g_output_ldr);
+    uint8_t patch[2 * sizeof(struct patch_record_header) + 5];
+    struct patch_record_header *first = (struct patch_record_header *)patch;
+    struct patch_record_header *second = (struct patch_record_header *)(patch + sizeof(*first) + 3);
+
+    zassert_equal(STATUS_OK, g_output_ldr.save(&g_output_ldr, (const uint8_t *)DECOMPRESSED_SHORT, strlen(DECOMPRESSED_SHORT)));
+    first->offset = 0;
+    first->size = 3;
+    memcpy(patch + sizeof(*first), "xyz", 3);
+    second->offset = 7;
+    second->size = 2;
+    memcpy(patch + 2 * sizeof(*first) + 3, "12", 2);
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(STATUS_OK, ldr->save(ldr, patch, sizeof(patch)));
+
+    zassert_equal(sizeof(patch), ldr->written);
+    zassert_equal(strlen(DECOMPRESSED_SHORT), g_output_ldr.written);
+    zassert_mem_equal("xyzabca12", g_output_buffer, strlen(DECOMPRESSED_SHORT));
+}
+
+/**
+ * Tests if patching loader handles records split between saves
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_patching_loader_save_one)
+{
+    struct msg_loader *ldr = patching_loader(&g_output_ldr);
+    uint8_t patch[sizeof(struct patch_record_header) + 4];
+    struct patch_record_header *header = (struct patch_record_header *)patch;
+
+    zassert_equal(STATUS_OK, g_output_ldr.save(&g_output_ldr, (const uint8_t *)DECOMPRESSED_SHORT, strlen(DECOMPRESSED_SHORT)));
+    header->offset = 4;
+    header->size = 4;
+    memcpy(patch + sizeof(*header), "1234", 4);
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    for (size_t i = 0; i < sizeof(patch); i++)
+    {
+        zassert_equal(STATUS_OK, ldr->save_one(ldr, &patch[i]));
+    }
+
+    zassert_mem_equal("abca1234c", g_output_buffer, strlen(DECOMPRESSED_SHORT));
+}
+
+/**
+ * Tests if patching loader rejects records exceeding data stored in the wrapped loader
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_patching_loader_save_out_of_range)
+{
+    struct msg_loader *ldr = patching_loader(&g_output_ldr);
+    struct patch_record_header header = {.offset = 8, .size = 2};
+
+    zassert_equal(STATUS_OK, g_output_ldr.save(&g_output_ldr, (const uint8_t *)DECOMPRESSED_SHORT, strlen(DECOMPRESSED_SHORT)));
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(LOADERS_STATUS_INV_ARG, ldr->save(ldr, (uint8_t *)&header, sizeof(header)));
+    zassert_mem_equal(DECOMPRESSED_SHORT, g_output_buffer, strlen(DECOMPRESSED_SHORT));
+}
+
+/**
+ * Tests if patching loader does not reset the wrapped loader
+ */
+ZTEST(kenning_inference_lib_test_loaders, test_patching_loader_reset)
+{
+    struct msg_loader *ldr = patching_loader(&g_output_ldr);
+
+    zassert_equal(STATUS_OK, g_output_ldr.save(&g_output_ldr, (const uint8_t *)DECOMPRESSED_SHORT, strlen(DECOMPRESSED_SHORT)));
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(0, ldr->written);
+    zassert_equal(strlen(DECOMPRESSED_SHORT), g_output_ldr.written);
+    // records are applied to the data as they are received, so they cannot be dropped
+    zassert_is_null(ldr->rewind);
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static void get_repeated_data(uint8_t *data)
+{
+    const char pattern[] = "kenning";
+    size_t i = 0;
+
+    for (; i < 200; i++)
+    {
+        data[i] = (i * 7) % 13;
+    }
+    for (; i < REPEATED_DATA_SIZE; i++)
+    {
+        data[i] = pattern[(i - 200) % (sizeof(pattern) - 1)];
+    }
+}
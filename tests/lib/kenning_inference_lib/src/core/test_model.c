@@ -37,15 +37,16 @@ static uint8_t __attribute__((aligned(8))) gp_inputBuffer[MODEL_INPUT_SIZE * 102
 // ========================================================
 DEFINE_FFF_GLOBALS;
 
-#define MOCKS(MOCK)                                                           \
-    MOCK(status_t, runtime_init)                                              \
-    MOCK(status_t, runtime_init_weights)                                      \
-    MOCK(status_t, runtime_init_input)                                        \
-    MOCK(status_t, runtime_run_model)                                         \
-    MOCK(status_t, runtime_run_model_bench)                                   \
-    MOCK(status_t, runtime_get_model_output, uint8_t *)                       \
-    MOCK(status_t, runtime_get_statistics, const size_t, uint8_t *, size_t *) \
-    MOCK(uint32_t, model_spec_input_length, const model_spec_t *, uint32_t)   \
+#define MOCKS(MOCK)                                                                          \
+    MOCK(status_t, runtime_init)                                                             \
+    MOCK(status_t, runtime_init_weights)                                                     \
+    MOCK(status_t, runtime_init_input)                                                       \
+    MOCK(status_t, runtime_run_model)                                                        \
+    MOCK(status_t, runtime_run_model_bench)                                                  \
+    MOCK(status_t, runtime_get_model_output, uint8_t *)                                      \
+    MOCK(status_t, runtime_get_output_view, const size_t, runtime_output_view_t *, size_t *) \
+    MOCK(status_t, runtime_get_statistics, const size_t, uint8_t *, size_t *)                \
+    MOCK(uint32_t, model_spec_input_length, const model_spec_t *, uint32_t)                  \
     MOCK(uint32_t, model_spec_output_length, const model_spec_t *, uint32_t)
 
 MOCKS(DECLARE_MOCK);
@@ -77,6 +78,10 @@ uint32_t model_spec_input_length_mock(const model_spec_t *model_iospec, uint32_t
  */
 uint32_t model_spec_output_length_mock(const model_spec_t *model_iospec, uint32_t index);
 
+status_t runtime_get_output_view_mock(const size_t max_views, runtime_output_view_t *views, size_t *num_views);
+status_t runtime_get_output_view_invalid_size_mock(const size_t max_views, runtime_output_view_t *views,
+                                                   size_t *num_views);
+
 // ========================================================
 // helper functions declarations
 // ========================================================
@@ -738,6 +743,50 @@ ZTEST(kenning_inference_lib_test_model, test_model_run_runtime_fail)
     zassert_equal(MODEL_STATE_INPUT_LOADED, g_model_state);
 }
 
+/**
+ * Mock of runtime_run_model requesting cancellation of the inference in progress
+ */
+static status_t runtime_run_model_cancel_mock()
+{
+    model_request_cancel();
+    return runtime_cancel_requested() ? RUNTIME_WRAPPER_STATUS_CANCELLED : STATUS_OK;
+}
+
+/**
+ * Tests model execution when inference is cancelled
+ */
+ZTEST(kenning_inference_lib_test_model, test_model_run_cancelled)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INPUT_LOADED;
+    runtime_run_model_fake.custom_fake = runtime_run_model_cancel_mock;
+
+    status = model_run();
+
+    zassert_equal(RUNTIME_WRAPPER_STATUS_CANCELLED, status);
+    zassert_equal(MODEL_STATE_INPUT_LOADED, g_model_state);
+    zassert_false(runtime_cancel_requested());
+}
+
+/**
+ * Tests if cancellation requested when no inference is in progress does not affect the next inference
+ */
+ZTEST(kenning_inference_lib_test_model, test_model_run_cancel_before_inference)
+{
+    status_t status = STATUS_OK;
+
+    g_model_state = MODEL_STATE_INPUT_LOADED;
+
+    model_request_cancel();
+    zassert_false(runtime_cancel_requested());
+
+    status = model_run();
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(MODEL_STATE_INFERENCE_DONE, g_model_state);
+}
+
 /**
  * Tests model execution when model is in invalid state
  */
@@ -1002,6 +1051,119 @@ ZTEST(kenning_inference_lib_test_model, test_model_get_output_runtime_fail)
     zassert_equal(MODEL_STATE_INFERENCE_DONE, g_model_state);
 }
 
+// ========================================================
+// model_get_output_view
+// ========================================================
+
+/**
+ * Tests model get output view for valid model state
+ */
+ZTEST(kenning_inference_lib_test_model, test_model_get_output_view)
+{
+    status_t status = STATUS_OK;
+    runtime_output_view_t views[MAX_MODEL_OUTPUT_NUM];
+    size_t num_views = 0;
+
+    model_spec_output_length_fake.custom_fake = model_spec_output_length_mock;
+    runtime_get_output_view_fake.custom_fake = runtime_get_output_view_mock;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+
+    status = model_get_output_view(MAX_MODEL_OUTPUT_NUM, views, &num_views);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(MODEL_STATE_INFERENCE_DONE, g_model_state);
+    zassert_equal(1, num_views);
+    zassert_equal(MODEL_SPEC_OUTPUT_LEN * MODEL_SPEC_OUTPUT_SIZE, views[0].size);
+}
+
+/**
+ * Tests model get output view for invalid pointers
+ */
+ZTEST(kenning_inference_lib_test_model, test_model_get_output_view_invalid_pointer)
+{
+    status_t status = STATUS_OK;
+    runtime_output_view_t views[MAX_MODEL_OUTPUT_NUM];
+    size_t num_views = 0;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+
+    status = model_get_output_view(MAX_MODEL_OUTPUT_NUM, NULL, &num_views);
+    zassert_equal(MODEL_STATUS_INV_PTR, status);
+
+    status = model_get_output_view(MAX_MODEL_OUTPUT_NUM, views, NULL);
+    zassert_equal(MODEL_STATUS_INV_PTR, status);
+
+    zassert_equal(runtime_get_output_view_fake.call_count, 0);
+}
+
+/**
+ * Tests model get output view when model is in invalid state
+ */
+ZTEST(kenning_inference_lib_test_model, test_model_get_output_view_invalid_state)
+{
+    status_t status = STATUS_OK;
+    runtime_output_view_t views[MAX_MODEL_OUTPUT_NUM];
+    size_t num_views = 0;
+
+#define TEST_GET_OUTPUT_VIEW(_model_state)                                   \
+    g_model_state = (_model_state);                                          \
+                                                                             \
+    status = model_get_output_view(MAX_MODEL_OUTPUT_NUM, views, &num_views); \
+                                                                             \
+    zassert_equal(MODEL_STATUS_INV_STATE, status);                           \
+    zassert_equal((_model_state), g_model_state);
+
+    TEST_GET_OUTPUT_VIEW(MODEL_STATE_UNINITIALIZED);
+    TEST_GET_OUTPUT_VIEW(MODEL_STATE_STRUCT_LOADED);
+    TEST_GET_OUTPUT_VIEW(MODEL_STATE_WEIGHTS_LOADED);
+    TEST_GET_OUTPUT_VIEW(MODEL_STATE_INPUT_LOADED);
+
+#undef TEST_GET_OUTPUT_VIEW
+
+    zassert_equal(runtime_get_output_view_fake.call_count, 0);
+}
+
+/**
+ * Tests model get output view when runtime does not support output views
+ */
+ZTEST(kenning_inference_lib_test_model, test_model_get_output_view_not_supported)
+{
+    status_t status = STATUS_OK;
+    runtime_output_view_t views[MAX_MODEL_OUTPUT_NUM];
+    size_t num_views = 0;
+
+    model_spec_output_length_fake.custom_fake = model_spec_output_length_mock;
+    runtime_get_output_view_fake.return_val = RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+
+    status = model_get_output_view(MAX_MODEL_OUTPUT_NUM, views, &num_views);
+
+    zassert_equal(RUNTIME_WRAPPER_STATUS_NOT_SUPPORTED, status);
+    zassert_equal(MODEL_STATE_INFERENCE_DONE, g_model_state);
+}
+
+/**
+ * Tests model get output view when size of the views does not match model output size
+ */
+ZTEST(kenning_inference_lib_test_model, test_model_get_output_view_invalid_size)
+{
+    status_t status = STATUS_OK;
+    runtime_output_view_t views[MAX_MODEL_OUTPUT_NUM];
+    size_t num_views = 0;
+
+    model_spec_output_length_fake.custom_fake = model_spec_output_length_mock;
+    runtime_get_output_view_fake.custom_fake = runtime_get_output_view_invalid_size_mock;
+
+    g_model_state = MODEL_STATE_INFERENCE_DONE;
+
+    status = model_get_output_view(MAX_MODEL_OUTPUT_NUM, views, &num_views);
+
+    zassert_equal(MODEL_STATUS_ERROR, status);
+    zassert_equal(MODEL_STATE_INFERENCE_DONE, g_model_state);
+}
+
 // ========================================================
 // model_get_statistics
 // ========================================================
@@ -1152,3 +1314,24 @@ model_spec_t get_model_spec_data()
 GENERATE_MODEL_SPEC_LENGTH_CUSTOM_MOCK_DEFINITION(input);
 // Generating definition for model_spec_output_length_mock
 GENERATE_MODEL_SPEC_LENGTH_CUSTOM_MOCK_DEFINITION(output);
+
+status_t runtime_get_output_view_mock(const size_t max_views, runtime_output_view_t *views, size_t *num_views)
+{
+    static uint8_t model_output[MODEL_SPEC_OUTPUT_LEN * MODEL_SPEC_OUTPUT_SIZE];
+
+    views[0].data = model_output;
+    views[0].size = sizeof(model_output);
+    *num_views = 1;
+    return STATUS_OK;
+}
+
+status_t runtime_get_output_view_invalid_size_mock(const size_t max_views, runtime_output_view_t *views,
+                                                   size_t *num_views)
+{
+    static uint8_t model_output[MODEL_SPEC_OUTPUT_LEN * MODEL_SPEC_OUTPUT_SIZE - 1];
+
+    views[0].data = model_output;
+    views[0].size = sizeof(model_output);
+    *num_views = 1;
+    return STATUS_OK;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+
+#include <kenning_inference_lib/core/protocol.h>
+
+#include "utils.h"
+
+extern const struct protocol_transport *gp_transport;
+
+// ========================================================
+// mocks
+// ========================================================
+DEFINE_FFF_GLOBALS;
+
+#define MOCKS(MOCK)                                                     \
+    MOCK(status_t, transport_init)                                      \
+    MOCK(status_t, transport_write, const uint8_t *, size_t)            \
+    MOCK(status_t, transport_read, uint8_t *, size_t)                   \
+    MOCK(status_t, transport_lease, const uint8_t **, size_t, size_t *) \
+    MOCK(status_t, transport_release, size_t)                           \
+    MOCK(status_t, transport_set_baudrate, uint32_t)
+
+MOCKS(DECLARE_MOCK);
+
+// transport registered in PROTOCOL_TRANSPORTS for the default configuration
+const struct protocol_transport g_uart_transport = {
+    .name = "uart",
+    .init = transport_init,
+    .write = transport_write,
+    .read = transport_read,
+    .lease = transport_lease,
+    .release = transport_release,
+    .set_baudrate = transport_set_baudrate,
+};
+
+// ========================================================
+// setup
+// ========================================================
+
+static void protocol_tests_setup_f()
+{
+    MOCKS(RESET_MOCK);
+
+    gp_transport = NULL;
+}
+
+ZTEST_SUITE(kenning_inference_lib_test_protocol, NULL, NULL, protocol_tests_setup_f, NULL, NULL);
+
+// ========================================================
+// protocol_init
+// ========================================================
+
+/**
+ * Tests if protocol is bound to the transport that was initialized successfully
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_init)
+{
+    status_t status = STATUS_OK;
+
+    status = protocol_init();
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(transport_init_fake.call_count, 1);
+    zassert_equal_ptr(gp_transport, &g_uart_transport);
+    zassert_str_equal(protocol_get_transport_name(), "uart");
+}
+
+/**
+ * Tests if protocol is not bound when none of the transports can be initialized
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_init_transport_error)
+{
+    status_t status = STATUS_OK;
+
+    transport_init_fake.return_val = PROTOCOL_STATUS_ERROR;
+
+    status = protocol_init();
+
+    zassert_equal(status, PROTOCOL_STATUS_ERROR);
+    zassert_is_null(gp_transport);
+    zassert_is_null(protocol_get_transport_name());
+}
+
+// ========================================================
+// protocol_select_transport
+// ========================================================
+
+/**
+ * Tests selecting transport by name
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_select_transport)
+{
+    status_t status = STATUS_OK;
+
+    status = protocol_select_transport("uart");
+
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(transport_init_fake.call_count, 1);
+    zassert_equal_ptr(gp_transport, &g_uart_transport);
+}
+
+/**
+ * Tests selecting transport that is not compiled in
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_select_transport_unknown)
+{
+    status_t status = STATUS_OK;
+
+    status = protocol_select_transport("unknown");
+
+    zassert_equal(status, PROTOCOL_STATUS_INV_ARG);
+    zassert_equal(transport_init_fake.call_count, 0);
+    zassert_is_null(gp_transport);
+}
+
+/**
+ * Tests selecting transport with invalid name pointer
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_select_transport_invalid_pointer)
+{
+    status_t status = STATUS_OK;
+
+    status = protocol_select_transport(NULL);
+
+    zassert_equal(status, PROTOCOL_STATUS_INV_PTR);
+}
+
+// ========================================================
+// transport operations
+// ========================================================
+
+/**
+ * Tests if operations are forwarded to the bound transport
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_operations)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[8];
+    const uint8_t *leased = NULL;
+    size_t leased_length = 0;
+
+    zassert_equal(protocol_init(), STATUS_OK);
+
+    status = protocol_write_data(data, sizeof(data));
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(transport_write_fake.call_count, 1);
+    zassert_equal_ptr(transport_write_fake.arg0_val, data);
+
+    status = protocol_read_data(data, sizeof(data));
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(transport_read_fake.call_count, 1);
+    zassert_equal(transport_read_fake.arg1_val, sizeof(data));
+
+    status = protocol_lease(&leased, sizeof(data), &leased_length);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(transport_lease_fake.call_count, 1);
+
+    status = protocol_release(0);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(transport_release_fake.call_count, 1);
+
+    status = protocol_set_baudrate(921600);
+    zassert_equal(status, STATUS_OK);
+    zassert_equal(transport_set_baudrate_fake.arg0_val, 921600);
+
+    // transport without flush sends data synchronously
+    status = protocol_flush();
+    zassert_equal(status, STATUS_OK);
+}
+
+/**
+ * Tests if optional operations missing in the transport are reported as not supported
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_operations_not_supported)
+{
+    status_t status = STATUS_OK;
+    uint32_t baudrate = 0;
+
+    zassert_equal(protocol_init(), STATUS_OK);
+
+    status = protocol_get_baudrate(&baudrate);
+
+    zassert_equal(status, PROTOCOL_STATUS_NOT_SUPPORTED);
+}
+
+/**
+ * Tests if operations fail when protocol is not initialized
+ */
+ZTEST(kenning_inference_lib_test_protocol, test_protocol_operations_uninitialized)
+{
+    uint8_t data[8];
+    const uint8_t *leased = NULL;
+    size_t leased_length = 0;
+
+    zassert_equal(protocol_write_data(data, sizeof(data)), PROTOCOL_STATUS_UNINIT);
+    zassert_equal(protocol_read_data(data, sizeof(data)), PROTOCOL_STATUS_UNINIT);
+    zassert_equal(protocol_lease(&leased, sizeof(data), &leased_length), PROTOCOL_STATUS_UNINIT);
+    zassert_equal(protocol_flush(), PROTOCOL_STATUS_UNINIT);
+    zassert_equal(transport_write_fake.call_count, 0);
+    zassert_equal(transport_read_fake.call_count, 0);
+}
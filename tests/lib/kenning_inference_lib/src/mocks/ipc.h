@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_KENNING_INFERENCE_LIB_MOCKS_IPC_H_
+#define TESTS_KENNING_INFERENCE_LIB_MOCKS_IPC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define DT_ALIAS(alias) alias
+#define DEVICE_DT_GET(node) NULL
+
+struct device
+{
+    const char *name;
+};
+
+struct ipc_service_cb
+{
+    void (*bound)(void *priv);
+    void (*received)(const void *data, size_t len, void *priv);
+};
+
+struct ipc_ept_cfg
+{
+    const char *name;
+    struct ipc_service_cb cb;
+    void *priv;
+};
+
+struct ipc_ept
+{
+    const struct device *instance;
+};
+
+bool device_is_ready(const struct device *dev);
+
+int ipc_service_open_instance(const struct device *instance);
+
+int ipc_service_register_endpoint(const struct device *instance, struct ipc_ept *ept, const struct ipc_ept_cfg *cfg);
+
+int ipc_service_send(struct ipc_ept *ept, const void *data, size_t len);
+
+int ipc_service_get_tx_buffer_size(struct ipc_ept *ept);
+
+int ipc_service_hold_rx_buffer(struct ipc_ept *ept, void *data);
+
+int ipc_service_release_rx_buffer(struct ipc_ept *ept, void *data);
+
+#endif // TESTS_KENNING_INFERENCE_LIB_MOCKS_IPC_H_
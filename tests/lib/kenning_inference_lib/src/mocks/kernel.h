@@ -8,7 +8,98 @@
 #define TESTS_KENNING_INFERENCE_LIB_MOCKS_KERNEL_H_
 
 #include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys_clock.h>
 
 #define K_TICKS(x) x
+#ifndef K_MSEC
+#define K_MSEC(ms) ((k_timeout_t){.ticks = (ms)})
+#endif
+#ifndef K_FOREVER
+#define K_FOREVER ((k_timeout_t){.ticks = -1})
+#endif
+#ifndef K_NO_WAIT
+#define K_NO_WAIT ((k_timeout_t){.ticks = 0})
+#endif
+
+struct k_sem
+{
+    unsigned int count;
+    unsigned int limit;
+};
+
+#define K_SEM_DEFINE(name, initial_count, count_limit) \
+    struct k_sem name = {.count = (initial_count), .limit = (count_limit)}
+
+int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
+
+void k_sem_give(struct k_sem *sem);
+
+void k_sem_reset(struct k_sem *sem);
+
+void k_busy_wait(uint32_t usec_to_wait);
+
+int64_t k_cycle_get_64(void);
+
+uint64_t k_cyc_to_ns_floor64(uint64_t t);
+
+struct k_thread
+{
+    int unused;
+};
+
+typedef struct k_thread *k_tid_t;
+typedef void (*k_thread_entry_t)(void *p1, void *p2, void *p3);
+
+#define K_THREAD_STACK_DEFINE(sym, size) uint8_t sym[size]
+#define K_THREAD_STACK_SIZEOF(sym) sizeof(sym)
+
+k_tid_t k_thread_create(struct k_thread *new_thread, uint8_t *stack, size_t stack_size, k_thread_entry_t entry,
+                        void *p1, void *p2, void *p3, int prio, uint32_t options, k_timeout_t delay);
+
+int k_thread_name_set(k_tid_t thread, const char *str);
+
+struct k_msgq
+{
+    size_t msg_size;
+    uint32_t max_msgs;
+};
+
+#define K_MSGQ_DEFINE(name, q_msg_size, q_max_msgs, q_align) \
+    struct k_msgq name = {.msg_size = (q_msg_size), .max_msgs = (q_max_msgs)}
+
+int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
+
+int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
+
+uint32_t k_msgq_num_free_get(struct k_msgq *msgq);
+
+void k_msgq_purge(struct k_msgq *msgq);
+
+void k_yield(void);
+
+struct k_mutex
+{
+    unsigned int lock_count;
+};
+
+#define K_MUTEX_DEFINE(name) struct k_mutex name = {.lock_count = 0}
+
+int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
+
+int k_mutex_unlock(struct k_mutex *mutex);
+
+struct k_condvar
+{
+    int unused;
+};
+
+#define K_CONDVAR_DEFINE(name) struct k_condvar name = {0}
+
+int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex, k_timeout_t timeout);
+
+int k_condvar_broadcast(struct k_condvar *condvar);
 
 #endif // TESTS_KENNING_INFERENCE_LIB_MOCKS_KERNEL_H_
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_KENNING_INFERENCE_LIB_MOCKS_RING_BUFFER_H_
+#define TESTS_KENNING_INFERENCE_LIB_MOCKS_RING_BUFFER_H_
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Minimal ring buffer with the same claim/finish semantics as the Zephyr one. Positions are free-running counters,
+ * so claimed areas are always contiguous in the buffer memory.
+ */
+struct ring_buf
+{
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t put_head;
+    uint32_t put_tail;
+    uint32_t get_head;
+    uint32_t get_tail;
+};
+
+#define RING_BUF_DECLARE(name, size8)               \
+    static uint8_t _ring_buffer_data_##name[size8]; \
+    struct ring_buf name = {.buffer = _ring_buffer_data_##name, .size = (size8)}
+
+#define RING_BUF_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+static inline void ring_buf_reset(struct ring_buf *buf)
+{
+    buf->put_head = buf->put_tail = buf->get_head = buf->get_tail = 0;
+}
+
+static inline uint32_t ring_buf_space_get(struct ring_buf *buf) { return buf->size - (buf->put_head - buf->get_tail); }
+
+static inline uint32_t ring_buf_size_get(struct ring_buf *buf) { return buf->put_tail - buf->get_head; }
+
+static inline uint32_t ring_buf_put_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
+{
+    uint32_t offset = buf->put_head % buf->size;
+    uint32_t claimed = RING_BUF_MIN(RING_BUF_MIN(ring_buf_space_get(buf), buf->size - offset), size);
+
+    *data = buf->buffer + offset;
+    buf->put_head += claimed;
+    return claimed;
+}
+
+static inline int ring_buf_put_finish(struct ring_buf *buf, uint32_t size)
+{
+    if (size > buf->put_head - buf->put_tail)
+    {
+        return -EINVAL;
+    }
+    buf->put_tail += size;
+    buf->put_head = buf->put_tail;
+    return 0;
+}
+
+static inline uint32_t ring_buf_put(struct ring_buf *buf, const uint8_t *data, uint32_t size)
+{
+    uint32_t total = 0;
+    uint32_t claimed = 0;
+    uint8_t *dst = NULL;
+
+    do
+    {
+        claimed = ring_buf_put_claim(buf, &dst, size - total);
+        memcpy(dst, data + total, claimed);
+        total += claimed;
+    } while (claimed > 0 && total < size);
+    ring_buf_put_finish(buf, total);
+    return total;
+}
+
+static inline uint32_t ring_buf_get_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
+{
+    uint32_t offset = buf->get_head % buf->size;
+    uint32_t claimed = RING_BUF_MIN(RING_BUF_MIN(buf->put_tail - buf->get_head, buf->size - offset), size);
+
+    *data = buf->buffer + offset;
+    buf->get_head += claimed;
+    return claimed;
+}
+
+static inline int ring_buf_get_finish(struct ring_buf *buf, uint32_t size)
+{
+    if (size > buf->get_head - buf->get_tail)
+    {
+        return -EINVAL;
+    }
+    buf->get_tail += size;
+    buf->get_head = buf->get_tail;
+    return 0;
+}
+
+static inline uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
+{
+    uint32_t total = 0;
+    uint32_t claimed = 0;
+    uint8_t *src = NULL;
+
+    do
+    {
+        claimed = ring_buf_get_claim(buf, &src, size - total);
+        if (data != NULL)
+        {
+            memcpy(data + total, src, claimed);
+        }
+        total += claimed;
+    } while (claimed > 0 && total < size);
+    ring_buf_get_finish(buf, total);
+    return total;
+}
+
+#endif // TESTS_KENNING_INFERENCE_LIB_MOCKS_RING_BUFFER_H_
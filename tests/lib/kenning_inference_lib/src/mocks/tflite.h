@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_KENNING_INFERENCE_LIB_MOCKS_TFLITE_H_
+#define TESTS_KENNING_INFERENCE_LIB_MOCKS_TFLITE_H_
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TFLITE_SCHEMA_VERSION (3)
+#define TFLITE_RESOLVER_SIZE (4)
+
+typedef enum
+{
+    kTfLiteOk = 0,
+    kTfLiteError = 1,
+} TfLiteStatus;
+
+struct TfLiteContext
+{
+};
+
+struct TfLiteNode
+{
+};
+
+struct TfLiteTensor
+{
+    union
+    {
+        void *data;
+        uint8_t *uint8;
+    } data;
+    size_t bytes;
+};
+
+struct TFLMRegistration
+{
+    TfLiteStatus (*invoke)(TfLiteContext *context, TfLiteNode *node);
+};
+
+// number of interpreters constructed and not yet destroyed
+extern int g_tflite_live_interpreters;
+// number of interpreters constructed since the start of the test
+extern int g_tflite_created_interpreters;
+// status returned by AllocateTensors
+extern TfLiteStatus g_tflite_allocate_status;
+
+void tflite_initialize_resolver();
+
+namespace tflite
+{
+
+enum BuiltinOperator
+{
+    BuiltinOperator_ADD = 0,
+};
+
+typedef TfLiteStatus (*TfLiteBridgeBuiltinParseFunction)(void);
+
+/**
+ * Model whose schema version is kept in the first bytes of the model data
+ */
+class Model
+{
+  public:
+    uint32_t version() const { return m_version; }
+
+  private:
+    uint32_t m_version;
+};
+
+inline const Model *GetModel(const void *buf) { return static_cast<const Model *>(buf); }
+
+class MicroOpResolver
+{
+  public:
+    virtual const TFLMRegistration *FindOp(BuiltinOperator op) const { return nullptr; }
+    virtual const TFLMRegistration *FindOp(const char *op) const { return nullptr; }
+    virtual TfLiteBridgeBuiltinParseFunction GetOpDataParser(BuiltinOperator op) const { return nullptr; }
+};
+
+template <unsigned int tOpCount> class MicroMutableOpResolver : public MicroOpResolver
+{
+};
+
+/**
+ * Interpreter counting its instances, with input tensor placed at the beginning of the tensor arena
+ */
+class MicroInterpreter
+{
+  public:
+    MicroInterpreter(const Model *model, const MicroOpResolver &op_resolver, uint8_t *tensor_arena,
+                     size_t tensor_arena_size)
+        : m_model(model)
+    {
+        m_input.data.data = tensor_arena;
+        m_input.bytes = tensor_arena_size;
+        g_tflite_live_interpreters++;
+        g_tflite_created_interpreters++;
+    }
+
+    ~MicroInterpreter() { g_tflite_live_interpreters--; }
+
+    TfLiteStatus AllocateTensors() { return g_tflite_allocate_status; }
+
+    TfLiteStatus Invoke() { return kTfLiteOk; }
+
+    TfLiteTensor *input(size_t index) { return &m_input; }
+
+    TfLiteTensor *output(size_t index) { return &m_input; }
+
+    size_t arena_used_bytes() const { return 0; }
+
+    const Model *model() const { return m_model; }
+
+  private:
+    const Model *m_model;
+    TfLiteTensor m_input;
+};
+
+} // namespace tflite
+
+#endif // TESTS_KENNING_INFERENCE_LIB_MOCKS_TFLITE_H_
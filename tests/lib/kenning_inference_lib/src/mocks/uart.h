@@ -15,10 +15,97 @@ struct device
     const char *name;
 };
 
+struct uart_config
+{
+    uint32_t baudrate;
+    uint8_t parity;
+    uint8_t stop_bits;
+    uint8_t data_bits;
+    uint8_t flow_ctrl;
+};
+
 bool device_is_ready(const struct device *dev);
 
 int uart_poll_in(const struct device *dev, unsigned char *p_char);
 
 void uart_poll_out(const struct device *dev, unsigned char out_char);
 
+int uart_config_get(const struct device *dev, struct uart_config *cfg);
+
+int uart_configure(const struct device *dev, const struct uart_config *cfg);
+
+// interrupt-driven API
+
+#define UART_CFG_FLOW_CTRL_NONE 0
+#define UART_CFG_FLOW_CTRL_RTS_CTS 1
+#define UART_LINE_CTRL_RTS (1 << 1)
+
+typedef void (*uart_irq_callback_user_data_t)(const struct device *dev, void *user_data);
+
+int uart_irq_callback_user_data_set(const struct device *dev, uart_irq_callback_user_data_t cb, void *user_data);
+
+void uart_irq_rx_enable(const struct device *dev);
+
+void uart_irq_rx_disable(const struct device *dev);
+
+int uart_irq_update(const struct device *dev);
+
+int uart_irq_rx_ready(const struct device *dev);
+
+int uart_fifo_read(const struct device *dev, uint8_t *rx_data, const int size);
+
+int uart_line_ctrl_set(const struct device *dev, uint32_t ctrl, uint32_t val);
+
+// asynchronous API
+
+#define SYS_FOREVER_US (-1)
+
+enum uart_event_type
+{
+    UART_TX_DONE,
+    UART_TX_ABORTED,
+    UART_RX_RDY,
+    UART_RX_BUF_REQUEST,
+    UART_RX_BUF_RELEASED,
+    UART_RX_DISABLED,
+    UART_RX_STOPPED,
+};
+
+struct uart_event_rx
+{
+    uint8_t *buf;
+    size_t offset;
+    size_t len;
+};
+
+struct uart_event_rx_stop
+{
+    int reason;
+    struct uart_event_rx data;
+};
+
+struct uart_event
+{
+    enum uart_event_type type;
+    union
+    {
+        struct uart_event_rx rx;
+        struct uart_event_rx_stop rx_stop;
+    } data;
+};
+
+typedef void (*uart_callback_t)(const struct device *dev, struct uart_event *evt, void *user_data);
+
+int uart_callback_set(const struct device *dev, uart_callback_t callback, void *user_data);
+
+int uart_tx(const struct device *dev, const uint8_t *buf, size_t len, int32_t timeout);
+
+int uart_tx_abort(const struct device *dev);
+
+int uart_rx_enable(const struct device *dev, uint8_t *buf, size_t len, int32_t timeout);
+
+int uart_rx_buf_rsp(const struct device *dev, uint8_t *buf, size_t len);
+
+int uart_rx_disable(const struct device *dev);
+
 #endif // TESTS_KENNING_INFERENCE_LIB_TESTS_MOCKS_UART_H_
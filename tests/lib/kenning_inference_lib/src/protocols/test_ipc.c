@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+
+#include <kenning_inference_lib/core/protocol.h>
+
+#include "mocks/ipc.h"
+#include "mocks/kernel.h"
+#include "mocks/ring_buffer.h"
+#include "utils.h"
+
+#define IPC_MSGQ_BUFFER_SIZE 256
+
+extern bool g_ipc_initialized;
+extern struct k_msgq g_ipc_rx_msgq;
+extern struct ring_buf g_ipc_rx_ring_buf;
+extern const struct protocol_transport g_ipc_transport;
+
+int64_t g_ticks;
+struct ipc_ept_cfg g_ipc_ept_cfg;
+uint8_t g_ipc_msgq_buffer[IPC_MSGQ_BUFFER_SIZE];
+uint32_t g_ipc_msgq_used;
+uint32_t g_ipc_msgq_read_idx;
+
+// ========================================================
+// mocks
+// ========================================================
+DEFINE_FFF_GLOBALS;
+
+#define VOID_MOCKS(MOCK)              \
+    MOCK(k_sem_give, struct k_sem *)  \
+    MOCK(k_sem_reset, struct k_sem *) \
+    MOCK(k_msgq_purge, struct k_msgq *)
+
+#define MOCKS(MOCK)                                                                                               \
+    MOCK(bool, device_is_ready, const struct device *)                                                            \
+    MOCK(int, ipc_service_open_instance, const struct device *)                                                   \
+    MOCK(int, ipc_service_register_endpoint, const struct device *, struct ipc_ept *, const struct ipc_ept_cfg *) \
+    MOCK(int, ipc_service_send, struct ipc_ept *, const void *, size_t)                                           \
+    MOCK(int, ipc_service_get_tx_buffer_size, struct ipc_ept *)                                                   \
+    MOCK(int, ipc_service_hold_rx_buffer, struct ipc_ept *, void *)                                               \
+    MOCK(int, ipc_service_release_rx_buffer, struct ipc_ept *, void *)                                            \
+    MOCK(int, k_sem_take, struct k_sem *, k_timeout_t)                                                            \
+    MOCK(int, k_msgq_put, struct k_msgq *, const void *, k_timeout_t)                                             \
+    MOCK(int, k_msgq_get, struct k_msgq *, void *, k_timeout_t)                                                   \
+    MOCK(uint32_t, k_msgq_num_free_get, struct k_msgq *)
+
+VOID_MOCKS(DECLARE_VOID_MOCK);
+MOCKS(DECLARE_MOCK);
+
+void k_yield(void) {}
+
+int ipc_service_register_endpoint_mock(const struct device *instance, struct ipc_ept *ept,
+                                       const struct ipc_ept_cfg *cfg);
+
+int k_msgq_put_mock(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
+
+int k_msgq_get_mock(struct k_msgq *msgq, void *data, k_timeout_t timeout);
+
+uint32_t k_msgq_num_free_get_mock(struct k_msgq *msgq);
+
+// ========================================================
+// helper functions declarations
+// ========================================================
+
+/**
+ * Initializes the transport with mocked IPC service
+ */
+static void init_ipc();
+
+/**
+ * Passes received data to the endpoint callback
+ *
+ * @param data received data
+ * @param len length of the data
+ */
+static void receive_ipc_data(const void *data, size_t len);
+
+// ========================================================
+// setup
+// ========================================================
+
+static void ipc_tests_setup_f()
+{
+    VOID_MOCKS(RESET_VOID_MOCK);
+    MOCKS(RESET_MOCK);
+
+    ipc_service_register_endpoint_fake.custom_fake = ipc_service_register_endpoint_mock;
+    k_msgq_put_fake.custom_fake = k_msgq_put_mock;
+    k_msgq_get_fake.custom_fake = k_msgq_get_mock;
+    k_msgq_num_free_get_fake.custom_fake = k_msgq_num_free_get_mock;
+
+    g_ipc_initialized = false;
+    g_ipc_msgq_used = 0;
+    g_ipc_msgq_read_idx = 0;
+    memset(&g_ipc_ept_cfg, 0, sizeof(g_ipc_ept_cfg));
+}
+
+ZTEST_SUITE(kenning_inference_lib_test_ipc, NULL, NULL, ipc_tests_setup_f, NULL, NULL);
+
+// ========================================================
+// ipc transport init
+// ========================================================
+
+/**
+ * Tests if initialization registers the endpoint
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_init)
+{
+    status_t status = STATUS_OK;
+
+    device_is_ready_fake.return_val = true;
+    status = g_ipc_transport.init();
+
+    zassert_equal(STATUS_OK, status);
+    zassert_true(g_ipc_initialized);
+    zassert_equal(1, ipc_service_register_endpoint_fake.call_count);
+    zassert_not_null(g_ipc_ept_cfg.cb.received);
+}
+
+/**
+ * Tests initialization when the IPC instance is not ready
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_init_device_not_ready)
+{
+    status_t status = STATUS_OK;
+
+    device_is_ready_fake.return_val = false;
+    status = g_ipc_transport.init();
+
+    zassert_equal(PROTOCOL_STATUS_ERROR, status);
+    zassert_false(g_ipc_initialized);
+    zassert_equal(0, ipc_service_register_endpoint_fake.call_count);
+}
+
+// ========================================================
+// ipc reception
+// ========================================================
+
+/**
+ * Tests reading data kept in the shared memory, buffer should be released once it is read
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_read_held_buffer)
+{
+    status_t status = STATUS_OK;
+    uint8_t data_in[] = "some data";
+    uint8_t data_out[sizeof(data_in)];
+
+    init_ipc();
+    receive_ipc_data(data_in, sizeof(data_in));
+
+    status = g_ipc_transport.read(data_out, sizeof(data_out));
+
+    zassert_equal(STATUS_OK, status);
+    zassert_mem_equal(data_in, data_out, sizeof(data_in));
+    zassert_equal(1, ipc_service_release_rx_buffer_fake.call_count);
+    zassert_equal(data_in, ipc_service_release_rx_buffer_fake.arg1_val);
+}
+
+/**
+ * Tests reading data copied to the ring buffer when the backend does not allow holding RX buffers
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_read_copied_buffer)
+{
+    status_t status = STATUS_OK;
+    uint8_t data_in[] = "some data";
+    uint8_t data_out[sizeof(data_in)];
+
+    init_ipc();
+    ipc_service_hold_rx_buffer_fake.return_val = -ENOTSUP;
+    receive_ipc_data(data_in, sizeof(data_in));
+    memset(data_in, 0, sizeof(data_in));
+
+    status = g_ipc_transport.read(data_out, sizeof(data_out));
+
+    zassert_equal(STATUS_OK, status);
+    zassert_mem_equal("some data", data_out, sizeof(data_out));
+    zassert_equal(0, ipc_service_release_rx_buffer_fake.call_count);
+    zassert_equal(0, ring_buf_size_get(&g_ipc_rx_ring_buf));
+}
+
+/**
+ * Tests if data is not copied to the ring buffer when the queue is full
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_receive_queue_full)
+{
+    uint8_t data_in[] = "some data";
+
+    init_ipc();
+    ipc_service_hold_rx_buffer_fake.return_val = -ENOTSUP;
+    for (int i = 0; i < CONFIG_KENNING_IPC_RX_QUEUE_SIZE; ++i)
+    {
+        receive_ipc_data(data_in, 1);
+    }
+
+    receive_ipc_data(data_in, sizeof(data_in));
+
+    zassert_equal(CONFIG_KENNING_IPC_RX_QUEUE_SIZE, k_msgq_put_fake.call_count);
+    zassert_equal(CONFIG_KENNING_IPC_RX_QUEUE_SIZE, ring_buf_size_get(&g_ipc_rx_ring_buf));
+}
+
+/**
+ * Tests if overflow is reported once and all queued data is dropped along with it
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_read_overflow)
+{
+    status_t status = STATUS_OK;
+    uint8_t data_held[] = "held";
+    uint8_t data_copied[] = "copied";
+    uint8_t data_in[] = "some data";
+    uint8_t data_out[sizeof(data_in)];
+
+    init_ipc();
+    receive_ipc_data(data_held, sizeof(data_held));
+    ipc_service_hold_rx_buffer_fake.return_val = -ENOTSUP;
+    for (int i = 1; i < CONFIG_KENNING_IPC_RX_QUEUE_SIZE; ++i)
+    {
+        receive_ipc_data(data_copied, sizeof(data_copied));
+    }
+    receive_ipc_data(data_copied, sizeof(data_copied));
+
+    status = g_ipc_transport.read(data_out, sizeof(data_out));
+
+    zassert_equal(PROTOCOL_STATUS_RECV_ERROR, status);
+    zassert_equal(0, g_ipc_msgq_used);
+    zassert_equal(0, ring_buf_size_get(&g_ipc_rx_ring_buf));
+    zassert_equal(1, ipc_service_release_rx_buffer_fake.call_count);
+    zassert_equal(data_held, ipc_service_release_rx_buffer_fake.arg1_val);
+
+    ipc_service_hold_rx_buffer_fake.return_val = 0;
+    receive_ipc_data(data_in, sizeof(data_in));
+
+    status = g_ipc_transport.read(data_out, sizeof(data_out));
+
+    zassert_equal(STATUS_OK, status);
+    zassert_mem_equal(data_in, data_out, sizeof(data_in));
+}
+
+/**
+ * Tests reading data when nothing is received
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_read_timeout)
+{
+    status_t status = STATUS_OK;
+    uint8_t data_out[8];
+
+    init_ipc();
+
+    status = g_ipc_transport.read(data_out, sizeof(data_out));
+
+    zassert_equal(PROTOCOL_STATUS_TIMEOUT, status);
+}
+
+/**
+ * Tests reading data when IPC is not initialized
+ */
+ZTEST(kenning_inference_lib_test_ipc, test_ipc_read_not_initialized)
+{
+    status_t status = STATUS_OK;
+    uint8_t data_out[8];
+
+    status = g_ipc_transport.read(data_out, sizeof(data_out));
+
+    zassert_equal(PROTOCOL_STATUS_UNINIT, status);
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static void init_ipc()
+{
+    device_is_ready_fake.return_val = true;
+    zassert_equal(STATUS_OK, g_ipc_transport.init());
+    zassert_not_null(g_ipc_ept_cfg.cb.received);
+}
+
+static void receive_ipc_data(const void *data, size_t len) { g_ipc_ept_cfg.cb.received(data, len, NULL); }
+
+// ========================================================
+// mocks
+// ========================================================
+
+int ipc_service_register_endpoint_mock(const struct device *instance, struct ipc_ept *ept,
+                                       const struct ipc_ept_cfg *cfg)
+{
+    g_ipc_ept_cfg = *cfg;
+    return 0;
+}
+
+int k_msgq_put_mock(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+    if (g_ipc_msgq_used >= msgq->max_msgs)
+    {
+        return -ENOMSG;
+    }
+    memcpy(g_ipc_msgq_buffer + ((g_ipc_msgq_read_idx + g_ipc_msgq_used) % msgq->max_msgs) * msgq->msg_size, data,
+           msgq->msg_size);
+    g_ipc_msgq_used++;
+    return 0;
+}
+
+int k_msgq_get_mock(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+    if (0 == g_ipc_msgq_used)
+    {
+        return -EAGAIN;
+    }
+    memcpy(data, g_ipc_msgq_buffer + g_ipc_msgq_read_idx * msgq->msg_size, msgq->msg_size);
+    g_ipc_msgq_read_idx = (g_ipc_msgq_read_idx + 1) % msgq->max_msgs;
+    g_ipc_msgq_used--;
+    return 0;
+}
+
+uint32_t k_msgq_num_free_get_mock(struct k_msgq *msgq) { return msgq->max_msgs - g_ipc_msgq_used; }
@@ -8,39 +8,101 @@
 
 #include <kenning_inference_lib/core/protocol.h>
 
+#include "mocks/kernel.h"
+#include "mocks/uart.h"
 #include "utils.h"
 
 #define UART_BUFFER_SIZE 256
 
 extern bool g_uart_initialized;
+extern const struct protocol_transport g_uart_transport;
 
 uint64_t g_ticks;
 uint8_t g_uart_buffer_out[UART_BUFFER_SIZE];
 size_t g_uart_buffer_out_idx;
 uint8_t g_uart_buffer_in[UART_BUFFER_SIZE];
 size_t g_uart_buffer_in_idx;
+struct uart_config g_uart_config;
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+size_t g_uart_buffer_in_size;
+bool g_uart_rx_irq_enabled;
+uint32_t g_uart_rts;
+uart_irq_callback_user_data_t g_uart_rx_isr;
+#endif // CONFIG_KENNING_UART_RX_IRQ
 
 // ========================================================
 // mocks
 // ========================================================
 DEFINE_FFF_GLOBALS;
 
-#define VOID_MOCKS(MOCK) MOCK(uart_poll_out, const struct device *, unsigned char)
+#define VOID_MOCKS(MOCK)                                      \
+    MOCK(uart_poll_out, const struct device *, unsigned char) \
+    MOCK(k_busy_wait, uint32_t)
 
-#define MOCKS(MOCK)                                                 \
-    MOCK(bool, device_is_ready, const struct device *)              \
-    MOCK(int, uart_poll_in, const struct device *, unsigned char *) \
+#define MOCKS(MOCK)                                                              \
+    MOCK(bool, device_is_ready, const struct device *)                           \
+    MOCK(int, uart_poll_in, const struct device *, unsigned char *)              \
+    MOCK(int, uart_config_get, const struct device *, struct uart_config *)      \
+    MOCK(int, uart_configure, const struct device *, const struct uart_config *) \
     MOCK(int32_t, k_sleep, k_timeout_t)
 
 VOID_MOCKS(DECLARE_VOID_MOCK);
 MOCKS(DECLARE_MOCK);
 
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+#define IRQ_VOID_MOCKS(MOCK)                         \
+    MOCK(uart_irq_rx_enable, const struct device *)  \
+    MOCK(uart_irq_rx_disable, const struct device *) \
+    MOCK(k_sem_give, struct k_sem *)                 \
+    MOCK(k_sem_reset, struct k_sem *)
+
+#define IRQ_MOCKS(MOCK)                                                                                        \
+    MOCK(int, uart_irq_callback_user_data_set, const struct device *, uart_irq_callback_user_data_t, void *) \
+    MOCK(int, uart_irq_update, const struct device *)                                                        \
+    MOCK(int, uart_irq_rx_ready, const struct device *)                                                      \
+    MOCK(int, uart_fifo_read, const struct device *, uint8_t *, int)                                         \
+    MOCK(int, uart_line_ctrl_set, const struct device *, uint32_t, uint32_t)                                 \
+    MOCK(int, k_sem_take, struct k_sem *, k_timeout_t)
+
+IRQ_VOID_MOCKS(DECLARE_VOID_MOCK);
+IRQ_MOCKS(DECLARE_MOCK);
+
+void uart_irq_rx_enable_mock(const struct device *dev);
+
+void uart_irq_rx_disable_mock(const struct device *dev);
+
+int uart_irq_callback_user_data_set_mock(const struct device *dev, uart_irq_callback_user_data_t cb, void *user_data);
+
+int uart_irq_rx_ready_mock(const struct device *dev);
+
+int uart_fifo_read_mock(const struct device *dev, uint8_t *rx_data, const int size);
+
+int uart_line_ctrl_set_mock(const struct device *dev, uint32_t ctrl, uint32_t val);
+
+void k_sem_give_mock(struct k_sem *sem);
+
+void k_sem_reset_mock(struct k_sem *sem);
+
+int k_sem_take_mock(struct k_sem *sem, k_timeout_t timeout);
+
+/**
+ * Puts data of given size into the mocked UART RX FIFO
+ *
+ * @param size size of the data
+ */
+static void fill_uart_fifo(size_t size);
+#endif // CONFIG_KENNING_UART_RX_IRQ
+
 void uart_poll_out_mock(const struct device *dev, unsigned char out_char);
 
 int uart_poll_in_mock(const struct device *dev, unsigned char *p_char);
 
 int32_t k_sleep_mock(k_timeout_t timeout);
 
+int uart_config_get_mock(const struct device *dev, struct uart_config *cfg);
+
+int uart_configure_mock(const struct device *dev, const struct uart_config *cfg);
+
 // ========================================================
 // setup
 // ========================================================
@@ -51,17 +113,39 @@ static void uart_tests_setup_f()
     MOCKS(RESET_MOCK);
 
     k_sleep_fake.custom_fake = k_sleep_mock;
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+    IRQ_VOID_MOCKS(RESET_VOID_MOCK);
+    IRQ_MOCKS(RESET_MOCK);
+
+    uart_irq_rx_enable_fake.custom_fake = uart_irq_rx_enable_mock;
+    uart_irq_rx_disable_fake.custom_fake = uart_irq_rx_disable_mock;
+    uart_irq_callback_user_data_set_fake.custom_fake = uart_irq_callback_user_data_set_mock;
+    uart_irq_update_fake.return_val = 1;
+    uart_irq_rx_ready_fake.custom_fake = uart_irq_rx_ready_mock;
+    uart_fifo_read_fake.custom_fake = uart_fifo_read_mock;
+    uart_line_ctrl_set_fake.custom_fake = uart_line_ctrl_set_mock;
+    k_sem_give_fake.custom_fake = k_sem_give_mock;
+    k_sem_reset_fake.custom_fake = k_sem_reset_mock;
+    k_sem_take_fake.custom_fake = k_sem_take_mock;
+
+    g_uart_buffer_in_size = 0;
+    g_uart_rx_irq_enabled = false;
+    g_uart_rts = 1;
+    g_uart_rx_isr = NULL;
+#endif // CONFIG_KENNING_UART_RX_IRQ
 
     g_uart_initialized = false;
     g_ticks = 0;
     g_uart_buffer_out_idx = 0;
     g_uart_buffer_in_idx = 0;
+    g_uart_config.baudrate = 115200;
+    g_uart_config.flow_ctrl = 0;
 }
 
 ZTEST_SUITE(kenning_inference_lib_test_uart, NULL, NULL, uart_tests_setup_f, NULL, NULL);
 
 // ========================================================
-// protocol_init
+// uart transport init
 // ========================================================
 
 /**
@@ -72,7 +156,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_init)
     status_t status = STATUS_OK;
 
     device_is_ready_fake.return_val = true;
-    status = protocol_init();
+    status = g_uart_transport.init();
 
     zassert_equal(STATUS_OK, status);
     zassert_true(g_uart_initialized);
@@ -88,7 +172,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_init_already_initialized)
     device_is_ready_fake.return_val = true;
     g_uart_initialized = true;
 
-    status = protocol_init();
+    status = g_uart_transport.init();
 
     zassert_equal(STATUS_OK, status);
     zassert_true(g_uart_initialized);
@@ -102,14 +186,14 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_init_device_not_ready)
     status_t status = STATUS_OK;
 
     device_is_ready_fake.return_val = false;
-    status = protocol_init();
+    status = g_uart_transport.init();
 
     zassert_equal(PROTOCOL_STATUS_ERROR, status);
     zassert_false(g_uart_initialized);
 }
 
 // ========================================================
-// protocol_write_data
+// uart transport write
 // ========================================================
 
 /**
@@ -123,7 +207,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_write_data)
     g_uart_initialized = true;
     uart_poll_out_fake.custom_fake = uart_poll_out_mock;
 
-    status = protocol_write_data(data, sizeof(data));
+    status = g_uart_transport.write(data, sizeof(data));
 
     zassert_equal(STATUS_OK, status);
     zassert_mem_equal(data, g_uart_buffer_out, sizeof(data));
@@ -140,7 +224,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_write_data_not_initialized)
 
     uart_poll_out_fake.custom_fake = uart_poll_out_mock;
 
-    status = protocol_write_data(data, sizeof(data));
+    status = g_uart_transport.write(data, sizeof(data));
 
     zassert_equal(PROTOCOL_STATUS_UNINIT, status);
     zassert_equal(0, g_uart_buffer_out_idx);
@@ -156,7 +240,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_write_data_invalid_pointer)
     g_uart_initialized = true;
     uart_poll_out_fake.custom_fake = uart_poll_out_mock;
 
-    status = protocol_write_data(NULL, 1);
+    status = g_uart_transport.write(NULL, 1);
 
     zassert_equal(PROTOCOL_STATUS_INV_PTR, status);
     zassert_equal(0, g_uart_buffer_out_idx);
@@ -173,16 +257,18 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_write_data_no_data)
     g_uart_initialized = true;
     uart_poll_out_fake.custom_fake = uart_poll_out_mock;
 
-    status = protocol_write_data(data, 0);
+    status = g_uart_transport.write(data, 0);
 
     zassert_equal(STATUS_OK, status);
     zassert_equal(0, g_uart_buffer_out_idx);
 }
 
 // ========================================================
-// protocol_read_data
+// uart transport read
 // ========================================================
 
+#ifndef CONFIG_KENNING_UART_RX_IRQ
+
 /**
  * Tests reading data from UART
  */
@@ -196,7 +282,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_read_data)
     g_uart_initialized = true;
     uart_poll_in_fake.custom_fake = uart_poll_in_mock;
 
-    status = protocol_read_data(buffer, sizeof(data));
+    status = g_uart_transport.read(buffer, sizeof(data));
 
     zassert_equal(STATUS_OK, status);
     zassert_mem_equal(data, buffer, sizeof(data));
@@ -215,7 +301,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_read_data_not_initialized)
 
     uart_poll_in_fake.custom_fake = uart_poll_in_mock;
 
-    status = protocol_read_data(buffer, sizeof(data));
+    status = g_uart_transport.read(buffer, sizeof(data));
 
     zassert_equal(PROTOCOL_STATUS_UNINIT, status);
     zassert_equal(0, g_uart_buffer_in_idx);
@@ -233,7 +319,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_read_data_invalid_pointer)
     g_uart_initialized = true;
     uart_poll_in_fake.custom_fake = uart_poll_in_mock;
 
-    status = protocol_read_data(NULL, sizeof(data));
+    status = g_uart_transport.read(NULL, sizeof(data));
     zassert_equal(STATUS_OK, status);
     zassert_equal(sizeof(data), g_uart_buffer_in_idx);
 }
@@ -251,7 +337,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_read_data_no_data)
     g_uart_initialized = true;
     uart_poll_in_fake.custom_fake = uart_poll_in_mock;
 
-    status = protocol_read_data(buffer, 0);
+    status = g_uart_transport.read(buffer, 0);
 
     zassert_equal(STATUS_OK, status);
     zassert_equal(0, g_uart_buffer_in_idx);
@@ -270,7 +356,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_read_data_timeout)
     g_uart_initialized = true;
     uart_poll_in_fake.return_val = -1;
 
-    status = protocol_read_data(buffer, sizeof(data));
+    status = g_uart_transport.read(buffer, sizeof(data));
 
     zassert_equal(PROTOCOL_STATUS_TIMEOUT, status);
 }
@@ -288,7 +374,7 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_read_data_nosys)
     g_uart_initialized = true;
     uart_poll_in_fake.return_val = -ENOSYS;
 
-    status = protocol_read_data(buffer, sizeof(data));
+    status = g_uart_transport.read(buffer, sizeof(data));
 
     zassert_equal(PROTOCOL_STATUS_RECV_ERROR_NOSYS, status);
 }
@@ -306,11 +392,269 @@ ZTEST(kenning_inference_lib_test_uart, test_uart_read_data_busy)
     g_uart_initialized = true;
     uart_poll_in_fake.return_val = -EBUSY;
 
-    status = protocol_read_data(buffer, sizeof(data));
+    status = g_uart_transport.read(buffer, sizeof(data));
 
     zassert_equal(PROTOCOL_STATUS_RECV_ERROR_BUSY, status);
 }
 
+#else // CONFIG_KENNING_UART_RX_IRQ
+
+/**
+ * Tests reading data received in the UART RX interrupt
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_irq_read_data)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[256];
+    uint8_t data[] = "some data";
+    memcpy(g_uart_buffer_in, data, sizeof(data));
+    g_uart_buffer_in_size = sizeof(data);
+
+    device_is_ready_fake.return_val = true;
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    uart_configure_fake.custom_fake = uart_configure_mock;
+    zassert_equal(STATUS_OK, g_uart_transport.init());
+
+    status = g_uart_transport.read(buffer, sizeof(data));
+
+    zassert_equal(STATUS_OK, status);
+    zassert_mem_equal(data, buffer, sizeof(data));
+    zassert_equal(sizeof(data), g_uart_buffer_in_idx);
+    zassert_equal(UART_CFG_FLOW_CTRL_RTS_CTS, g_uart_config.flow_ctrl);
+}
+
+/**
+ * Tests reading data when no data is received in the UART RX interrupt
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_irq_read_data_timeout)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[256];
+
+    device_is_ready_fake.return_val = true;
+    zassert_equal(STATUS_OK, g_uart_transport.init());
+
+    status = g_uart_transport.read(buffer, 1);
+
+    zassert_equal(PROTOCOL_STATUS_TIMEOUT, status);
+}
+
+/**
+ * Tests if the ISR pauses reception and deasserts RTS when the ring buffer is full
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_irq_rx_pause_on_full_ring)
+{
+    fill_uart_fifo(2 * CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE);
+
+    device_is_ready_fake.return_val = true;
+    zassert_equal(STATUS_OK, g_uart_transport.init());
+
+    g_uart_rx_isr(NULL, NULL);
+
+    zassert_equal(CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE, g_uart_buffer_in_idx);
+    zassert_equal(1, uart_irq_rx_disable_fake.call_count);
+    zassert_false(g_uart_rx_irq_enabled);
+    zassert_equal(0, g_uart_rts);
+
+    // paused reception does not drain the FIFO
+    g_uart_rx_isr(NULL, NULL);
+
+    zassert_equal(CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE, g_uart_buffer_in_idx);
+}
+
+/**
+ * Tests if reading data from the full ring buffer resumes reception, so that the rest of data is received
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_irq_read_resumes_rx)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[2 * CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE];
+    size_t data_size = sizeof(buffer) - 10;
+
+    fill_uart_fifo(data_size);
+
+    device_is_ready_fake.return_val = true;
+    zassert_equal(STATUS_OK, g_uart_transport.init());
+    g_uart_rx_isr(NULL, NULL);
+    zassert_false(g_uart_rx_irq_enabled);
+
+    status = g_uart_transport.read(buffer, data_size);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_mem_equal(g_uart_buffer_in, buffer, data_size);
+    zassert_equal(data_size, g_uart_buffer_in_idx);
+    zassert_true(g_uart_rx_irq_enabled);
+    zassert_equal(1, g_uart_rts);
+}
+
+/**
+ * Tests if releasing leased data resumes reception only when enough space is freed in the ring buffer
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_irq_release_resumes_rx)
+{
+    const uint8_t *data = NULL;
+    size_t data_length = 0;
+
+    fill_uart_fifo(2 * CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE);
+
+    device_is_ready_fake.return_val = true;
+    zassert_equal(STATUS_OK, g_uart_transport.init());
+    g_uart_rx_isr(NULL, NULL);
+
+    zassert_equal(STATUS_OK, g_uart_transport.lease(&data, CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE, &data_length));
+    zassert_equal(CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE, data_length);
+    zassert_mem_equal(g_uart_buffer_in, data, data_length);
+
+    zassert_equal(STATUS_OK, g_uart_transport.release(CONFIG_KENNING_UART_RX_RTS_THRESHOLD));
+    zassert_false(g_uart_rx_irq_enabled);
+    zassert_equal(0, g_uart_rts);
+
+    zassert_equal(STATUS_OK, g_uart_transport.lease(&data, CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE, &data_length));
+    zassert_equal(STATUS_OK, g_uart_transport.release(1));
+    zassert_true(g_uart_rx_irq_enabled);
+    zassert_equal(1, g_uart_rts);
+}
+
+/**
+ * Tests releasing data that was not leased
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_irq_release_not_leased)
+{
+    device_is_ready_fake.return_val = true;
+    zassert_equal(STATUS_OK, g_uart_transport.init());
+
+    zassert_equal(PROTOCOL_STATUS_ERROR, g_uart_transport.release(1));
+}
+
+#endif // CONFIG_KENNING_UART_RX_IRQ
+
+// ========================================================
+// uart transport set_baudrate
+// ========================================================
+
+/**
+ * Tests changing UART baudrate
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_set_baudrate)
+{
+    status_t status = STATUS_OK;
+
+    g_uart_initialized = true;
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    uart_configure_fake.custom_fake = uart_configure_mock;
+
+    status = g_uart_transport.set_baudrate(921600);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, uart_configure_fake.call_count);
+    zassert_equal(921600, g_uart_config.baudrate);
+    zassert_equal(1, k_busy_wait_fake.call_count);
+}
+
+/**
+ * Tests changing UART baudrate to the current one
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_set_baudrate_same_baudrate)
+{
+    status_t status = STATUS_OK;
+
+    g_uart_initialized = true;
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    uart_configure_fake.custom_fake = uart_configure_mock;
+
+    status = g_uart_transport.set_baudrate(115200);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(0, uart_configure_fake.call_count);
+    zassert_equal(115200, g_uart_config.baudrate);
+}
+
+/**
+ * Tests changing UART baudrate when UART is not initialized
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_set_baudrate_not_initialized)
+{
+    status_t status = STATUS_OK;
+
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    uart_configure_fake.custom_fake = uart_configure_mock;
+
+    status = g_uart_transport.set_baudrate(921600);
+
+    zassert_equal(PROTOCOL_STATUS_UNINIT, status);
+    zassert_equal(0, uart_configure_fake.call_count);
+    zassert_equal(115200, g_uart_config.baudrate);
+}
+
+/**
+ * Tests changing UART baudrate when the baudrate is not supported by the driver
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_set_baudrate_not_supported)
+{
+    status_t status = STATUS_OK;
+
+    g_uart_initialized = true;
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    uart_configure_fake.return_val = -ENOTSUP;
+
+    status = g_uart_transport.set_baudrate(12345678);
+
+    zassert_equal(PROTOCOL_STATUS_INV_ARG_BAUDRATE, status);
+    zassert_equal(1, uart_configure_fake.call_count);
+}
+
+/**
+ * Tests changing UART baudrate when the configuration cannot be retrieved
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_set_baudrate_config_get_error)
+{
+    status_t status = STATUS_OK;
+
+    g_uart_initialized = true;
+    uart_config_get_fake.return_val = -ENOSYS;
+
+    status = g_uart_transport.set_baudrate(921600);
+
+    zassert_equal(PROTOCOL_STATUS_ERROR, status);
+    zassert_equal(0, uart_configure_fake.call_count);
+}
+
+// ========================================================
+// uart transport get_baudrate
+// ========================================================
+
+/**
+ * Tests retrieving UART baudrate
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_get_baudrate)
+{
+    status_t status = STATUS_OK;
+    uint32_t baudrate = 0;
+
+    g_uart_initialized = true;
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+
+    status = g_uart_transport.get_baudrate(&baudrate);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(115200, baudrate);
+}
+
+/**
+ * Tests retrieving UART baudrate when pointer is invalid
+ */
+ZTEST(kenning_inference_lib_test_uart, test_uart_get_baudrate_invalid_pointer)
+{
+    status_t status = STATUS_OK;
+
+    g_uart_initialized = true;
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+
+    status = g_uart_transport.get_baudrate(NULL);
+
+    zassert_equal(PROTOCOL_STATUS_INV_PTR, status);
+}
+
 // ========================================================
 // mocks
 // ========================================================
@@ -338,3 +682,84 @@ int32_t k_sleep_mock(k_timeout_t timeout)
     g_ticks += timeout.ticks;
     return 0;
 }
+
+#ifdef CONFIG_KENNING_UART_RX_IRQ
+static void fill_uart_fifo(size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        g_uart_buffer_in[i] = i;
+    }
+    g_uart_buffer_in_size = size;
+}
+
+void uart_irq_rx_enable_mock(const struct device *dev) { g_uart_rx_irq_enabled = true; }
+
+void uart_irq_rx_disable_mock(const struct device *dev) { g_uart_rx_irq_enabled = false; }
+
+int uart_irq_callback_user_data_set_mock(const struct device *dev, uart_irq_callback_user_data_t cb, void *user_data)
+{
+    g_uart_rx_isr = cb;
+    return 0;
+}
+
+int uart_irq_rx_ready_mock(const struct device *dev)
+{
+    return g_uart_rx_irq_enabled && g_uart_buffer_in_idx < g_uart_buffer_in_size;
+}
+
+int uart_fifo_read_mock(const struct device *dev, uint8_t *rx_data, const int size)
+{
+    size_t n = MIN((size_t)size, g_uart_buffer_in_size - g_uart_buffer_in_idx);
+
+    memcpy(rx_data, g_uart_buffer_in + g_uart_buffer_in_idx, n);
+    g_uart_buffer_in_idx += n;
+    return n;
+}
+
+int uart_line_ctrl_set_mock(const struct device *dev, uint32_t ctrl, uint32_t val)
+{
+    if (UART_LINE_CTRL_RTS == ctrl)
+    {
+        g_uart_rts = val;
+    }
+    return 0;
+}
+
+void k_sem_give_mock(struct k_sem *sem)
+{
+    if (sem->count < sem->limit)
+    {
+        sem->count++;
+    }
+}
+
+void k_sem_reset_mock(struct k_sem *sem) { sem->count = 0; }
+
+int k_sem_take_mock(struct k_sem *sem, k_timeout_t timeout)
+{
+    // RX interrupt fires while the reader waits for data
+    if (0 == sem->count && uart_irq_rx_ready_mock(NULL))
+    {
+        g_uart_rx_isr(NULL, NULL);
+    }
+    if (0 == sem->count)
+    {
+        return -EAGAIN;
+    }
+    sem->count--;
+    return 0;
+}
+#endif // CONFIG_KENNING_UART_RX_IRQ
+
+int uart_config_get_mock(const struct device *dev, struct uart_config *cfg)
+{
+    *cfg = g_uart_config;
+    return 0;
+}
+
+int uart_configure_mock(const struct device *dev, const struct uart_config *cfg)
+{
+    g_uart_config = *cfg;
+    return 0;
+}
@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+
+#include <kenning_inference_lib/core/protocol.h>
+
+#include "mocks/kernel.h"
+#include "mocks/uart.h"
+#include "utils.h"
+
+#define UART_BUFFER_SIZE 256
+
+extern bool g_uart_initialized;
+extern uint8_t g_uart_rx_bufs[2][CONFIG_KENNING_UART_ASYNC_RX_BUFFER_SIZE];
+extern const struct protocol_transport g_uart_async_transport;
+
+uint8_t g_uart_buffer_out[UART_BUFFER_SIZE];
+size_t g_uart_buffer_out_idx;
+struct uart_config g_uart_config;
+uart_callback_t g_uart_callback;
+enum uart_event_type g_uart_tx_event;
+
+// ========================================================
+// mocks
+// ========================================================
+DEFINE_FFF_GLOBALS;
+
+#define VOID_MOCKS(MOCK)              \
+    MOCK(k_busy_wait, uint32_t)       \
+    MOCK(k_sem_give, struct k_sem *)  \
+    MOCK(k_sem_reset, struct k_sem *)
+
+#define MOCKS(MOCK)                                                              \
+    MOCK(bool, device_is_ready, const struct device *)                           \
+    MOCK(int, uart_callback_set, const struct device *, uart_callback_t, void *) \
+    MOCK(int, uart_rx_enable, const struct device *, uint8_t *, size_t, int32_t) \
+    MOCK(int, uart_rx_buf_rsp, const struct device *, uint8_t *, size_t)         \
+    MOCK(int, uart_rx_disable, const struct device *)                            \
+    MOCK(int, uart_tx, const struct device *, const uint8_t *, size_t, int32_t)  \
+    MOCK(int, uart_tx_abort, const struct device *)                              \
+    MOCK(int, uart_config_get, const struct device *, struct uart_config *)      \
+    MOCK(int, uart_configure, const struct device *, const struct uart_config *) \
+    MOCK(int, k_sem_take, struct k_sem *, k_timeout_t)
+
+VOID_MOCKS(DECLARE_VOID_MOCK);
+MOCKS(DECLARE_MOCK);
+
+int uart_callback_set_mock(const struct device *dev, uart_callback_t callback, void *user_data);
+
+int uart_tx_mock(const struct device *dev, const uint8_t *buf, size_t len, int32_t timeout);
+
+int uart_tx_abort_mock(const struct device *dev);
+
+int uart_rx_disable_mock(const struct device *dev);
+
+int uart_config_get_mock(const struct device *dev, struct uart_config *cfg);
+
+int uart_configure_mock(const struct device *dev, const struct uart_config *cfg);
+
+void k_sem_give_mock(struct k_sem *sem);
+
+void k_sem_reset_mock(struct k_sem *sem);
+
+int k_sem_take_mock(struct k_sem *sem, k_timeout_t timeout);
+
+// ========================================================
+// helper functions declarations
+// ========================================================
+
+/**
+ * Initializes the transport with mocked UART
+ */
+static void init_uart_async();
+
+/**
+ * Passes event of given type to the UART callback
+ *
+ * @param type type of the event
+ */
+static void send_uart_event(enum uart_event_type type);
+
+/**
+ * Passes UART_RX_RDY event with given data to the UART callback
+ *
+ * @param buf buffer with received data
+ * @param offset offset of the data in the buffer
+ * @param len length of the data
+ */
+static void send_uart_rx_rdy(uint8_t *buf, size_t offset, size_t len);
+
+// ========================================================
+// setup
+// ========================================================
+
+static void uart_async_tests_setup_f()
+{
+    VOID_MOCKS(RESET_VOID_MOCK);
+    MOCKS(RESET_MOCK);
+
+    uart_callback_set_fake.custom_fake = uart_callback_set_mock;
+    uart_tx_fake.custom_fake = uart_tx_mock;
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    k_sem_give_fake.custom_fake = k_sem_give_mock;
+    k_sem_reset_fake.custom_fake = k_sem_reset_mock;
+    k_sem_take_fake.custom_fake = k_sem_take_mock;
+
+    g_uart_initialized = false;
+    g_uart_buffer_out_idx = 0;
+    g_uart_config.baudrate = 115200;
+    g_uart_callback = NULL;
+    g_uart_tx_event = UART_TX_DONE;
+}
+
+ZTEST_SUITE(kenning_inference_lib_test_uart_async, NULL, NULL, uart_async_tests_setup_f, NULL, NULL);
+
+// ========================================================
+// uart async transport init
+// ========================================================
+
+/**
+ * Tests if initialization enables reception into the first RX buffer
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_init)
+{
+    status_t status = STATUS_OK;
+
+    device_is_ready_fake.return_val = true;
+    status = g_uart_async_transport.init();
+
+    zassert_equal(STATUS_OK, status);
+    zassert_true(g_uart_initialized);
+    zassert_equal(1, uart_rx_enable_fake.call_count);
+    zassert_equal(g_uart_rx_bufs[0], uart_rx_enable_fake.arg1_val);
+    zassert_equal(CONFIG_KENNING_UART_ASYNC_RX_BUFFER_SIZE, uart_rx_enable_fake.arg2_val);
+}
+
+/**
+ * Tests initialization when the driver does not support asynchronous API
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_init_not_supported)
+{
+    status_t status = STATUS_OK;
+
+    device_is_ready_fake.return_val = true;
+    uart_callback_set_fake.custom_fake = NULL;
+    uart_callback_set_fake.return_val = -ENOSYS;
+
+    status = g_uart_async_transport.init();
+
+    zassert_equal(PROTOCOL_STATUS_ERROR, status);
+    zassert_false(g_uart_initialized);
+    zassert_equal(0, uart_rx_enable_fake.call_count);
+}
+
+/**
+ * Tests initialization when reception cannot be enabled
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_init_rx_enable_error)
+{
+    status_t status = STATUS_OK;
+
+    device_is_ready_fake.return_val = true;
+    uart_rx_enable_fake.return_val = -EBUSY;
+
+    status = g_uart_async_transport.init();
+
+    zassert_equal(PROTOCOL_STATUS_ERROR, status);
+    zassert_false(g_uart_initialized);
+}
+
+// ========================================================
+// uart async reception
+// ========================================================
+
+/**
+ * Tests if the driver is given the two RX buffers in turns
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_rx_buf_rotation)
+{
+    init_uart_async();
+
+    send_uart_event(UART_RX_BUF_REQUEST);
+    send_uart_event(UART_RX_BUF_REQUEST);
+    send_uart_event(UART_RX_BUF_REQUEST);
+
+    zassert_equal(3, uart_rx_buf_rsp_fake.call_count);
+    zassert_equal(g_uart_rx_bufs[1], uart_rx_buf_rsp_fake.arg1_history[0]);
+    zassert_equal(g_uart_rx_bufs[0], uart_rx_buf_rsp_fake.arg1_history[1]);
+    zassert_equal(g_uart_rx_bufs[1], uart_rx_buf_rsp_fake.arg1_history[2]);
+    zassert_equal(CONFIG_KENNING_UART_ASYNC_RX_BUFFER_SIZE, uart_rx_buf_rsp_fake.arg2_val);
+}
+
+/**
+ * Tests if reception is restarted from the first RX buffer when the driver disables it
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_rx_disabled_restart)
+{
+    init_uart_async();
+    send_uart_event(UART_RX_BUF_REQUEST);
+
+    send_uart_event(UART_RX_DISABLED);
+
+    zassert_equal(2, uart_rx_enable_fake.call_count);
+    zassert_equal(g_uart_rx_bufs[0], uart_rx_enable_fake.arg1_val);
+
+    // rotation starts over after the restart
+    send_uart_event(UART_RX_BUF_REQUEST);
+    zassert_equal(g_uart_rx_bufs[1], uart_rx_buf_rsp_fake.arg1_val);
+}
+
+/**
+ * Tests reading data reported in consecutive UART_RX_RDY events
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_read_data)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[UART_BUFFER_SIZE];
+    uint8_t data[] = "some data";
+
+    init_uart_async();
+    memcpy(g_uart_rx_bufs[0], data, sizeof(data));
+    send_uart_rx_rdy(g_uart_rx_bufs[0], 0, 4);
+    send_uart_rx_rdy(g_uart_rx_bufs[0], 4, sizeof(data) - 4);
+
+    status = g_uart_async_transport.read(buffer, sizeof(data));
+
+    zassert_equal(STATUS_OK, status);
+    zassert_mem_equal(data, buffer, sizeof(data));
+}
+
+/**
+ * Tests reading data when no data is received
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_read_data_timeout)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[UART_BUFFER_SIZE];
+
+    init_uart_async();
+
+    status = g_uart_async_transport.read(buffer, 1);
+
+    zassert_equal(PROTOCOL_STATUS_TIMEOUT, status);
+}
+
+/**
+ * Tests reading data when UART is not initialized
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_read_data_not_initialized)
+{
+    status_t status = STATUS_OK;
+    uint8_t buffer[UART_BUFFER_SIZE];
+
+    status = g_uart_async_transport.read(buffer, 1);
+
+    zassert_equal(PROTOCOL_STATUS_UNINIT, status);
+}
+
+/**
+ * Tests if data not fitting in the ring buffer is reported as an error once and the stored data can be read afterwards
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_read_ring_overflow)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE + 10];
+    uint8_t buffer[sizeof(data)];
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = i;
+    }
+    init_uart_async();
+    send_uart_rx_rdy(data, 0, sizeof(data));
+
+    status = g_uart_async_transport.read(buffer, 1);
+
+    zassert_equal(PROTOCOL_STATUS_RECV_ERROR, status);
+
+    status = g_uart_async_transport.read(buffer, CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_mem_equal(data, buffer, CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE);
+}
+
+/**
+ * Tests leasing and releasing received data
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_lease_release)
+{
+    const uint8_t *data = NULL;
+    size_t data_length = 0;
+    uint8_t expected[] = "some data";
+
+    init_uart_async();
+    memcpy(g_uart_rx_bufs[0], expected, sizeof(expected));
+    send_uart_rx_rdy(g_uart_rx_bufs[0], 0, sizeof(expected));
+
+    zassert_equal(STATUS_OK, g_uart_async_transport.lease(&data, UART_BUFFER_SIZE, &data_length));
+    zassert_equal(sizeof(expected), data_length);
+    zassert_mem_equal(expected, data, data_length);
+
+    zassert_equal(STATUS_OK, g_uart_async_transport.release(data_length));
+    zassert_equal(PROTOCOL_STATUS_ERROR, g_uart_async_transport.release(1));
+    zassert_equal(PROTOCOL_STATUS_TIMEOUT, g_uart_async_transport.lease(&data, UART_BUFFER_SIZE, &data_length));
+}
+
+/**
+ * Tests if lease reports ring buffer overflow
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_lease_ring_overflow)
+{
+    const uint8_t *data = NULL;
+    size_t data_length = 0;
+    uint8_t received[CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE + 1];
+
+    init_uart_async();
+    send_uart_rx_rdy(received, 0, sizeof(received));
+
+    zassert_equal(PROTOCOL_STATUS_RECV_ERROR, g_uart_async_transport.lease(&data, UART_BUFFER_SIZE, &data_length));
+    zassert_equal(STATUS_OK, g_uart_async_transport.lease(&data, UART_BUFFER_SIZE, &data_length));
+    zassert_equal(CONFIG_KENNING_UART_RX_RING_BUFFER_SIZE, data_length);
+}
+
+// ========================================================
+// uart async transport write
+// ========================================================
+
+/**
+ * Tests if writing data waits for the transfer to be completed
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_write_data)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    init_uart_async();
+
+    status = g_uart_async_transport.write(data, sizeof(data));
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(1, uart_tx_fake.call_count);
+    zassert_equal(1, k_sem_take_fake.call_count);
+    zassert_mem_equal(data, g_uart_buffer_out, sizeof(data));
+}
+
+/**
+ * Tests writing data when the transfer is aborted
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_write_data_aborted)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    init_uart_async();
+    g_uart_tx_event = UART_TX_ABORTED;
+
+    status = g_uart_async_transport.write(data, sizeof(data));
+
+    zassert_equal(PROTOCOL_STATUS_ERROR, status);
+}
+
+/**
+ * Tests if transfer that does not finish in time is aborted
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_write_data_timeout)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    init_uart_async();
+    uart_tx_fake.custom_fake = NULL;
+    uart_tx_abort_fake.custom_fake = uart_tx_abort_mock;
+
+    status = g_uart_async_transport.write(data, sizeof(data));
+
+    zassert_equal(PROTOCOL_STATUS_TIMEOUT, status);
+    zassert_equal(1, uart_tx_abort_fake.call_count);
+    zassert_true(k_sem_take_fake.arg1_history[0].ticks > 0);
+    // buffer is released only after the driver confirms that the transfer is stopped
+    zassert_equal(2, k_sem_take_fake.call_count);
+}
+
+/**
+ * Tests writing data when the transfer cannot be started
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_write_data_tx_error)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    init_uart_async();
+    uart_tx_fake.custom_fake = NULL;
+    uart_tx_fake.return_val = -EBUSY;
+
+    status = g_uart_async_transport.write(data, sizeof(data));
+
+    zassert_equal(PROTOCOL_STATUS_ERROR, status);
+    zassert_equal(0, k_sem_take_fake.call_count);
+}
+
+/**
+ * Tests writing data when data size is 0
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_write_data_no_data)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    init_uart_async();
+
+    status = g_uart_async_transport.write(data, 0);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(0, uart_tx_fake.call_count);
+}
+
+/**
+ * Tests writing data when UART is not initialized
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_write_data_not_initialized)
+{
+    status_t status = STATUS_OK;
+    uint8_t data[] = "some data";
+
+    status = g_uart_async_transport.write(data, sizeof(data));
+
+    zassert_equal(PROTOCOL_STATUS_UNINIT, status);
+    zassert_equal(0, uart_tx_fake.call_count);
+}
+
+// ========================================================
+// uart async transport set_baudrate
+// ========================================================
+
+/**
+ * Tests if changing baudrate stops reception for reconfiguration and restarts it afterwards
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_set_baudrate)
+{
+    status_t status = STATUS_OK;
+
+    init_uart_async();
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    uart_configure_fake.custom_fake = uart_configure_mock;
+    uart_rx_disable_fake.custom_fake = uart_rx_disable_mock;
+
+    status = g_uart_async_transport.set_baudrate(921600);
+
+    zassert_equal(STATUS_OK, status);
+    zassert_equal(921600, g_uart_config.baudrate);
+    zassert_equal(1, uart_rx_disable_fake.call_count);
+    // UART_RX_DISABLED reported during reconfiguration does not restart reception on its own
+    zassert_equal(2, uart_rx_enable_fake.call_count);
+}
+
+/**
+ * Tests if reception is restarted when the baudrate is not supported
+ */
+ZTEST(kenning_inference_lib_test_uart_async, test_uart_async_set_baudrate_not_supported)
+{
+    status_t status = STATUS_OK;
+
+    init_uart_async();
+    uart_config_get_fake.custom_fake = uart_config_get_mock;
+    uart_configure_fake.return_val = -ENOTSUP;
+    uart_rx_disable_fake.custom_fake = uart_rx_disable_mock;
+
+    status = g_uart_async_transport.set_baudrate(12345678);
+
+    zassert_equal(PROTOCOL_STATUS_INV_ARG_BAUDRATE, status);
+    zassert_equal(2, uart_rx_enable_fake.call_count);
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static void init_uart_async()
+{
+    device_is_ready_fake.return_val = true;
+    zassert_equal(STATUS_OK, g_uart_async_transport.init());
+    zassert_not_null(g_uart_callback);
+}
+
+static void send_uart_event(enum uart_event_type type)
+{
+    struct uart_event evt = {.type = type};
+
+    g_uart_callback(NULL, &evt, NULL);
+}
+
+static void send_uart_rx_rdy(uint8_t *buf, size_t offset, size_t len)
+{
+    struct uart_event evt = {.type = UART_RX_RDY, .data.rx = {.buf = buf, .offset = offset, .len = len}};
+
+    g_uart_callback(NULL, &evt, NULL);
+}
+
+// ========================================================
+// mocks
+// ========================================================
+
+int uart_callback_set_mock(const struct device *dev, uart_callback_t callback, void *user_data)
+{
+    g_uart_callback = callback;
+    return 0;
+}
+
+int uart_tx_mock(const struct device *dev, const uint8_t *buf, size_t len, int32_t timeout)
+{
+    memcpy(g_uart_buffer_out + g_uart_buffer_out_idx, buf, len);
+    g_uart_buffer_out_idx += len;
+    send_uart_event(g_uart_tx_event);
+    return 0;
+}
+
+int uart_tx_abort_mock(const struct device *dev)
+{
+    send_uart_event(UART_TX_ABORTED);
+    return 0;
+}
+
+int uart_rx_disable_mock(const struct device *dev)
+{
+    send_uart_event(UART_RX_DISABLED);
+    return 0;
+}
+
+int uart_config_get_mock(const struct device *dev, struct uart_config *cfg)
+{
+    *cfg = g_uart_config;
+    return 0;
+}
+
+int uart_configure_mock(const struct device *dev, const struct uart_config *cfg)
+{
+    g_uart_config = *cfg;
+    return 0;
+}
+
+void k_sem_give_mock(struct k_sem *sem)
+{
+    if (sem->count < sem->limit)
+    {
+        sem->count++;
+    }
+}
+
+void k_sem_reset_mock(struct k_sem *sem) { sem->count = 0; }
+
+int k_sem_take_mock(struct k_sem *sem, k_timeout_t timeout)
+{
+    if (0 == sem->count)
+    {
+        return -EAGAIN;
+    }
+    sem->count--;
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2025 Antmicro <www.antmicro.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+
+extern "C"
+{
+#include <kenning_inference_lib/core/loaders.h>
+#include <kenning_inference_lib/core/runtime_wrapper.h>
+}
+
+#include "mocks/kernel.h"
+#include "mocks/tflite.h"
+
+#define TEST_BUFFER_SIZE (CONFIG_KENNING_TFLITE_BUFFER_SIZE * 1024)
+#define TEST_MODEL_SIZE 128
+
+extern tflite::MicroInterpreter *gp_tflite_interpreter;
+extern uint8_t g_tflite_buffer[2][TEST_BUFFER_SIZE];
+extern size_t g_active_slot;
+extern size_t g_active_model_size;
+
+tflite::MicroMutableOpResolver<TFLITE_RESOLVER_SIZE> g_tflite_resolver;
+int g_tflite_live_interpreters;
+int g_tflite_created_interpreters;
+TfLiteStatus g_tflite_allocate_status;
+
+// ========================================================
+// mocks
+// ========================================================
+
+void tflite_initialize_resolver() {}
+
+bool runtime_cancel_requested() { return false; }
+
+int64_t k_cycle_get_64(void) { return 0; }
+
+uint64_t k_cyc_to_ns_floor64(uint64_t t) { return t; }
+
+// ========================================================
+// helper functions declarations
+// ========================================================
+
+/**
+ * Returns loader for the model data
+ */
+static struct msg_loader *get_model_loader();
+
+/**
+ * Resets model loader and receives model with given schema version, as the protocol does for MODEL transmission
+ *
+ * @param version schema version of the model
+ * @param fill value of the remaining model bytes
+ */
+static void receive_model(uint32_t version, uint8_t fill);
+
+// ========================================================
+// setup
+// ========================================================
+
+static void tflite_tests_setup_f(void *)
+{
+    g_tflite_live_interpreters = 0;
+    g_tflite_created_interpreters = 0;
+    g_tflite_allocate_status = kTfLiteOk;
+    gp_tflite_interpreter = nullptr;
+    g_active_slot = 0;
+    g_active_model_size = 0;
+    memset(g_tflite_buffer, 0, sizeof(g_tflite_buffer));
+
+    zassert_equal(STATUS_OK, runtime_init());
+    get_model_loader()->addr = g_tflite_buffer[0];
+    get_model_loader()->written = 0;
+}
+
+ZTEST_SUITE(kenning_inference_lib_test_tflite, NULL, NULL, tflite_tests_setup_f, NULL, NULL);
+
+// ========================================================
+// tflite_reset_buf
+// ========================================================
+
+/**
+ * Tests if resetting model loader points it at the shadow slot and keeps the serving interpreter
+ */
+ZTEST(kenning_inference_lib_test_tflite, test_tflite_reset_buf_keeps_serving_model)
+{
+    struct msg_loader *ldr = get_model_loader();
+    tflite::MicroInterpreter *interpreter = nullptr;
+
+    receive_model(TFLITE_SCHEMA_VERSION, 1);
+    zassert_equal(STATUS_OK, runtime_init_weights());
+    interpreter = gp_tflite_interpreter;
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+
+    zassert_equal_ptr(g_tflite_buffer[1 - g_active_slot], ldr->addr);
+    zassert_equal(0, ldr->written);
+    zassert_equal_ptr(interpreter, gp_tflite_interpreter);
+    zassert_equal(1, g_tflite_live_interpreters);
+}
+
+// ========================================================
+// runtime_init_weights
+// ========================================================
+
+/**
+ * Tests if model received to the shadow slot is swapped in and the previous interpreter is destroyed
+ */
+ZTEST(kenning_inference_lib_test_tflite, test_runtime_init_weights_swaps_slots)
+{
+    struct msg_loader *ldr = get_model_loader();
+
+    receive_model(TFLITE_SCHEMA_VERSION, 1);
+    zassert_equal(STATUS_OK, runtime_init_weights());
+
+    zassert_equal(1, g_active_slot);
+    zassert_equal(TEST_MODEL_SIZE, g_active_model_size);
+    zassert_not_null(gp_tflite_interpreter);
+    zassert_equal_ptr(g_tflite_buffer[1], gp_tflite_interpreter->model());
+    zassert_equal(1, g_tflite_live_interpreters);
+
+    receive_model(TFLITE_SCHEMA_VERSION, 2);
+    zassert_equal(STATUS_OK, runtime_init_weights());
+
+    zassert_equal(0, g_active_slot);
+    zassert_equal_ptr(g_tflite_buffer[0], ldr->addr);
+    zassert_equal_ptr(g_tflite_buffer[0], gp_tflite_interpreter->model());
+    zassert_equal(1, g_tflite_live_interpreters);
+    zassert_equal(2, g_tflite_created_interpreters);
+    zassert_equal(1, g_tflite_buffer[1][TEST_MODEL_SIZE - 1]);
+}
+
+/**
+ * Tests if model with unsupported schema version is discarded and the previous model keeps serving
+ */
+ZTEST(kenning_inference_lib_test_tflite, test_runtime_init_weights_invalid_schema_keeps_serving_model)
+{
+    struct msg_loader *ldr = get_model_loader();
+    tflite::MicroInterpreter *interpreter = nullptr;
+
+    receive_model(TFLITE_SCHEMA_VERSION, 1);
+    zassert_equal(STATUS_OK, runtime_init_weights());
+    interpreter = gp_tflite_interpreter;
+
+    receive_model(TFLITE_SCHEMA_VERSION + 1, 2);
+    zassert_equal(RUNTIME_WRAPPER_STATUS_ERROR, runtime_init_weights());
+
+    zassert_equal(1, g_active_slot);
+    zassert_equal_ptr(interpreter, gp_tflite_interpreter);
+    zassert_equal_ptr(g_tflite_buffer[1], ldr->addr);
+    zassert_equal(TEST_MODEL_SIZE, ldr->written);
+    zassert_equal(1, g_tflite_live_interpreters);
+    zassert_equal(STATUS_OK, runtime_run_model());
+}
+
+/**
+ * Tests if model whose tensors cannot be allocated is discarded and the previous model keeps serving
+ */
+ZTEST(kenning_inference_lib_test_tflite, test_runtime_init_weights_allocate_error_keeps_serving_model)
+{
+    struct msg_loader *ldr = get_model_loader();
+    tflite::MicroInterpreter *interpreter = nullptr;
+
+    receive_model(TFLITE_SCHEMA_VERSION, 1);
+    zassert_equal(STATUS_OK, runtime_init_weights());
+    interpreter = gp_tflite_interpreter;
+
+    receive_model(TFLITE_SCHEMA_VERSION, 2);
+    g_tflite_allocate_status = kTfLiteError;
+    zassert_equal(RUNTIME_WRAPPER_STATUS_ERROR, runtime_init_weights());
+
+    zassert_equal(1, g_active_slot);
+    zassert_equal_ptr(interpreter, gp_tflite_interpreter);
+    zassert_equal_ptr(g_tflite_buffer[1], ldr->addr);
+    zassert_equal(TEST_MODEL_SIZE, ldr->written);
+    zassert_equal(1, g_tflite_live_interpreters);
+    zassert_equal(2, g_tflite_created_interpreters);
+}
+
+/**
+ * Tests if model loaded without resetting the loader replaces the serving interpreter in the same slot
+ */
+ZTEST(kenning_inference_lib_test_tflite, test_runtime_init_weights_in_place)
+{
+    struct msg_loader *ldr = get_model_loader();
+
+    receive_model(TFLITE_SCHEMA_VERSION, 1);
+    zassert_equal(STATUS_OK, runtime_init_weights());
+
+    zassert_equal(STATUS_OK, runtime_init_weights());
+
+    zassert_equal(1, g_active_slot);
+    zassert_equal_ptr(g_tflite_buffer[1], ldr->addr);
+    zassert_equal_ptr(g_tflite_buffer[1], gp_tflite_interpreter->model());
+    zassert_equal(1, g_tflite_live_interpreters);
+    zassert_equal(2, g_tflite_created_interpreters);
+}
+
+// ========================================================
+// runtime_run_model
+// ========================================================
+
+/**
+ * Tests if running the model fails when no model is loaded
+ */
+ZTEST(kenning_inference_lib_test_tflite, test_runtime_run_model_no_model)
+{
+    zassert_equal(RUNTIME_WRAPPER_STATUS_ERROR, runtime_run_model());
+}
+
+// ========================================================
+// helper functions
+// ========================================================
+
+static struct msg_loader *get_model_loader() { return g_ldr_tables[1][LOADER_TYPE_MODEL]; }
+
+static void receive_model(uint32_t version, uint8_t fill)
+{
+    struct msg_loader *ldr = get_model_loader();
+    uint8_t model[TEST_MODEL_SIZE];
+
+    memset(model, fill, sizeof(model));
+    memcpy(model, &version, sizeof(version));
+
+    zassert_equal(STATUS_OK, ldr->reset(ldr));
+    zassert_equal(STATUS_OK, ldr->save(ldr, model, sizeof(model)));
+}